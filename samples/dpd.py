@@ -41,7 +41,7 @@ r_cut = 1.
 F_max = 1.
 
 # Activate the thermostat
-system.thermostat.set_dpd(kT=kT)
+system.thermostat.set_dpd(kT=kT, seed=42)
 system.set_random_state_PRNG()
 np.random.seed(seed=system.seed)
 #system.seed = system.cell_system.get_state()['n_nodes'] * [1234]
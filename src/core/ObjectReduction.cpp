@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *
+ *  Implementation of \ref ObjectReduction.hpp
+ */
+
+#include "ObjectReduction.hpp"
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <utility>
+
+#include <mpi.h>
+
+void ObjectReduction::set_objects(boost::mpi::communicator const &comm,
+                                  std::vector<int> objects) {
+  assert(std::is_sorted(objects.begin(), objects.end()));
+
+  auto const changed = not m_initialized or (objects != m_objects);
+  m_objects = std::move(objects);
+  m_initialized = true;
+  m_distributed = comm.size() > 1;
+
+  if (not m_distributed or
+      not boost::mpi::all_reduce(comm, changed, std::logical_or<bool>()))
+    return;
+
+  auto const n_nodes = comm.size();
+  auto const this_node = comm.rank();
+  auto const n_local = static_cast<int>(m_objects.size());
+
+  /* Every object has a directory node which collects the nodes holding
+     the object and sends the list back to them. */
+  std::vector<std::vector<int>> to_directory(n_nodes), at_directory;
+  for (auto const &o : m_objects)
+    to_directory[o % n_nodes].push_back(o);
+  boost::mpi::all_to_all(comm, to_directory, at_directory);
+
+  std::vector<std::vector<int>> holders;
+  {
+    std::vector<int> sorted_ids;
+    for (auto const &ids : at_directory)
+      sorted_ids.insert(sorted_ids.end(), ids.begin(), ids.end());
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    sorted_ids.erase(std::unique(sorted_ids.begin(), sorted_ids.end()),
+                     sorted_ids.end());
+
+    std::vector<std::vector<int>> object_holders(sorted_ids.size());
+    for (int node = 0; node < n_nodes; node++)
+      for (auto const &o : at_directory[node]) {
+        auto const pos =
+            std::lower_bound(sorted_ids.begin(), sorted_ids.end(), o) -
+            sorted_ids.begin();
+        object_holders[pos].push_back(node);
+      }
+
+    std::vector<std::vector<int>> replies(n_nodes), answers;
+    for (int node = 0; node < n_nodes; node++)
+      for (auto const &o : at_directory[node]) {
+        auto const &h = object_holders[std::lower_bound(sorted_ids.begin(),
+                                                        sorted_ids.end(), o) -
+                                       sorted_ids.begin()];
+        replies[node].push_back(static_cast<int>(h.size()));
+        replies[node].insert(replies[node].end(), h.begin(), h.end());
+      }
+    boost::mpi::all_to_all(comm, replies, answers);
+
+    /* The answers are in the order of the requests, the holders of
+       each object in ascending order of rank. */
+    holders.resize(n_local);
+    for (int node = 0; node < n_nodes; node++) {
+      auto it = answers[node].begin();
+      for (auto const &o : to_directory[node]) {
+        auto const i =
+            std::lower_bound(m_objects.begin(), m_objects.end(), o) -
+            m_objects.begin();
+        auto const n = *it++;
+        holders[i].assign(it, it + n);
+        it += n;
+      }
+    }
+  }
+
+  /* The neighbors are all other nodes sharing objects with this node.
+     Both sides list the shared objects in ascending order, so the
+     exchange is symmetric. */
+  std::vector<int> neighbors;
+  for (auto const &h : holders)
+    for (auto const &node : h)
+      if (node != this_node)
+        neighbors.push_back(node);
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                  neighbors.end());
+
+  std::vector<std::vector<int>> shared(neighbors.size());
+  for (int i = 0; i < n_local; i++)
+    for (auto const &node : holders[i])
+      if (node != this_node) {
+        auto const n =
+            std::lower_bound(neighbors.begin(), neighbors.end(), node) -
+            neighbors.begin();
+        shared[n].push_back(i);
+      }
+
+  m_counts.clear();
+  m_displacements.clear();
+  m_send_objects.clear();
+  /* Contributions of each local object as (rank, position) */
+  std::vector<std::vector<std::pair<int, int>>> contributions(n_local);
+  for (int i = 0; i < n_local; i++)
+    contributions[i].emplace_back(this_node, i);
+  for (std::size_t n = 0; n < neighbors.size(); n++) {
+    m_displacements.push_back(static_cast<int>(m_send_objects.size()) *
+                              m_n_values);
+    m_counts.push_back(static_cast<int>(shared[n].size()) * m_n_values);
+    for (auto const &i : shared[n]) {
+      contributions[i].emplace_back(
+          neighbors[n], n_local + static_cast<int>(m_send_objects.size()));
+      m_send_objects.push_back(i);
+    }
+  }
+
+  m_contributions_begin.assign(1, 0);
+  m_contributions.clear();
+  for (auto &c : contributions) {
+    std::sort(c.begin(), c.end());
+    for (auto const &rank_pos : c)
+      m_contributions.push_back(rank_pos.second);
+    m_contributions_begin.push_back(static_cast<int>(m_contributions.size()));
+  }
+
+  MPI_Comm graph_comm;
+  auto const degree = static_cast<int>(neighbors.size());
+  MPI_Dist_graph_create_adjacent(comm, degree, neighbors.data(),
+                                 MPI_UNWEIGHTED, degree, neighbors.data(),
+                                 MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &graph_comm);
+  m_graph_comm =
+      boost::mpi::communicator(graph_comm, boost::mpi::comm_take_ownership);
+}
+
+std::vector<double>
+ObjectReduction::reduce(std::vector<double> const &partial) const {
+  assert(partial.size() == m_objects.size() * m_n_values);
+
+  if (not m_distributed)
+    return partial;
+
+  /* The local values followed by the received ones */
+  std::vector<double> values(partial.size() +
+                             m_send_objects.size() * m_n_values);
+  std::copy(partial.begin(), partial.end(), values.begin());
+
+  std::vector<double> send_buffer;
+  send_buffer.reserve(m_send_objects.size() * m_n_values);
+  for (auto const &i : m_send_objects)
+    send_buffer.insert(send_buffer.end(), partial.begin() + i * m_n_values,
+                       partial.begin() + (i + 1) * m_n_values);
+
+  MPI_Neighbor_alltoallv(send_buffer.data(), m_counts.data(),
+                         m_displacements.data(), MPI_DOUBLE,
+                         values.data() + partial.size(), m_counts.data(),
+                         m_displacements.data(), MPI_DOUBLE, m_graph_comm);
+
+  std::vector<double> totals(partial.size(), 0.);
+  for (std::size_t i = 0; i < m_objects.size(); i++) {
+    for (int c = m_contributions_begin[i]; c < m_contributions_begin[i + 1];
+         c++) {
+      auto const pos = m_contributions[c];
+      for (int k = 0; k < m_n_values; k++)
+        totals[i * m_n_values + k] += values[pos * m_n_values + k];
+    }
+  }
+
+  return totals;
+}
@@ -0,0 +1,90 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_OBJECT_REDUCTION_HPP
+#define CORE_OBJECT_REDUCTION_HPP
+/** \file
+ *  Sums of per-object quantities over the nodes holding the objects.
+ *
+ *  Global quantities of soft objects, like the area and the volume of
+ *  an OIF cell or an IBM body, are sums over the triangles of the
+ *  object. The triangles of one object are usually spread over a few
+ *  neighboring nodes only, so instead of summing the values of all
+ *  objects over all nodes, each node exchanges its partial sums only
+ *  with the other nodes holding parts of the same objects. The
+ *  communication pattern is set up when the local objects change and
+ *  stored in a distributed graph communicator, so that each reduction
+ *  is a single neighborhood collective.
+ */
+
+#include <boost/mpi/communicator.hpp>
+
+#include <vector>
+
+class ObjectReduction {
+public:
+  /** @param n_values Number of values per object. */
+  explicit ObjectReduction(int n_values) : m_n_values(n_values) {}
+
+  /** @brief Set the objects with contributions on this node.
+   *
+   *  This is a collective call on @p comm. The communication pattern
+   *  is only rebuilt if the objects changed on any of the nodes.
+   *
+   *  @param comm Communicator of all nodes.
+   *  @param objects Ids of the local objects, sorted and unique.
+   */
+  void set_objects(boost::mpi::communicator const &comm,
+                   std::vector<int> objects);
+
+  /** Ids of the local objects. */
+  std::vector<int> const &objects() const { return m_objects; }
+
+  /** @brief Sum the contributions of all nodes to the local objects.
+   *
+   *  This is a collective call on the communicator passed to
+   *  @ref set_objects. The contributions are summed in the order of
+   *  the node ranks, so all nodes holding an object get bitwise
+   *  identical totals.
+   *
+   *  @param partial Values of the local contributions, @c n_values
+   *                 per object in the order of @ref objects.
+   *  @return Total values in the same layout.
+   */
+  std::vector<double> reduce(std::vector<double> const &partial) const;
+
+private:
+  int m_n_values;
+  bool m_initialized = false;
+  bool m_distributed = false;
+  std::vector<int> m_objects;
+
+  /** Graph of the nodes sharing objects with this node. */
+  boost::mpi::communicator m_graph_comm;
+  /** Number of values exchanged with each neighbor. */
+  std::vector<int> m_counts;
+  std::vector<int> m_displacements;
+  /** Local object index of each exchanged object. */
+  std::vector<int> m_send_objects;
+  /** For each local object, the positions of its contributions in the
+   *  local and received values, ordered by node rank. */
+  std::vector<int> m_contributions_begin;
+  std::vector<int> m_contributions;
+};
+
+#endif
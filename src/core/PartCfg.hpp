@@ -29,6 +29,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <boost/iterator/indirect_iterator.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <vector>
+
 /**
  * @brief Proxy class that gets a particle range from #local_particles.
  */
@@ -62,6 +64,47 @@ public:
   }
 };
 
+/**
+ * @brief Particle properties that can be selected for
+ * ParticleCache::projection().
+ */
+namespace PartCfgField {
+enum : unsigned {
+  position = 1u << 0,
+  velocity = 1u << 1,
+  force = 1u << 2,
+  type = 1u << 3,
+  mass = 1u << 4,
+  charge = 1u << 5
+};
+} // namespace PartCfgField
+
+/**
+ * @brief Append the selected properties of a particle to a buffer.
+ *
+ * The values are appended in the order of the bits in
+ * @ref PartCfgField, the type is converted to double.
+ */
+inline void project_fields(Particle const &p, unsigned fields,
+                           std::vector<double> &out) {
+  auto append = [&out](Utils::Vector3d const &v) {
+    out.insert(out.end(), v.begin(), v.end());
+  };
+
+  if (fields & PartCfgField::position)
+    append(p.r.p);
+  if (fields & PartCfgField::velocity)
+    append(p.m.v);
+  if (fields & PartCfgField::force)
+    append(p.f.f);
+  if (fields & PartCfgField::type)
+    out.push_back(p.p.type);
+  if (fields & PartCfgField::mass)
+    out.push_back(p.p.mass);
+  if (fields & PartCfgField::charge)
+    out.push_back(p.p.q);
+}
+
 /** @brief Cache of particles */
 using PartCfg = ParticleCache<GetLocalParts, PositionUnfolder>;
 #endif
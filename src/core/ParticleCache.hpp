@@ -24,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -41,7 +42,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "MpiCallbacks.hpp"
 #include <utils/NoOp.hpp>
+#include <utils/Span.hpp>
 #include <utils/mpi/gather_buffer.hpp>
+#include <utils/mpi/gatherv.hpp>
 #include <utils/serialization/flat_set.hpp>
 
 namespace detail {
@@ -144,6 +147,14 @@ struct is_commutative<::detail::Merge<Container, ::detail::IdCompare>,
  * To iterate over the particles using the iterators is more
  * efficient than using operator[].
  *
+ * If only a few properties of the particles are needed, projection()
+ * gathers just these into flat arrays. Which properties can be
+ * selected is defined by the particle type, which has to provide
+ * a function project_fields(p, fields, out) that appends the values
+ * selected by the bit mask fields to the vector out. Projections are
+ * cached as well; they stay valid until the cache is invalidated,
+ * which is tracked by a version counter.
+ *
  * All functions in the public interface can only be called on
  * the master node.
  */
@@ -164,9 +175,37 @@ class ParticleCache {
   map_type remote_parts;
   /** State */
   bool m_valid, m_valid_bonds;
+  /** Incremented every time the cache is invalidated. */
+  unsigned m_version;
+
+public:
+  /**
+   * @brief Selected fields of all particles.
+   */
+  struct Projection {
+    /** Version of the cache this was gathered for. */
+    unsigned version;
+    /** Number of values per particle. */
+    size_t stride;
+    /** Particle ids in ascending order. */
+    std::vector<int> ids;
+    /** Values of the selected fields, in the order of ids. */
+    std::vector<double> values;
+
+    size_t size() const { return ids.size(); }
+    /** Values of the i-th particle. */
+    Utils::Span<const double> operator[](size_t i) const {
+      return {values.data() + i * stride, stride};
+    }
+  };
+
+private:
+  /** Projections by field mask */
+  std::unordered_map<unsigned, Projection> m_projections;
 
   Communication::CallbackHandle<> update_cb;
   Communication::CallbackHandle<> update_bonds_cb;
+  Communication::CallbackHandle<unsigned> update_projection_cb;
 
   /** Functor to get a particle range */
   GetParticles m_parts;
@@ -247,6 +286,95 @@ class ParticleCache {
                        detail::Merge<map_type, detail::IdCompare>(), 0);
   }
 
+  /**
+   * @brief Append the selected fields of a particle to a buffer.
+   *
+   * The op is run on a copy of the particle, so that projected
+   * values agree with the ones in the full cache.
+   */
+  template <typename P>
+  static void m_project(P const &p, UnaryOp const &op, unsigned fields,
+                        std::vector<double> &out) {
+    auto copy = p.flat_copy();
+    op(copy);
+    project_fields(copy, fields, out);
+  }
+
+  /**
+   * @brief Implementation of the projection update.
+   *
+   * The ids and the selected values of the local particles
+   * are gathered to the master in two flat arrays.
+   */
+  Projection m_update_projection(unsigned fields) {
+    Projection proj;
+
+    for (auto const &p : m_parts()) {
+      proj.ids.push_back(p.identity());
+      m_project(p, m_op, fields, proj.values);
+    }
+
+    auto const &comm = m_cb.comm();
+    int const n_ids = proj.ids.size();
+    int const n_values = proj.values.size();
+
+    if (comm.rank() != 0) {
+      boost::mpi::gather(comm, n_ids, 0);
+      boost::mpi::gather(comm, n_values, 0);
+      Utils::Mpi::gatherv(comm, proj.ids.data(), n_ids, 0);
+      Utils::Mpi::gatherv(comm, proj.values.data(), n_values, 0);
+
+      return proj;
+    }
+
+    std::vector<int> id_sizes, value_sizes;
+    boost::mpi::gather(comm, n_ids, id_sizes, 0);
+    boost::mpi::gather(comm, n_values, value_sizes, 0);
+
+    std::vector<int> ids(std::accumulate(id_sizes.begin(), id_sizes.end(), 0));
+    std::vector<double> values(
+        std::accumulate(value_sizes.begin(), value_sizes.end(), 0));
+    Utils::Mpi::gatherv(comm, proj.ids.data(), n_ids, ids.data(),
+                        id_sizes.data(), 0);
+    Utils::Mpi::gatherv(comm, proj.values.data(), n_values, values.data(),
+                        value_sizes.data(), 0);
+
+    /* Sort by id */
+    auto const stride = ids.empty() ? 0 : values.size() / ids.size();
+    std::vector<int> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&ids](int a, int b) { return ids[a] < ids[b]; });
+
+    proj.stride = stride;
+    proj.ids.resize(ids.size());
+    proj.values.resize(values.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      proj.ids[i] = ids[order[i]];
+      std::copy_n(values.begin() + order[i] * stride, stride,
+                  proj.values.begin() + i * stride);
+    }
+
+    return proj;
+  }
+
+  /**
+   * @brief Projection from the full cache, no communication needed.
+   */
+  Projection m_project_cached(unsigned fields) const {
+    Projection proj;
+    proj.ids.reserve(remote_parts.size());
+
+    for (auto const &p : remote_parts) {
+      proj.ids.push_back(p.identity());
+      /* The op has already been applied to the cached particles. */
+      project_fields(p, fields, proj.values);
+    }
+    proj.stride = proj.ids.empty() ? 0 : proj.values.size() / proj.ids.size();
+
+    return proj;
+  }
+
   void m_update_index() {
     /* Try to avoid rehashing along the way */
     id_index.reserve(remote_parts.size() + 1);
@@ -264,9 +392,12 @@ public:
   ParticleCache() = delete;
   ParticleCache(Communication::MpiCallbacks &cb, GetParticles parts,
                 UnaryOp &&op = UnaryOp{})
-      : m_cb(cb), m_valid(false), m_valid_bonds(false),
+      : m_cb(cb), m_valid(false), m_valid_bonds(false), m_version(0),
         update_cb(&cb, [this]() { m_update(); }),
-        update_bonds_cb(&cb, [this]() { m_update_bonds(); }), m_parts(parts),
+        update_bonds_cb(&cb, [this]() { m_update_bonds(); }),
+        update_projection_cb(
+            &cb, [this](unsigned fields) { m_update_projection(fields); }),
+        m_parts(parts),
         m_op(std::forward<UnaryOp>(op)) {}
   /* Because the this ptr is captured by the callback lambdas,
    * this class can be neither copied nor moved. */
@@ -281,6 +412,7 @@ public:
   void clear() {
     id_index.clear();
     remote_parts.clear();
+    m_projections.clear();
   }
 
   /**
@@ -344,6 +476,45 @@ public:
     /* Adjust state */
     m_valid = false;
     m_valid_bonds = false;
+    ++m_version;
+  }
+
+  /**
+   * @brief Version of the cached data.
+   *
+   * Changes every time the cache is invalidated, so results
+   * derived from the cache can be reused as long as the version
+   * does not change.
+   */
+  unsigned version() const { return m_version; }
+
+  /**
+   * @brief Selected fields of all particles, ordered by id.
+   *
+   * Only the ids and the requested fields are communicated.
+   * If the full particle data is already cached, the projection
+   * is done on the master without communication. The result
+   * is reused until the cache is invalidated.
+   *
+   * @param fields Bit mask of the fields, see project_fields().
+   */
+  Projection const &projection(unsigned fields) {
+    assert(m_cb.comm().rank() == 0);
+
+    auto it = m_projections.find(fields);
+    if (it != m_projections.end() and it->second.version == m_version)
+      return it->second;
+
+    Projection proj;
+    if (m_valid) {
+      proj = m_project_cached(fields);
+    } else {
+      update_projection_cb(fields);
+      proj = m_update_projection(fields);
+    }
+    proj.version = m_version;
+
+    return m_projections[fields] = std::move(proj);
   }
 
   /**
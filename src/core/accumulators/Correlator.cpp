@@ -30,6 +30,7 @@
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
 
+#include <algorithm>
 #include <limits>
 
 namespace {
@@ -37,131 +38,84 @@ int min(int i, unsigned int j) { return std::min(i, static_cast<int>(j)); }
 } // namespace
 
 namespace Accumulators {
+/* The compression functions write the compressed value of two samples
+ * of length n to out, the correlation operations add the correlation of
+ * A and B to C. All of them work in place on the ring buffers, the loops
+ * over the components are simple enough to be vectorized. */
+
 /** The minimal version of compression function */
-std::vector<double> compress_do_nothing(std::vector<double> const &A1,
-                                        std::vector<double> const &A2) {
-  return {};
-}
+void compress_do_nothing(double const *A1, double const *A2, std::size_t n,
+                         double *out) {}
 
 /** Compress computing arithmetic mean: A_compressed=(A1+A2)/2 */
-std::vector<double> compress_linear(std::vector<double> const &A1,
-                                    std::vector<double> const &A2) {
-  assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1.size());
-
-  std::transform(A1.begin(), A1.end(), A2.begin(), A_compressed.begin(),
-                 [](double a, double b) -> double { return 0.5 * (a + b); });
-
-  return A_compressed;
+void compress_linear(double const *A1, double const *A2, std::size_t n,
+                     double *out) {
+  for (std::size_t k = 0; k < n; k++) {
+    out[k] = 0.5 * (A1[k] + A2[k]);
+  }
 }
 
 /** Compress discarding the 1st argument and return the 2nd */
-std::vector<double> compress_discard1(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
-  assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A2);
-  return A_compressed;
+void compress_discard1(double const *A1, double const *A2, std::size_t n,
+                       double *out) {
+  std::copy_n(A2, n, out);
 }
 
 /** Compress discarding the 2nd argument and return the 1st */
-std::vector<double> compress_discard2(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
-  assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1);
-  return A_compressed;
+void compress_discard2(double const *A1, double const *A2, std::size_t n,
+                       double *out) {
+  std::copy_n(A1, n, out);
 }
 
-std::vector<double> scalar_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in scalar product: The vector sizes do not match");
+void scalar_product(double const *A, double const *B, std::size_t dim_A,
+                    std::size_t dim_B, Utils::Vector3d const &, double *C) {
+  double sum = 0.;
+  for (std::size_t k = 0; k < dim_A; k++) {
+    sum += A[k] * B[k];
   }
-
-  return std::vector<double>(
-      1, std::inner_product(A.begin(), A.end(), B.begin(), 0.0));
+  C[0] += sum;
 }
 
-std::vector<double> componentwise_product(std::vector<double> const &A,
-                                          std::vector<double> const &B,
-                                          Utils::Vector3d) {
-  std::vector<double> C(A.size());
-  if (!(A.size() == B.size())) {
-    throw std::runtime_error(
-        "Error in componentwise product: The vector sizes do not match");
+void componentwise_product(double const *A, double const *B,
+                           std::size_t dim_A, std::size_t dim_B,
+                           Utils::Vector3d const &, double *C) {
+  for (std::size_t k = 0; k < dim_A; k++) {
+    C[k] += A[k] * B[k];
   }
-
-  std::transform(A.begin(), A.end(), B.begin(), C.begin(), std::multiplies<>());
-
-  return C;
 }
 
-std::vector<double> tensor_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d) {
-  std::vector<double> C(A.size() * B.size());
-  auto C_it = C.begin();
-
-  for (auto A_it = A.begin(); A_it != A.begin(); ++A_it) {
-    for (double B_it : B) {
-      *(C_it++) = *A_it * B_it;
+void tensor_product(double const *A, double const *B, std::size_t dim_A,
+                    std::size_t dim_B, Utils::Vector3d const &, double *C) {
+  for (std::size_t i = 0; i < dim_A; i++) {
+    auto const a = A[i];
+    auto C_i = C + i * dim_B;
+    for (std::size_t j = 0; j < dim_B; j++) {
+      C_i[j] += a * B[j];
     }
   }
-  assert(C_it == C.end());
-
-  return C;
 }
 
-std::vector<double> square_distance_componentwise(std::vector<double> const &A,
-                                                  std::vector<double> const &B,
-                                                  Utils::Vector3d) {
-  if (!(A.size() == B.size())) {
-    throw std::runtime_error(
-        "Error in square distance componentwise: The vector sizes do not "
-        "match.");
+void square_distance_componentwise(double const *A, double const *B,
+                                   std::size_t dim_A, std::size_t dim_B,
+                                   Utils::Vector3d const &, double *C) {
+  for (std::size_t k = 0; k < dim_A; k++) {
+    auto const d = A[k] - B[k];
+    C[k] += d * d;
   }
-
-  std::vector<double> C(A.size());
-
-  std::transform(
-      A.begin(), A.end(), B.begin(), C.begin(),
-      [](double a, double b) -> double { return (a - b) * (a - b); });
-
-  return C;
 }
 
 // note: the argument name wsquare denotes that it value is w^2 while the user
 // sets w
-std::vector<double> fcs_acf(std::vector<double> const &A,
-                            std::vector<double> const &B,
-                            Utils::Vector3d wsquare) {
-  if (!(A.size() == B.size())) {
-    throw std::runtime_error(
-        "Error in square distance componentwise: The vector sizes do not "
-        "match.");
-  }
-
-  auto const C_size = A.size() / 3;
-  if (3 * C_size != A.size()) {
-    throw std::runtime_error("Invalid dimensions.");
-  }
-
-  std::vector<double> C(C_size, 0);
-
-  for (unsigned i = 0; i < C_size; i++) {
+void fcs_acf(double const *A, double const *B, std::size_t dim_A,
+             std::size_t dim_B, Utils::Vector3d const &wsquare, double *C) {
+  for (std::size_t i = 0; i < dim_A / 3; i++) {
+    double c = 0.;
     for (int j = 0; j < 3; j++) {
-      auto const &a = A[3 * i + j];
-      auto const &b = B[3 * i + j];
-
-      C[i] -= (a - b) * (a - b) / wsquare[j];
+      auto const d = A[3 * i + j] - B[3 * i + j];
+      c -= d * d / wsquare[j];
     }
+    C[i] += std::exp(c);
   }
-
-  std::transform(C.begin(), C.end(), C.begin(),
-                 [](double c) -> double { return std::exp(c); });
-
-  return C;
 }
 
 /* global variables */
@@ -278,6 +232,9 @@ void Correlator::initialize() {
   if (corr_operation_name.empty()) {
     throw std::runtime_error(init_errors[11]); // there is no reasonable default
   }
+  if (corr_operation_name != "tensor_product" && dim_A != dim_B) {
+    throw std::runtime_error(init_errors[8]);
+  }
   if (corr_operation_name == "componentwise_product") {
     m_dim_corr = dim_A;
     corr_operation = &componentwise_product;
@@ -341,10 +298,10 @@ void Correlator::initialize() {
     throw std::runtime_error(init_errors[13]);
   }
 
-  A.resize(std::array<int, 2>{{hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(A.data(), A.num_elements(), std::vector<double>(dim_A, 0));
-  B.resize(std::array<int, 2>{{hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(B.data(), B.num_elements(), std::vector<double>(dim_B, 0));
+  A.resize(std::array<int, 3>{{hierarchy_depth, m_tau_lin + 1, int(dim_A)}});
+  std::fill_n(A.data(), A.num_elements(), 0.);
+  B.resize(std::array<int, 3>{{hierarchy_depth, m_tau_lin + 1, int(dim_B)}});
+  std::fill_n(B.data(), B.num_elements(), 0.);
 
   n_data = 0;
   A_accumulated_average = std::vector<double>(dim_A, 0);
@@ -376,6 +333,24 @@ void Correlator::initialize() {
     }
 }
 
+void Correlator::compress(int level) {
+  auto const first = (newest[level] + 1) % (m_tau_lin + 1);
+  auto const second = (newest[level] + 2) % (m_tau_lin + 1);
+
+  (*compressA)(sample(A, level, first), sample(A, level, second), dim_A,
+               sample(A, level + 1, newest[level + 1]));
+  (*compressB)(sample(B, level, first), sample(B, level, second), dim_B,
+               sample(B, level + 1, newest[level + 1]));
+}
+
+void Correlator::correlate(int level, unsigned index_old, unsigned index_new,
+                           unsigned index_res) {
+  n_sweeps[index_res]++;
+  (*corr_operation)(sample(A, level, index_old), sample(B, level, index_new),
+                    dim_A, dim_B, m_correlation_args,
+                    result.data() + index_res * m_dim_corr);
+}
+
 void Correlator::update() {
   if (finalized) {
     runtimeErrorMsg() << "No data can be added after finalize() was called.";
@@ -416,46 +391,43 @@ void Correlator::update() {
     // folding)
     newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
     n_vals[i + 1] += 1;
-    A[i + 1][newest[i + 1]] =
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-    B[i + 1][newest[i + 1]] =
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+    compress(i);
   }
 
   newest[0] = (newest[0] + 1) % (m_tau_lin + 1);
   n_vals[0]++;
 
-  A[0][newest[0]] = A_obs->operator()(partCfg());
+  /* The observables return their values in a new vector, which is the
+   * only allocation per sample. The values are copied into the ring
+   * buffer, all further operations work in place. */
+  auto const A_new = sample(A, 0, newest[0]);
+  auto const B_new = sample(B, 0, newest[0]);
+  auto const A_values = A_obs->operator()(partCfg());
+  assert(A_values.size() == dim_A);
+  std::copy_n(A_values.begin(), dim_A, A_new);
   if (A_obs != B_obs) {
-    B[0][newest[0]] = B_obs->operator()(partCfg());
+    auto const B_values = B_obs->operator()(partCfg());
+    assert(B_values.size() == dim_B);
+    std::copy_n(B_values.begin(), dim_B, B_new);
   } else {
-    B[0][newest[0]] = A[0][newest[0]];
+    std::copy_n(A_new, dim_B, B_new);
   }
 
   // Now we update the cumulated averages and variances of A and B
   n_data++;
   for (unsigned k = 0; k < dim_A; k++) {
-    A_accumulated_average[k] += A[0][newest[0]][k];
+    A_accumulated_average[k] += A_new[k];
   }
 
   for (unsigned k = 0; k < dim_B; k++) {
-    B_accumulated_average[k] += B[0][newest[0]][k];
+    B_accumulated_average[k] += B_new[k];
   }
 
   // Now update the lowest level correlation estimates
   for (j = 0; j < min(m_tau_lin + 1, n_vals[0]); j++) {
     index_new = newest[0];
     index_old = (newest[0] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-    auto const temp =
-        (corr_operation)(A[0][index_old], B[0][index_new], m_correlation_args);
-    assert(temp.size() == m_dim_corr);
-
-    n_sweeps[j]++;
-    for (unsigned k = 0; k < m_dim_corr; k++) {
-      result[j][k] += temp[k];
-    }
+    correlate(0, index_old, index_new, j);
   }
   // Now for the higher ones
   for (int i = 1; i < highest_level_to_compress + 2; i++) {
@@ -465,14 +437,7 @@ void Correlator::update() {
       index_old = (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
       index_res =
           m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-      auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                         m_correlation_args);
-      assert(temp.size() == m_dim_corr);
-
-      n_sweeps[index_res]++;
-      for (unsigned k = 0; k < m_dim_corr; k++) {
-        result[index_res][k] += temp[k];
-      }
+      correlate(i, index_old, index_new, index_res);
     }
   }
 
@@ -539,11 +504,7 @@ int Correlator::finalize() {
         // folding)
         newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
         n_vals[i + 1] += 1;
-
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+        compress(i);
       }
       newest[ll] = (newest[ll] + 1) % (m_tau_lin + 1);
 
@@ -555,15 +516,7 @@ int Correlator::finalize() {
           index_old = (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
           index_res =
               m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-
-          auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                             m_correlation_args);
-          assert(temp.size() == m_dim_corr);
-
-          n_sweeps[index_res]++;
-          for (unsigned k = 0; k < m_dim_corr; k++) {
-            result[index_res][k] += temp[k];
-          }
+          correlate(i, index_old, index_new, index_res);
         }
       }
     }
@@ -284,8 +284,9 @@ private:
   std::shared_ptr<Observables::Observable> B_obs;
 
   std::vector<int> tau; // time differences
-  boost::multi_array<std::vector<double>, 2> A;
-  boost::multi_array<std::vector<double>, 2> B;
+  // ring buffers of the samples, indexed by level, position and component
+  boost::multi_array<double, 3> A;
+  boost::multi_array<double, 3> B;
 
   boost::multi_array<double, 2> result; // output quantity
 
@@ -306,18 +307,39 @@ private:
   unsigned int dim_A; // dimensionality of A
   unsigned int dim_B;
 
-  using correlation_operation_type =
-      std::vector<double> (*)(std::vector<double> const &,
-                              std::vector<double> const &, Utils::Vector3d);
+  // adds the correlation of A and B to C
+  using correlation_operation_type = void (*)(double const *A,
+                                              double const *B,
+                                              std::size_t dim_A,
+                                              std::size_t dim_B,
+                                              Utils::Vector3d const &args,
+                                              double *C);
 
   correlation_operation_type corr_operation;
 
-  using compression_function = std::vector<double> (*)(
-      std::vector<double> const &A1, std::vector<double> const &A2);
+  // writes the compressed value of A1 and A2 to out
+  using compression_function = void (*)(double const *A1, double const *A2,
+                                        std::size_t n, double *out);
 
   // compressing functions
   compression_function compressA;
   compression_function compressB;
+
+  /** First component of a sample in the ring buffer A or B */
+  static double *sample(boost::multi_array<double, 3> &buffer, int level,
+                        unsigned index) {
+    return buffer.data() + (level * buffer.shape()[1] + index) *
+                               buffer.shape()[2];
+  }
+
+  /** Compress the two oldest samples on level into the newest sample
+   *  on level + 1 */
+  void compress(int level);
+
+  /** Add the correlation of two samples on level to the result for
+   *  index_res */
+  void correlate(int level, unsigned index_old, unsigned index_new,
+                 unsigned index_res);
 };
 
 } // namespace Accumulators
@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *
+ *  Implementation of \ref bond_topology.hpp
+ */
+
+#include "bond_topology.hpp"
+#include "bonded_interaction_data.hpp"
+#include "cells.hpp"
+#include "errorhandling.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+std::vector<BondGroup> topology;
+bool topology_valid = false;
+
+void compile_bond_topology() {
+  topology.clear();
+
+  /* Position of the group of each bond type in topology */
+  std::vector<int> group_index(bonded_ia_params.size(), -1);
+
+  for (auto &p : local_cells.particles()) {
+    int i = 0;
+    while (i < p.bl.n) {
+      auto const type_num = p.bl.e[i++];
+      auto const n_partners = bonded_ia_params[type_num].num;
+
+      if (group_index[type_num] < 0) {
+        group_index[type_num] = static_cast<int>(topology.size());
+        topology.push_back({type_num, n_partners, {}});
+      }
+      auto &particles = topology[group_index[type_num]].particles;
+      auto const first = particles.size();
+
+      particles.push_back(&p);
+      for (int j = 0; j < n_partners; j++) {
+        auto const partner = local_particles[p.bl.e[i + j]];
+        if (!partner) {
+          std::string partner_ids;
+          for (int k = 0; k < n_partners; k++)
+            partner_ids += ", " + std::to_string(p.bl.e[i + k]);
+          runtimeErrorMsg() << "bond broken between particles "
+                            << p.p.identity << partner_ids
+                            << " (particles are not stored on the same node)";
+
+          particles.resize(first);
+          break;
+        }
+        particles.push_back(partner);
+      }
+
+      i += n_partners;
+    }
+  }
+
+  std::sort(topology.begin(), topology.end(),
+            [](BondGroup const &a, BondGroup const &b) {
+              return a.type_num < b.type_num;
+            });
+  topology_valid = true;
+}
+} // namespace
+
+std::vector<BondGroup> const &local_bond_topology() {
+  if (not topology_valid)
+    compile_bond_topology();
+
+  return topology;
+}
+
+void invalidate_bond_topology() { topology_valid = false; }
@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CORE_BN_IA_BOND_TOPOLOGY_HPP
+#define CORE_BN_IA_BOND_TOPOLOGY_HPP
+/** \file
+ *  Compiled bond topology of the local particles.
+ *
+ *  The bond lists of the local particles are decoded once into flat
+ *  arrays of particle pointers, one array per bond type. The pointers
+ *  stay valid until the particles are resorted or the particles, bonds
+ *  or bond types change, so the bonded force, virial and constraint
+ *  loops do not have to decode the bond lists and look up the partners
+ *  in @ref local_particles in every time step. The topology is
+ *  invalidated by the corresponding events and recompiled on the next
+ *  access.
+ */
+
+#include "particle_data.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/** All bonds of one bond type whose owner is a local particle. */
+struct BondGroup {
+  /** Index of the bond type in @ref bonded_ia_params. */
+  int type_num;
+  /** Number of partners of each bond. */
+  int n_partners;
+  /** For each bond the owning particle followed by its partners. */
+  std::vector<Particle *> particles;
+
+  /** Number of bonds. */
+  std::size_t size() const { return particles.size() / (n_partners + 1); }
+
+  /** The owner and partners of bond i. */
+  Particle *const *operator[](std::size_t i) const {
+    return particles.data() + i * (n_partners + 1);
+  }
+};
+
+/** @brief Bonds of the local particles, grouped by bond type.
+ *
+ *  The groups are ordered by @ref BondGroup::type_num. The topology is
+ *  compiled if it was invalidated since the last call. Bonds with
+ *  partners that are not available on this node are reported as broken
+ *  during compilation and left out.
+ */
+std::vector<BondGroup> const &local_bond_topology();
+
+/** Mark the compiled bond topology as outdated. */
+void invalidate_bond_topology();
+
+#endif
@@ -32,6 +32,29 @@
 
 int n_thermalized_bonds = 0;
 
+std::unique_ptr<Utils::Counter<uint64_t>> thermalized_bond_rng_counter;
+
+void mpi_bcast_thermalized_bond_rng_counter_slave(const uint64_t counter) {
+  thermalized_bond_rng_counter =
+      std::make_unique<Utils::Counter<uint64_t>>(counter);
+}
+
+REGISTER_CALLBACK(mpi_bcast_thermalized_bond_rng_counter_slave)
+
+bool thermalized_bond_is_seed_required() {
+  return thermalized_bond_rng_counter == nullptr;
+}
+
+void thermalized_bond_set_rng_state(const uint64_t counter) {
+  mpi_call(mpi_bcast_thermalized_bond_rng_counter_slave, counter);
+  thermalized_bond_rng_counter =
+      std::make_unique<Utils::Counter<uint64_t>>(counter);
+}
+
+uint64_t thermalized_bond_get_rng_state() {
+  return thermalized_bond_rng_counter->value();
+}
+
 int thermalized_bond_set_params(int bond_type, double temp_com,
                                 double gamma_com, double temp_distance,
                                 double gamma_distance, double r_cut) {
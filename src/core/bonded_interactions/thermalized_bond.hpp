@@ -35,6 +35,18 @@ extern int n_thermalized_bonds;
 #include "integrate.hpp"
 #include "random.hpp"
 
+#include <utils/Counter.hpp>
+
+#include <cstdint>
+#include <memory>
+
+/** Philox counter of the noise of the thermalized bonds */
+extern std::unique_ptr<Utils::Counter<uint64_t>> thermalized_bond_rng_counter;
+
+bool thermalized_bond_is_seed_required();
+void thermalized_bond_set_rng_state(uint64_t counter);
+uint64_t thermalized_bond_get_rng_state();
+
 /** Set the parameters of a thermalized bond
  *
  *  @retval ES_OK on success
@@ -52,7 +64,7 @@ void thermalized_bond_init();
 /** Separately thermalizes the com and distance of a particle pair.
  *  @param[in]  p1        First particle.
  *  @param[in]  p2        Second particle.
- *  @param[in]  iaparams  Bonded parameters for the pair interaction.
+ *  @param[in]  type_num  Bond type of the pair interaction.
  *  @param[in]  dx        %Distance between the particles.
  *  @param[out] force1    Force on particle @p p1
  *  @param[out] force2    Force on particle @p p2
@@ -60,9 +72,9 @@ void thermalized_bond_init();
  *  @retval 0 otherwise
  */
 inline int calc_thermalized_bond_forces(const Particle *p1, const Particle *p2,
-                                        const Bonded_ia_parameters *iaparams,
-                                        double const dx[3], double force1[3],
-                                        double force2[3]) {
+                                        int type_num, double const dx[3],
+                                        double force1[3], double force2[3]) {
+  auto const iaparams = &bonded_ia_params[type_num];
   // Bond broke?
   if (iaparams->p.thermalized_bond.r_cut > 0.0 &&
       Utils::Vector3d(dx, dx + 3).norm() > iaparams->p.thermalized_bond.r_cut) {
@@ -75,6 +87,14 @@ inline int calc_thermalized_bond_forces(const Particle *p1, const Particle *p2,
   double sqrt_mass_tot = sqrt(mass_tot);
   double sqrt_mass_red = sqrt(p1->p.mass * p2->p.mass / mass_tot);
 
+  // Noise keyed on the particle pair and the bond type, independent of
+  // the traversal order
+  auto const counter = thermalized_bond_rng_counter->value();
+  auto const noise_com = Random::v_noise<RNGSalt::THERMALIZED_BOND_COM>(
+      counter, p1->p.identity, p2->p.identity, type_num);
+  auto const noise_dist = Random::v_noise<RNGSalt::THERMALIZED_BOND_DIST>(
+      counter, p1->p.identity, p2->p.identity, type_num);
+
   for (int i = 0; i < 3; i++) {
 
     // Langevin thermostat for center of mass
@@ -83,7 +103,7 @@ inline int calc_thermalized_bond_forces(const Particle *p1, const Particle *p2,
     if (iaparams->p.thermalized_bond.pref2_com > 0.0) {
       force_lv_com = -iaparams->p.thermalized_bond.pref1_com * com_vel +
                      sqrt_mass_tot * iaparams->p.thermalized_bond.pref2_com *
-                         (d_random() - 0.5);
+                         noise_com[i];
     } else {
       force_lv_com = -iaparams->p.thermalized_bond.pref1_com * com_vel;
     }
@@ -93,7 +113,7 @@ inline int calc_thermalized_bond_forces(const Particle *p1, const Particle *p2,
     if (iaparams->p.thermalized_bond.pref2_dist > 0.0) {
       force_lv_dist = -iaparams->p.thermalized_bond.pref1_dist * dist_vel +
                       sqrt_mass_red * iaparams->p.thermalized_bond.pref2_dist *
-                          (d_random() - 0.5);
+                          noise_dist[i];
     } else {
       force_lv_dist = -iaparams->p.thermalized_bond.pref1_dist * dist_vel;
     }
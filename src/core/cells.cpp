@@ -290,6 +290,23 @@ int cells_get_n_particles() {
                          [](int n, const Cell *c) { return n + c->n; });
 }
 
+std::pair<Utils::Vector3d, Utils::Vector3d> local_cell_bounds(int i) {
+  if (cell_structure.type != CELL_STRUCTURE_DOMDEC)
+    return {Utils::Vector3d{0., 0., 0.}, box_l};
+
+  /* local_cells is ordered like the cell grid, x running fastest */
+  Utils::Vector3d lower;
+  Utils::Vector3d upper;
+  for (int d = 0; d < 3; d++) {
+    auto const index = i % dd.cell_grid[d];
+    i /= dd.cell_grid[d];
+    lower[d] = my_left[d] + index * dd.cell_size[d];
+    upper[d] = lower[d] + dd.cell_size[d];
+  }
+
+  return {lower, upper};
+}
+
 /*************************************************/
 
 namespace {
@@ -270,6 +270,19 @@ void cells_update_ghosts();
 /** Calculate and return the total number of particles on this node. */
 int cells_get_n_particles();
 
+/**
+ * @brief Region of the box covered by a local cell.
+ *
+ * For the domain decomposition this is the cell itself, for the
+ * other cell systems the particles of a cell can be anywhere in the
+ * box. Particles can leave the region by up to half the skin before
+ * they are resorted.
+ *
+ * @param i Index of the cell in @ref local_cells.
+ * @return Lower and upper corner of the region.
+ */
+std::pair<Utils::Vector3d, Utils::Vector3d> local_cell_bounds(int i);
+
 /**
  * @brief Get pairs closer than distance from the cells.
  *
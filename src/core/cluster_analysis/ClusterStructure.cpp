@@ -18,21 +18,115 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "ClusterStructure.hpp"
 #include "Cluster.hpp"
+#include "UnionFind.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
+#include "communication.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "partCfg_global.hpp"
+#include "statistics_parallel.hpp"
+
+#include <utils/math/sqr.hpp>
+#include <utils/mpi/gather_buffer.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <utils/for_each_pair.hpp>
 
 namespace ClusterAnalysis {
 
+namespace {
+/** Pair criteria that can be evaluated on all nodes. */
+struct CriterionParams {
+  enum class Kind : int { distance, energy };
+  Kind kind = Kind::distance;
+  double cut_off = 0.;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &kind &cut_off;
+  }
+};
+
+/** Parameters of the criterion, if it is only fulfilled for pairs
+ *  closer than some distance. */
+boost::optional<CriterionParams>
+criterion_params(PairCriteria::PairCriterion const &criterion) {
+  if (auto const c =
+          dynamic_cast<PairCriteria::DistanceCriterion const *>(&criterion)) {
+    return CriterionParams{CriterionParams::Kind::distance, c->get_cut_off()};
+  }
+  /* Pairs outside of the interaction range have zero energy. */
+  if (auto const c =
+          dynamic_cast<PairCriteria::EnergyCriterion const *>(&criterion)) {
+    if (c->get_cut_off() > 0.)
+      return CriterionParams{CriterionParams::Kind::energy, c->get_cut_off()};
+  }
+  return {};
+}
+
+std::unique_ptr<PairCriteria::PairCriterion>
+make_criterion(CriterionParams const &params) {
+  if (params.kind == CriterionParams::Kind::distance) {
+    auto c = std::make_unique<PairCriteria::DistanceCriterion>();
+    c->set_cut_off(params.cut_off);
+    return c;
+  }
+
+  auto c = std::make_unique<PairCriteria::EnergyCriterion>();
+  c->set_cut_off(params.cut_off);
+  return c;
+}
+
+/** Distance beyond which the criterion is never fulfilled. */
+double criterion_range(CriterionParams const &params) {
+  if (params.kind == CriterionParams::Kind::distance)
+    return params.cut_off;
+  return std::max(max_cut_nonbonded, 0.);
+}
+
+/** @brief Clusters of the pairs in the local cells.
+ *
+ *  @return The representative of the local cluster for each
+ *          particle that is part of one, as (id, representative).
+ */
+std::vector<std::pair<int, int>>
+local_cluster_links(CriterionParams const &params) {
+  auto const criterion = make_criterion(params);
+  auto const range2 = Utils::sqr(criterion_range(params));
+
+  UnionFind sets(max_seen_particle);
+  for_each_local_pair(
+      [&](Particle const &p1, Particle const &p2, double dist2) {
+        if (dist2 <= range2 and criterion->decide(p1, p2))
+          sets.unite(p1.p.identity, p2.p.identity);
+      });
+
+  std::vector<std::pair<int, int>> links;
+  links.reserve(sets.members().size());
+  for (auto const id : sets.members())
+    links.emplace_back(id, sets.find(id));
+
+  return links;
+}
+
+void mpi_cluster_links_slave(CriterionParams const &params) {
+  auto links = local_cluster_links(params);
+  Utils::Mpi::gather_buffer(links, comm_cart);
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_cluster_links_slave)
+
 ClusterStructure::ClusterStructure() { clear(); }
 
 void ClusterStructure::clear() {
   clusters.clear();
   cluster_id.clear();
-  m_cluster_identities.clear();
+  m_sets.reset();
 }
 
 inline bool ClusterStructure::part_of_cluster(const Particle &p) {
@@ -44,16 +138,42 @@ void ClusterStructure::run_for_all_pairs() {
   // clear data structs
   clear();
 
-  // Iterate over pairs
-  Utils::for_each_pair(partCfg().begin(), partCfg().end(),
-                       [this](const Particle &p1, const Particle &p2) {
-                         this->add_pair(p1, p2);
-                       });
+  if (!m_pair_criterion) {
+    runtimeErrorMsg() << "No cluster criterion defined";
+    return;
+  }
+
+  m_sets = std::make_unique<UnionFind>(max_seen_particle);
+
+  // Criteria with a finite range are evaluated on the pairs of the cell
+  // system of each node, the local clusters are merged on the head node.
+  auto const params = criterion_params(*m_pair_criterion);
+  if (params and cell_system_has_pairs(criterion_range(*params))) {
+    mpi_call(mpi_cluster_links_slave, *params);
+    auto links = local_cluster_links(*params);
+    Utils::Mpi::gather_buffer(links, comm_cart);
+
+    for (auto const &link : links)
+      m_sets->unite(link.first, link.second);
+  } else {
+    // Iterate over pairs
+    Utils::for_each_pair(partCfg().begin(), partCfg().end(),
+                         [this](const Particle &p1, const Particle &p2) {
+                           this->add_pair(p1, p2);
+                         });
+  }
   merge_clusters();
 }
 
 void ClusterStructure::run_for_bonded_particles() {
   clear();
+
+  if (!m_pair_criterion) {
+    runtimeErrorMsg() << "No cluster criterion defined";
+    return;
+  }
+
+  m_sets = std::make_unique<UnionFind>(max_seen_particle);
   partCfg().update_bonds();
   for (const auto &p : partCfg()) {
     int j = 0;
@@ -73,88 +193,23 @@ void ClusterStructure::run_for_bonded_particles() {
 }
 
 void ClusterStructure::add_pair(const Particle &p1, const Particle &p2) {
-  // * check, if there's a neighbor
-  //   * No: Then go on to the next particle
-  // * Yes: Then if
-  //   * One of them belongs to a cluster, give the other one the same cluster
-  //     id.
-  //   * None of them belongs to a cluster: Give them both a new cluster id
-  //   * Both belong to different clusters: Mark the clusters as identical
-  //   * so that they can be put together later
-  if (!m_pair_criterion) {
-    runtimeErrorMsg() << "No cluster criterion defined";
-    return;
-  }
-  // If the two particles are neighbors...
+  // If the two particles are neighbors, their clusters are one and the same
   if (m_pair_criterion->decide(p1, p2)) {
-
-    if // None belongs to a cluster
-        ((!part_of_cluster(p1)) && (!part_of_cluster(p2))) {
-      // Both particles belong to the same, new cluster
-      const int cid = get_next_free_cluster_id();
-
-      // assign the cluster_ids
-      cluster_id[p1.p.identity] = cid;
-      cluster_id[p2.p.identity] = cid;
-    } else if // p2 belongs to a cluster but p1 doesn't
-        (part_of_cluster(p2) && !part_of_cluster(p1)) {
-      // Give p1 the same cluster id as p2
-      cluster_id[p1.p.identity] = find_id_for(cluster_id.at(p2.p.identity));
-    } else if // i belongs to a cluster but j doesn't
-        (part_of_cluster(p1) && !part_of_cluster(p2)) {
-      // give p2 the cluster id from p1
-      cluster_id[p2.p.identity] = find_id_for(cluster_id.at(p1.p.identity));
-    } else if // Both belong to different clusters
-        (part_of_cluster(p1) && part_of_cluster(p2) &&
-         cluster_id.at(p1.p.identity) != cluster_id.at(p2.p.identity)) {
-      // Clusters of p1 and p2 are one and the same. Add an identity to the list
-      // The higher number must be inserted as first value of the pair
-      // because the substitutions later have to be done in descending order
-      const int cid1 = find_id_for(cluster_id.at(p1.p.identity));
-      const int cid2 = find_id_for(cluster_id.at(p2.p.identity));
-      if (cid1 > cid2) {
-        m_cluster_identities[cid1] = cid2;
-      } else if (cid1 < cid2) {
-        m_cluster_identities[cid2] = cid1;
-      }
-      // else do nothing. The clusters are already noted for merging.
-      // Connected clusters will be merged later
-    }
-    // The case for both particles being in the same cluster does not need to be
-    // treated.
+    m_sets->unite(p1.p.identity, p2.p.identity);
   }
 }
 
 void ClusterStructure::merge_clusters() {
-  // Relabel particles according to the cluster identities map
-  // Also create empty cluster objects for the final cluster id
-
-  // Collect needed changes in a separate map, as doing the changes on the fly
-  // would screw up the iterators
-  std::vector<std::pair<int, int>> to_be_changed;
-
-  for (auto it : cluster_id) {
-    // particle id is in it.first and cluster id in it.second
-    // We change the cluster id according to the cluster identities
-    // map
-    const int cid = find_id_for(it.second);
-    // We note the list of changes here, so we don't modify the map
-    // while iterating
-    to_be_changed.emplace_back(it.first, cid);
-    // Empty cluster object
-    if (clusters.find(cid) == clusters.end()) {
-      clusters[cid] = std::make_shared<Cluster>();
-    }
-  }
-
-  // Now act on the changes marke in above iteration
-  for (auto it : to_be_changed) {
-    cluster_id[it.first] = it.second;
+  // The cluster id is the smallest particle id in the cluster
+  for (auto const id : m_sets->members()) {
+    cluster_id[id] = m_sets->find(id);
   }
 
   // Now fill the cluster objects with particle ids
   // Iterate over particles, fill in the cluster map
-  // to each cluster particle the corresponding cluster id
+  // to each cluster particle the corresponding cluster id.
+  // The map is ordered by particle id, so the particle ids
+  // in the clusters are sorted.
   for (auto it : cluster_id) {
     // If this is the first particle in this cluster, instance a new cluster
     // object
@@ -164,30 +219,7 @@ void ClusterStructure::merge_clusters() {
     clusters[it.second]->particles.push_back(it.first);
   }
 
-  // Sort particles ids in the clusters
-  for (const auto &c : clusters) {
-    std::sort(c.second->particles.begin(), c.second->particles.end());
-  }
-}
-
-int ClusterStructure::find_id_for(int x) {
-  int tmp = x;
-  while (m_cluster_identities.find(tmp) != m_cluster_identities.end()) {
-    tmp = m_cluster_identities[tmp];
-  }
-  return tmp;
-}
-
-int ClusterStructure::get_next_free_cluster_id() {
-  // iterate over cluster_id'
-  int max_seen_cluster = 0;
-  for (auto it : cluster_id) {
-    int cid = it.second;
-    if (max_seen_cluster < cid) {
-      max_seen_cluster = cid;
-    }
-  }
-  return max_seen_cluster + 1;
+  m_sets.reset();
 }
 
 } // namespace ClusterAnalysis
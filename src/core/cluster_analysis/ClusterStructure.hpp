@@ -22,10 +22,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "pair_criteria/pair_criteria.hpp"
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Cluster.hpp"
+#include "UnionFind.hpp"
 #include "pair_criteria/pair_criteria.hpp"
 #include "particle_data.hpp"
 
@@ -42,7 +44,11 @@ public:
   std::map<int, int> cluster_id;
   /** @brief Clear data structures */
   void clear();
-  /** @brief Run cluster analysis, consider all particle pairs */
+  /** @brief Run cluster analysis, consider all particle pairs.
+   *
+   * If the pair criterion is only fulfilled below a distance covered by
+   * the cell system, the pairs are found in parallel on all nodes.
+   */
   void run_for_all_pairs();
   /** @brief Run cluster analysis, consider pairs of particles connected by a
    * bonded interaction */
@@ -60,11 +66,9 @@ public:
   }
 
 private:
-  /** @brief Clusters that turn out to be the same during the analysis process
-   * (i.e., if two particles are neighbors that already belong to different
-   * clusters
-   */
-  std::map<int, int> m_cluster_identities;
+  /** @brief Particles found to be in the same cluster during the analysis
+   * process */
+  std::unique_ptr<UnionFind> m_sets;
 
   /** @brief pair criterion which decides whether two particles are neighbors */
   std::shared_ptr<PairCriteria::PairCriterion> m_pair_criterion;
@@ -73,10 +77,6 @@ private:
   void add_pair(const Particle &p1, const Particle &p2);
   /** Merge clusters and populate their structures */
   void merge_clusters();
-  /** @brief Follow a chain of cluster identities during analysis */
-  inline int find_id_for(int x);
-  /** @brief Get next free cluster id */
-  inline int get_next_free_cluster_id();
 };
 
 } // namespace ClusterAnalysis
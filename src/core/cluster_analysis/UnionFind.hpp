@@ -0,0 +1,84 @@
+/*
+Copyright (C) 2019 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CLUSTER_ANALYSIS_UNION_FIND_HPP
+#define CLUSTER_ANALYSIS_UNION_FIND_HPP
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace ClusterAnalysis {
+
+/** @brief Disjoint sets of particle ids.
+ *
+ *  Ids that were never passed to @ref unite are not part of any set.
+ *  The representative of a set is its smallest id, so the result does
+ *  not depend on the order in which the pairs are added.
+ */
+class UnionFind {
+public:
+  /** @param max_id Largest id that can be added. */
+  explicit UnionFind(int max_id) : m_parent(max_id + 1, -1) {}
+
+  /** Whether id is part of a set. */
+  bool contains(int id) const { return m_parent[id] >= 0; }
+
+  /** @brief Representative of the set of id.
+   *
+   *  The path to the root is compressed by halving.
+   */
+  int find(int id) {
+    assert(contains(id));
+    while (m_parent[id] != id) {
+      m_parent[id] = m_parent[m_parent[id]];
+      id = m_parent[id];
+    }
+    return id;
+  }
+
+  /** Merge the sets of a and b. */
+  void unite(int a, int b) {
+    add(a);
+    add(b);
+
+    auto ra = find(a);
+    auto rb = find(b);
+    if (rb < ra)
+      std::swap(ra, rb);
+    m_parent[rb] = ra;
+  }
+
+  /** Ids that are part of a set, in the order they were added. */
+  std::vector<int> const &members() const { return m_members; }
+
+private:
+  void add(int id) {
+    if (not contains(id)) {
+      m_parent[id] = id;
+      m_members.push_back(id);
+    }
+  }
+
+  std::vector<int> m_parent;
+  std::vector<int> m_members;
+};
+
+} // namespace ClusterAnalysis
+
+#endif
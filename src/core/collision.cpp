@@ -29,12 +29,17 @@
 #include "virtual_sites/VirtualSitesRelative.hpp"
 
 #include <utils/mpi/all_compare.hpp>
-#include <utils/mpi/gather_buffer.hpp>
 
 #include <boost/algorithm/clamp.hpp>
 #include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/mpi/operations.hpp>
 #include <boost/serialization/serialization.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #ifdef COLLISION_DETECTION_DEBUG
@@ -365,6 +370,30 @@ void coldet_do_three_particle_bond(Particle &p, Particle &p1, Particle &p2) {
 }
 
 #ifdef VIRTUAL_SITES_RELATIVE
+/** @brief First id of the virtual sites created on this node.
+ *
+ *  The nodes get consecutive ranges of ids in the order of their rank,
+ *  starting after the largest particle id at the beginning of the time
+ *  step, on which all nodes agree. So the nodes can create particles
+ *  independently of each other, and the ids stay contiguous. To be
+ *  called on all nodes.
+ *
+ *  @param n_local Number of virtual sites created on this node.
+ *  @return The first id for this node and the number of virtual sites
+ *          created on all nodes.
+ */
+std::pair<int, int> reserve_vs_ids(int n_local) {
+  /* The result of the exclusive scan is undefined on the first node */
+  int offset = 0;
+  MPI_Exscan(&n_local, &offset, 1, MPI_INT, MPI_SUM, comm_cart);
+  if (this_node == 0)
+    offset = 0;
+  auto const n_total =
+      boost::mpi::all_reduce(comm_cart, n_local, std::plus<int>());
+
+  return {max_seen_particle + 1 + offset, n_total};
+}
+
 void place_vs_and_relate_to_particle(const int current_vs_pid,
                                      const Utils::Vector3d &pos, int relate_to,
                                      const Utils::Vector3d &initial_pos) {
@@ -383,57 +412,109 @@ void place_vs_and_relate_to_particle(const int current_vs_pid,
   p_vs->p.type = collision_params.vs_particle_type;
 }
 
-void bind_at_poc_create_bond_between_vs(const int current_vs_pid,
+void bind_at_poc_create_bond_between_vs(const int vs1, const int vs2,
                                         const collision_struct &c) {
   switch (bonded_ia_params[collision_params.bond_vs].num) {
   case 1: {
     // Create bond between the virtual particles
-    const int bondG[] = {collision_params.bond_vs, current_vs_pid - 2};
-    // Only add bond if vs was created on this node
-    if (local_particles[current_vs_pid - 1])
-      local_add_particle_bond(get_part(current_vs_pid - 1), bondG);
+    const int bondG[] = {collision_params.bond_vs, vs1};
+    local_add_particle_bond(get_part(vs2), bondG);
     break;
   }
   case 2: {
     // Create 1st bond between the virtual particles
     const int bondG[] = {collision_params.bond_vs, c.pp1, c.pp2};
-    // Only add bond if vs was created on this node
-    if (local_particles[current_vs_pid - 1])
-      local_add_particle_bond(get_part(current_vs_pid - 1), bondG);
-    if (local_particles[current_vs_pid - 2])
-      local_add_particle_bond(get_part(current_vs_pid - 2), bondG);
+    local_add_particle_bond(get_part(vs1), bondG);
+    local_add_particle_bond(get_part(vs2), bondG);
     break;
   }
   }
 }
 
-void glue_to_surface_bind_part_to_vs(const Particle *const p1,
-                                     const Particle *const p2,
-                                     const int vs_pid_plus_one,
-                                     const collision_struct &c) {
-  // Create bond between the virtual particles
-  const int bondG[] = {collision_params.bond_vs, vs_pid_plus_one - 1};
+void glue_to_surface_bind_part_to_vs(const int glued, const int vs) {
+  // Create bond between the glued particle and the virtual site
+  const int bondG[] = {collision_params.bond_vs, vs};
 
-  if (p1->p.type == collision_params.part_type_after_glueing) {
-    local_add_particle_bond(get_part(p1->p.identity), bondG);
-  } else {
-    local_add_particle_bond(get_part(p2->p.identity), bondG);
-  }
+  local_add_particle_bond(get_part(glued), bondG);
 }
 
 #endif
 
-std::vector<collision_struct> gather_global_collision_queue() {
+/** @brief Nodes that can hold copies of the particles of this node.
+ *
+ *  With domain decomposition these are the nodes adjacent to this one
+ *  in the node grid, for the other cell systems all nodes.
+ */
+std::vector<int> collision_neighbor_nodes() {
+  std::vector<int> nodes;
+
+  if (cell_structure.type != CELL_STRUCTURE_DOMDEC) {
+    for (int node = 0; node < n_nodes; node++)
+      if (node != this_node)
+        nodes.push_back(node);
+
+    return nodes;
+  }
+
+  Utils::Vector3i pos;
+  for (int i = -1; i <= 1; i++)
+    for (int j = -1; j <= 1; j++)
+      for (int k = -1; k <= 1; k++) {
+        Utils::Vector3i const shift{i, j, k};
+        for (int dir = 0; dir < 3; dir++)
+          pos[dir] = (node_pos[dir] + shift[dir] + node_grid[dir]) %
+                     node_grid[dir];
+
+        auto const node = map_array_node(pos);
+        if (node != this_node)
+          nodes.push_back(node);
+      }
+
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  return nodes;
+}
+
+/** @brief Collisions of the local queue and of the neighbor nodes.
+ *
+ *  A collision is recorded by one of the nodes that hold the involved
+ *  particles, and all nodes that hold a copy of one of the particles
+ *  are neighbors of the owner of that particle. So every node that has
+ *  to act on a collision is a neighbor of the node that recorded it,
+ *  and the queues only need to be exchanged with the neighbors.
+ *  The result is ordered by the particle ids, so that it does not
+ *  depend on the order in which the collisions were detected.
+ */
+std::vector<collision_struct> neighbor_collision_queue() {
+  auto const neighbors = collision_neighbor_nodes();
+
+  std::vector<std::vector<collision_struct>> recv_queues(neighbors.size());
+  std::vector<boost::mpi::request> reqs;
+  for (std::size_t i = 0; i < neighbors.size(); i++) {
+    reqs.push_back(comm_cart.isend(neighbors[i], 0, local_collision_queue));
+    reqs.push_back(comm_cart.irecv(neighbors[i], 0, recv_queues[i]));
+  }
+  boost::mpi::wait_all(reqs.begin(), reqs.end());
+
   std::vector<collision_struct> res = local_collision_queue;
-  Utils::Mpi::gather_buffer(res, comm_cart);
-  boost::mpi::broadcast(comm_cart, res, 0);
+  for (auto const &q : recv_queues)
+    res.insert(res.end(), q.begin(), q.end());
+
+  std::sort(res.begin(), res.end(),
+            [](collision_struct const &a, collision_struct const &b) {
+              return std::make_pair(std::min(a.pp1, a.pp2),
+                                    std::max(a.pp1, a.pp2)) <
+                     std::make_pair(std::min(b.pp1, b.pp2),
+                                    std::max(b.pp1, b.pp2));
+            });
 
   return res;
 }
 
-static void three_particle_binding_do_search(Cell *basecell, Particle &p1,
-                                             Particle &p2) {
-  auto handle_cell = [&p1, &p2](Cell *c) {
+static void three_particle_binding_do_search(std::vector<Cell *> const &cells,
+                                             Particle &p1, Particle &p2) {
+  for (auto c : cells) {
     for (int p_id = 0; p_id < c->n; p_id++) {
       auto &P = c->part[p_id];
 
@@ -459,14 +540,6 @@ static void three_particle_binding_do_search(Cell *basecell, Particle &p1,
         coldet_do_three_particle_bond(p2, P, p1);
       }
     }
-  };
-
-  /* Search the base cell ... */
-  handle_cell(basecell);
-
-  /* ... and all the neighbors. */
-  for (auto &n : basecell->neighbors().all()) {
-    handle_cell(n);
   }
 }
 
@@ -474,22 +547,32 @@ static void three_particle_binding_do_search(Cell *basecell, Particle &p1,
 // looks for a third particle by using the domain decomposition
 // cell system. If found, it performs three particle binding
 void three_particle_binding_domain_decomposition(
-    const std::vector<collision_struct> &gathered_queue) {
+    const std::vector<collision_struct> &queue) {
+  std::vector<Cell *> cells;
 
-  for (auto &c : gathered_queue) {
+  for (auto &c : queue) {
     // If we have both particles, at least as ghosts, Get the corresponding cell
     // indices
     if ((local_particles[c.pp1]) && (local_particles[c.pp2])) {
       Particle &p1 = *local_particles[c.pp1];
       Particle &p2 = *local_particles[c.pp2];
-      auto cell1 = find_current_cell(p1);
-      auto cell2 = find_current_cell(p2);
 
-      if (cell1)
-        three_particle_binding_do_search(cell1, p1, p2);
-      if (cell2 && cell1 != cell2)
-        three_particle_binding_do_search(cell2, p1, p2);
+      // The cells of both particles and their neighbors. The neighborhoods
+      // overlap and include the cells themselves, so every cell is only
+      // searched once.
+      cells.clear();
+      for (auto cell : {find_current_cell(p1), find_current_cell(p2)}) {
+        if (cell) {
+          cells.push_back(cell);
+          for (auto &n : cell->neighbors().all()) {
+            cells.push_back(n);
+          }
+        }
+      }
+      std::sort(cells.begin(), cells.end());
+      cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
 
+      three_particle_binding_do_search(cells, p1, p2);
     } // If local particles exist
   }   // Loop over total collisions
 }
@@ -522,184 +605,152 @@ void handle_collisions() {
     }
   }
 
+  // Collisions across node boundaries are only recorded by one of the
+  // nodes, but the neighbors might still have to act on their particles.
+  std::vector<collision_struct> queue;
+  if (collision_params.mode &
+      (COLLISION_MODE_VS | COLLISION_MODE_GLUE_TO_SURF |
+       COLLISION_MODE_BIND_THREE_PARTICLES)) {
+    queue = neighbor_collision_queue();
+  }
+
 // Virtual sites based collision schemes
 #ifdef VIRTUAL_SITES_RELATIVE
   if ((collision_params.mode & COLLISION_MODE_VS) ||
       (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF)) {
-    // Gather the global collision queue, because only one node has a collision
-    // across node boundaries in its queue.
-    // The other node might still have to change particle properties on its
-    // non-ghost particle
-    auto gathered_queue = gather_global_collision_queue();
-
-    // Sync max_seen_part
-    MPI_Allreduce(MPI_IN_PLACE, &max_seen_particle, 1, MPI_INT, MPI_MAX,
-                  comm_cart);
-
-    // Make sure, the local_particles array is long enough
-    realloc_local_particles(max_seen_particle);
-
-    int current_vs_pid = max_seen_particle + 1;
-
-    // Iterate over global collision queue
-    for (auto &c : gathered_queue) {
-
-      // Get particle pointers
-      Particle *p1 = local_particles[c.pp1];
-      Particle *p2 = local_particles[c.pp2];
-
-      // Only nodes take part in particle creation and binding
-      // that see both particles
-
-      // If we cannot access both particles, both are ghosts,
-      // ore one is ghost and one is not accessible
-      // we only increase the counter for the ext id to use based on the
-      // number of particles created by other nodes
-      if (((!p1 or p1->l.ghost) and (!p2 or p2->l.ghost)) or !p1 or !p2) {
-        // Increase local counters
-        if (collision_params.mode & COLLISION_MODE_VS) {
-          added_particle(current_vs_pid);
-          current_vs_pid++;
+    // Use initial position for new vs, which is in the local node's
+    // domain
+    // Vs is moved afterwards and resorted after all collision s are handled
+    const Utils::Vector3d initial_pos{my_left[0], my_left[1], my_left[2]};
+
+    if (collision_params.mode & COLLISION_MODE_VS) {
+      // Enable rotation on the particles to which vs will be attached,
+      // this has to happen on the node that has the particle
+      for (auto const &c : queue) {
+        for (auto const id : {c.pp1, c.pp2}) {
+          auto p = local_particles[id];
+          if (p and not p->l.ghost)
+            p->p.rotation = ROTATION_X | ROTATION_Y | ROTATION_Z;
         }
-        // For glue to surface, we have only one vs
-        added_particle(current_vs_pid);
-        current_vs_pid++;
-        if (collision_params.mode == COLLISION_MODE_GLUE_TO_SURF) {
-          if (p1)
-            if (p1->p.type == collision_params.part_type_to_be_glued) {
-              p1->p.type = collision_params.part_type_after_glueing;
-            }
-          if (p2)
-            if (p2->p.type == collision_params.part_type_to_be_glued) {
-              p2->p.type = collision_params.part_type_after_glueing;
-            }
-        } // mode glue to surface
-
-      } else { // We consider the pair because one particle
-               // is local to the node and the other is local or ghost
-
-        // Use initial position for new vs, which is in the local node's
-        // domain
-        // Vs is moved afterwards and resorted after all collision s are handled
-        const Utils::Vector3d initial_pos{my_left[0], my_left[1], my_left[2]};
-
-        // If we are in the two vs mode
-        // Virtual site related to first particle in the collision
-        if (collision_params.mode & COLLISION_MODE_VS) {
-          Utils::Vector3d pos1, pos2;
-
-          // Enable rotation on the particles to which vs will be attached
-          p1->p.rotation = ROTATION_X | ROTATION_Y | ROTATION_Z;
-          p2->p.rotation = ROTATION_X | ROTATION_Y | ROTATION_Z;
-
-          // Positions of the virtual sites
-          bind_at_point_of_collision_calc_vs_pos(p1, p2, pos1, pos2);
-
-          auto handle_particle = [&](Particle *p, Utils::Vector3d const &pos) {
-            if (not p->l.ghost) {
-              place_vs_and_relate_to_particle(current_vs_pid, pos,
-                                              p->identity(), initial_pos);
-              // Particle storage locations may have changed due to
-              // added particle
-              p1 = local_particles[c.pp1];
-              p2 = local_particles[c.pp2];
-            } else {
-              added_particle(current_vs_pid);
-            }
-          };
-
-          // place virtual sites on the node where the base particle is not a
-          // ghost
-          handle_particle(p1, pos1);
-          // Increment counter
-          current_vs_pid++;
-
-          handle_particle(p2, pos2);
-          // Increment counter
-          current_vs_pid++;
-          // Create bonds between the vs.
-
-          bind_at_poc_create_bond_between_vs(current_vs_pid, c);
-        } // mode VS
-
-        if (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF) {
-          // If particles are made inert by a type change on collision:
-          // We skip the pair if one of the particles has already reacted
-          // but we still increase the particle counters, as other nodes
-          // can not always know whether or not a vs is placed
-          if (collision_params.part_type_after_glueing !=
-              collision_params.part_type_to_be_glued) {
-            if ((p1->p.type == collision_params.part_type_after_glueing) ||
-                (p2->p.type == collision_params.part_type_after_glueing)) {
-
-              added_particle(current_vs_pid);
-              current_vs_pid++;
-              continue;
-            }
+      }
+    } // mode VS
+
+    /* Virtual site of a glue to surface collision: position, particle to
+     * relate the site to and the glued particle to bind to it. */
+    struct GlueSite {
+      Utils::Vector3d pos;
+      int attach_vs_to;
+      int glued;
+    };
+    std::vector<GlueSite> glue_sites;
+
+    if (collision_params.mode & COLLISION_MODE_GLUE_TO_SURF) {
+      // A collision is handled by the node that has the particle to be
+      // glued. It sees all collisions of that particle, so it alone can
+      // decide whether the particle has already reacted in this step.
+      for (auto const &c : queue) {
+        Particle *p1 = local_particles[c.pp1];
+        Particle *p2 = local_particles[c.pp2];
+
+        if (!p1 or !p2)
+          continue;
+
+        auto const glued =
+            (p1->p.type == collision_params.part_type_to_attach_vs_to) ? p2
+                                                                       : p1;
+        if (glued->l.ghost)
+          continue;
+
+        // If particles are made inert by a type change on collision:
+        // We skip the pair if one of the particles has already reacted
+        if (collision_params.part_type_after_glueing !=
+            collision_params.part_type_to_be_glued) {
+          if ((p1->p.type == collision_params.part_type_after_glueing) ||
+              (p2->p.type == collision_params.part_type_after_glueing)) {
+            continue;
           }
+        }
 
-          Utils::Vector3d pos;
-          const Particle &attach_vs_to =
-              glue_to_surface_calc_vs_pos(*p1, *p2, pos);
-
-          // Add a bond between the centers of the colliding particles
-          // The bond is placed on the node that has p1
-          if (!p1->l.ghost) {
-            int bondG[2];
-            bondG[0] = collision_params.bond_centers;
-            bondG[1] = c.pp2;
-            local_add_particle_bond(get_part(c.pp1), bondG);
-          }
+        Utils::Vector3d pos;
+        auto const attach_vs_to =
+            glue_to_surface_calc_vs_pos(*p1, *p2, pos).identity();
 
-          // Change type of particle being attached, to make it inert
-          if (p1->p.type == collision_params.part_type_to_be_glued) {
-            p1->p.type = collision_params.part_type_after_glueing;
-          }
-          if (p2->p.type == collision_params.part_type_to_be_glued) {
-            p2->p.type = collision_params.part_type_after_glueing;
-          }
+        // Add a bond between the centers of the colliding particles
+        int bondG[2];
+        bondG[0] = collision_params.bond_centers;
+        bondG[1] = attach_vs_to;
+        local_add_particle_bond(*glued, bondG);
 
-          // Vs placement happens on the node that has p1
-          if (!attach_vs_to.l.ghost) {
-            place_vs_and_relate_to_particle(
-                current_vs_pid, pos, attach_vs_to.identity(), initial_pos);
-            // Particle storage locations may have changed due to
-            // added particle
-            p1 = local_particles[c.pp1];
-            p2 = local_particles[c.pp2];
-            current_vs_pid++;
-          } else { // Just update the books
-            added_particle(current_vs_pid);
-            current_vs_pid++;
-          }
-          glue_to_surface_bind_part_to_vs(p1, p2, current_vs_pid, c);
+        // Change type of particle being attached, to make it inert
+        if (glued->p.type == collision_params.part_type_to_be_glued) {
+          glued->p.type = collision_params.part_type_after_glueing;
         }
-      } // we considered the pair
-    }   // Loop over all collisions in the queue
-#ifdef ADDITIONAL_CHECKS
-    if (!Utils::Mpi::all_compare(comm_cart, current_vs_pid)) {
-      throw std::runtime_error("Nodes disagree about current_vs_pid");
+
+        glue_sites.push_back({pos, attach_vs_to, glued->identity()});
+      }
+    } // mode glue to surface
+
+    auto const n_local_vs =
+        static_cast<int>(glue_sites.size()) +
+        ((collision_params.mode & COLLISION_MODE_VS)
+             ? 2 * static_cast<int>(local_collision_queue.size())
+             : 0);
+    int next_vs, n_created;
+    std::tie(next_vs, n_created) = reserve_vs_ids(n_local_vs);
+    auto const max_pid = max_seen_particle + n_created;
+
+    if (collision_params.mode & COLLISION_MODE_VS) {
+      // Both virtual sites are created by the node that recorded the
+      // collision, it has both particles at least as ghosts.
+      // The resort moves them to the nodes of their base particles.
+      for (auto const &c : local_collision_queue) {
+        Utils::Vector3d pos1, pos2;
+
+        // Positions of the virtual sites
+        bind_at_point_of_collision_calc_vs_pos(&get_part(c.pp1),
+                                               &get_part(c.pp2), pos1, pos2);
+
+        auto const vs1 = next_vs++;
+        place_vs_and_relate_to_particle(vs1, pos1, c.pp1, initial_pos);
+        auto const vs2 = next_vs++;
+        place_vs_and_relate_to_particle(vs2, pos2, c.pp2, initial_pos);
+
+        // Create bonds between the vs.
+        bind_at_poc_create_bond_between_vs(vs1, vs2, c);
+      }
     }
-    if (!Utils::Mpi::all_compare(comm_cart, max_seen_particle)) {
-      throw std::runtime_error("Nodes disagree about max_seen_particle");
+
+    for (auto const &g : glue_sites) {
+      auto const vs = next_vs++;
+      place_vs_and_relate_to_particle(vs, g.pos, g.attach_vs_to, initial_pos);
+      glue_to_surface_bind_part_to_vs(g.glued, vs);
     }
-#endif
 
     // If any node had a collision, all nodes need to do on_particle_change
     // and resort
+    if (n_created > 0) {
+      // Update the books: the total number of particles and the id range
+      n_part += n_created - n_local_vs;
+
+      // Make sure, the local_particles array is long enough
+      realloc_local_particles(max_pid);
+      max_seen_particle = max_pid;
 
-    if (!gathered_queue.empty()) {
       on_particle_change();
       announce_resort_particles();
       cells_update_ghosts();
     }
+#ifdef ADDITIONAL_CHECKS
+    if (!Utils::Mpi::all_compare(comm_cart, max_seen_particle)) {
+      throw std::runtime_error("Nodes disagree about max_seen_particle");
+    }
+#endif
   }    // are we in one of the vs_based methods
 #endif // defined VIRTUAL_SITES_RELATIVE
 
   // three-particle-binding part
   if (collision_params.mode & (COLLISION_MODE_BIND_THREE_PARTICLES)) {
-    auto gathered_queue = gather_global_collision_queue();
-    three_particle_binding_domain_decomposition(gathered_queue);
+    three_particle_binding_domain_decomposition(queue);
   } // if TPB
 
   local_collision_queue.clear();
@@ -56,6 +56,20 @@ public:
    */
   virtual bool fits_in_box(Utils::Vector3d const &box) const = 0;
 
+  /**
+   * @brief Check if the constraint can act on particles in a region.
+   *
+   * This is used to skip the constraint for cells that are far away
+   * from it, so it may only return false if the force on any particle
+   * within the region is zero. The default is to always return true.
+   *
+   * @param center Center of the region.
+   * @param radius Largest distance of a point in the region from center.
+   */
+  virtual bool may_act_in(Utils::Vector3d const &center, double radius) const {
+    return true;
+  }
+
   virtual void reset_force(){};
 
   virtual ~Constraint() = default;
@@ -19,6 +19,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef CORE_CONSTRAINTS_CONSTRAINTS_HPP
 #define CORE_CONSTRAINTS_CONSTRAINTS_HPP
 
+#include "cells.hpp"
+#include "grid.hpp"
+#include "integrate.hpp"
 #include "statistics.hpp"
 
 #include <memory>
@@ -43,6 +46,44 @@ private:
   }
 
   container_type m_constraints;
+  /** Constraints that may act on the particles of each local cell. */
+  std::vector<std::vector<Constraint *>> m_cell_constraints;
+  bool m_cell_constraints_valid = false;
+
+  /**
+   * @brief Find the constraints that can act on each local cell.
+   *
+   * The region of a cell is extended by half the skin, the distance
+   * particles can travel before they are resorted. Folding can move
+   * the particles of cells at the box boundary to the opposite side,
+   * so these cells keep all constraints.
+   */
+  void update_cell_constraints(CellPList &cells) {
+    m_cell_constraints.resize(cells.n);
+
+    for (int i = 0; i < cells.n; i++) {
+      auto const bounds = local_cell_bounds(i);
+      auto const lower = bounds.first - Utils::Vector3d::broadcast(0.5 * skin);
+      auto const upper = bounds.second + Utils::Vector3d::broadcast(0.5 * skin);
+
+      bool at_boundary = false;
+      for (int d = 0; d < 3; d++) {
+        at_boundary |= (lower[d] < 0.) or (upper[d] > box_l[d]);
+      }
+
+      auto const center = 0.5 * (lower + upper);
+      auto const radius = 0.5 * (upper - lower).norm();
+
+      auto &candidates = m_cell_constraints[i];
+      candidates.clear();
+      for (auto const &c : m_constraints) {
+        if (at_boundary or c->may_act_in(center, radius))
+          candidates.push_back(c.get());
+      }
+    }
+
+    m_cell_constraints_valid = true;
+  }
 
 public:
   void add(std::shared_ptr<Constraint> const &c) {
@@ -65,20 +106,40 @@ public:
   const_iterator begin() const { return m_constraints.begin(); }
   const_iterator end() const { return m_constraints.end(); }
 
-  void add_forces(ParticleRange &particles, double t) const {
+  /**
+   * @brief Add the constraint forces to the particles.
+   *
+   * Only the constraints that can act on a cell are evaluated
+   * for its particles.
+   *
+   * @param cells The local cells, in the order of @ref local_cells.
+   * @param t The time at which the forces should be calculated.
+   */
+  void add_forces(CellPList &cells, double t) {
     if (m_constraints.empty())
       return;
 
     reset_foces();
 
-    for (auto &p : particles) {
-      auto const pos = folded_position(p);
-      ParticleForce force{};
-      for (auto const &c : *this) {
-        force += c->force(p, pos, t);
-      }
+    if (not m_cell_constraints_valid)
+      update_cell_constraints(cells);
+
+    for (int i = 0; i < cells.n; i++) {
+      auto const &candidates = m_cell_constraints[i];
+      if (candidates.empty())
+        continue;
 
-      p.f += force;
+      auto const cell = cells.cell[i];
+      for (int j = 0; j < cell->n; j++) {
+        auto &p = cell->part[j];
+        auto const pos = folded_position(p);
+        ParticleForce force{};
+        for (auto const c : candidates) {
+          force += c->force(p, pos, t);
+        }
+
+        p.f += force;
+      }
     }
   }
 
@@ -93,6 +154,10 @@ public:
     }
   }
 
+  /** Drop the constraint lists of the cells, they are rebuilt on the next
+   *  force calculation. */
+  void invalidate_cell_constraints() { m_cell_constraints_valid = false; }
+
   void on_boxl_change() const {
     if (not this->empty()) {
       throw std::runtime_error("The box size can not be changed because there "
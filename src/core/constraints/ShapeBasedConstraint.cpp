@@ -55,6 +55,19 @@ double ShapeBasedConstraint::min_dist() {
   return global_mindist;
 }
 
+bool ShapeBasedConstraint::may_act_in(Utils::Vector3d const &center,
+                                      double radius) const {
+  if (not m_shape->has_exact_distance())
+    return true;
+
+  double dist;
+  Utils::Vector3d vec;
+  m_shape->calculate_dist(center, &dist, vec.data());
+
+  auto const range = radius + max_cut_nonbonded;
+  return m_penetrable ? (std::abs(dist) <= range) : (dist <= range);
+}
+
 ParticleForce ShapeBasedConstraint::force(const Particle &p,
                                           const Utils::Vector3d &folded_pos,
                                           double t) {
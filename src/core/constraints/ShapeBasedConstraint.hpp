@@ -45,6 +45,12 @@ public:
 
   bool fits_in_box(Utils::Vector3d const &) const override { return true; }
 
+  /* Uses the distance from the shape as bound, the distance changes
+   * at most by the distance between two points. Shapes with only an
+   * approximate distance can act everywhere. */
+  bool may_act_in(Utils::Vector3d const &center,
+                  double radius) const override;
+
   /* finds the minimum distance to all particles */
   double min_dist();
 
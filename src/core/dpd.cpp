@@ -33,6 +33,25 @@
 
 #include <utils/constants.hpp>
 
+#include <algorithm>
+
+std::unique_ptr<Utils::Counter<uint64_t>> dpd_rng_counter;
+
+void mpi_bcast_dpd_rng_counter_slave(const uint64_t counter) {
+  dpd_rng_counter = std::make_unique<Utils::Counter<uint64_t>>(counter);
+}
+
+REGISTER_CALLBACK(mpi_bcast_dpd_rng_counter_slave)
+
+bool dpd_is_seed_required() { return dpd_rng_counter == nullptr; }
+
+void dpd_set_rng_state(const uint64_t counter) {
+  mpi_call(mpi_bcast_dpd_rng_counter_slave, counter);
+  dpd_rng_counter = std::make_unique<Utils::Counter<uint64_t>>(counter);
+}
+
+uint64_t dpd_get_rng_state() { return dpd_rng_counter->value(); }
+
 void dpd_heat_up() {
   double pref_scale = sqrt(3);
   dpd_update_params(pref_scale);
@@ -121,12 +140,35 @@ static double weight(int type, double r_cut, double dist_inv) {
   return dist_inv - 1.0 / r_cut;
 }
 
+/** Uniform noise in [-0.5, 0.5) for a pair, the last component for the
+ *  longitudinal and the others for the transversal part. The noise is the
+ *  same for both orders of the particles, the sign of the transversal
+ *  part is flipped with the order, like the distance vector. */
+static Utils::Vector4d dpd_noise(Particle const *p1, Particle const *p2) {
+  auto const id1 = p1->p.identity;
+  auto const id2 = p2->p.identity;
+  auto const u = Random::philox_4_uniforms<RNGSalt::SALT_DPD>(
+      dpd_rng_counter->value(), std::min(id1, id2), std::max(id1, id2));
+  auto const sign = (id1 < id2) ? 1. : -1.;
+
+  return {sign * (u[0] - 0.5), sign * (u[1] - 0.5), sign * (u[2] - 0.5),
+          u[3] - 0.5};
+}
+
 Utils::Vector3d dpd_pair_force(Particle const *p1, Particle const *p2,
                                IA_parameters *ia_params, double const *d,
                                double dist, double dist2) {
   Utils::Vector3d f{};
   auto const dist_inv = 1.0 / dist;
 
+  if (not((dist < ia_params->dpd_r_cut) && (ia_params->dpd_pref1 > 0.0)) &&
+      not((dist < ia_params->dpd_tr_cut) && (ia_params->dpd_pref3 > 0.0))) {
+    return f;
+  }
+
+  auto const noise_pair = (ia_params->dpd_pref2 > 0.0) ? dpd_noise(p1, p2)
+                                                       : Utils::Vector4d{};
+
   if ((dist < ia_params->dpd_r_cut) && (ia_params->dpd_pref1 > 0.0)) {
     auto const omega =
         weight(ia_params->dpd_wf, ia_params->dpd_r_cut, dist_inv);
@@ -141,7 +183,7 @@ Utils::Vector3d dpd_pair_force(Particle const *p1, Particle const *p2,
     // random force prefactor
     double noise;
     if (ia_params->dpd_pref2 > 0.0) {
-      noise = ia_params->dpd_pref2 * omega * (d_random() - 0.5);
+      noise = ia_params->dpd_pref2 * omega * noise_pair[3];
     } else {
       noise = 0.0;
     }
@@ -162,7 +204,7 @@ Utils::Vector3d dpd_pair_force(Particle const *p1, Particle const *p2,
     for (int i = 0; i < 3; i++) {
       // noise vector
       if (ia_params->dpd_pref2 > 0.0) {
-        noise_vec[i] = d_random() - 0.5;
+        noise_vec[i] = noise_pair[i];
       } else {
         noise_vec[i] = 0.0;
       }
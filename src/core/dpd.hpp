@@ -34,6 +34,20 @@
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "particle_data.hpp"
 
+#include <utils/Counter.hpp>
+
+#include <cstdint>
+#include <memory>
+
+/** Philox counter of the DPD noise, the noise of a pair is keyed on
+ *  the ids of the particles, so it does not depend on the order
+ *  in which the pairs are visited. */
+extern std::unique_ptr<Utils::Counter<uint64_t>> dpd_rng_counter;
+
+bool dpd_is_seed_required();
+void dpd_set_rng_state(uint64_t counter);
+uint64_t dpd_get_rng_state();
+
 void dpd_heat_up();
 void dpd_cool_down();
 void dpd_switch_off();
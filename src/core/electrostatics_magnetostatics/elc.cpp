@@ -30,8 +30,10 @@
 #include "mmm-common.hpp"
 #include "particle_data.hpp"
 #include "pressure.hpp"
+#include <algorithm>
 #include <cmath>
 #include <mpi.h>
+#include <vector>
 
 #include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/elc.hpp"
@@ -87,10 +89,29 @@ ELC_struct elc_params = {1e100, 10, 1, 0, 1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0.0};
 /** number of local particles, equals the size of \ref elc::partblk. */
 static int n_localpart = 0;
 
-/** temporary buffers for product decomposition */
+/** temporary buffers for product decomposition of the current mode */
 static double *partblk = nullptr;
-/** collected data from the other cells */
-static double gblcblk[8];
+/** collected data from the other cells for the current mode */
+static double *gblcblk = nullptr;
+
+/** \name storage for a batch of Fourier modes
+ *  Each mode occupies a contiguous slot of 8 * @ref n_localpart entries in
+ *  @ref partblk_batch and 8 entries in @ref gblcblk_batch, so that the sums
+ *  of all modes in a batch are reduced by a single collective.
+ */
+/*@{*/
+static std::vector<double> partblk_batch;
+static std::vector<double> gblcblk_batch(8);
+/*@}*/
+
+/** Upper bound on the size of @ref partblk_batch in doubles */
+#define MAX_BATCH_SIZE (1 << 21)
+
+/** A single Fourier mode of the far formula */
+struct FarMode {
+  int p, q;
+  double omega;
+};
 
 /** structure for storing of sin and cos values */
 typedef struct {
@@ -117,6 +138,7 @@ static void prepare_scy_cache();
 /** \name common code */
 /*@{*/
 static void distribute(int size);
+static void select_mode_slot(int slot);
 /*@}*/
 /** \name p=0 per frequency code */
 /*@{*/
@@ -156,38 +178,36 @@ void ELC_setup_constants() {
 
 /* SC Cache */
 /************/
-static void prepare_scx_cache() {
-  int freq;
-  double arg;
-
-  for (freq = 1; freq <= n_scxcache; freq++) {
-    double pref = C_2PI * ux * freq;
-    int o = (freq - 1) * n_localpart;
-    int ic = 0;
-    for (auto const &part : local_cells.particles()) {
-      arg = pref * part.r.p[0];
-      scxcache[o + ic].s = sin(arg);
-      scxcache[o + ic].c = cos(arg);
-      ic++;
+/** Fill the sin/cos cache of all frequencies. Only the base frequency is
+ *  evaluated explicitly, higher frequencies follow from the angle addition
+ *  theorem.
+ */
+static void prepare_sc_cache(SCCache *sccache, double u, int n_sccache,
+                             int dir) {
+  if (n_sccache < 1)
+    return;
+
+  double pref = C_2PI * u;
+  int ic = 0;
+  for (auto const &part : local_cells.particles()) {
+    double arg = pref * part.r.p[dir];
+    SCCache const base = {sin(arg), cos(arg)};
+    SCCache cur = base;
+    sccache[ic] = cur;
+    for (int freq = 2; freq <= n_sccache; freq++) {
+      cur = {cur.s * base.c + cur.c * base.s, cur.c * base.c - cur.s * base.s};
+      sccache[(freq - 1) * n_localpart + ic] = cur;
     }
+    ic++;
   }
 }
 
+static void prepare_scx_cache() {
+  prepare_sc_cache(scxcache, ux, n_scxcache, 0);
+}
+
 static void prepare_scy_cache() {
-  int freq;
-  double arg;
-
-  for (freq = 1; freq <= n_scycache; freq++) {
-    double pref = C_2PI * uy * freq;
-    int o = (freq - 1) * n_localpart;
-    int ic = 0;
-    for (auto const &part : local_cells.particles()) {
-      arg = pref * part.r.p[1];
-      scycache[o + ic].s = sin(arg);
-      scycache[o + ic].c = cos(arg);
-      ic++;
-    }
-  }
+  prepare_sc_cache(scycache, uy, n_scycache, 1);
 }
 
 /*****************************************************************/
@@ -231,9 +251,14 @@ inline double *block(double *p, int index, int size) {
 }
 
 void distribute(int size) {
-  double send_buf[8];
-  copy_vec(send_buf, gblcblk, size);
-  MPI_Allreduce(send_buf, gblcblk, size, MPI_DOUBLE, MPI_SUM, comm_cart);
+  MPI_Allreduce(MPI_IN_PLACE, gblcblk, size, MPI_DOUBLE, MPI_SUM, comm_cart);
+}
+
+/** point @ref partblk and @ref gblcblk to the storage of a mode in the
+ *  current batch */
+void select_mode_slot(int slot) {
+  partblk = partblk_batch.data() + 8 * n_localpart * slot;
+  gblcblk = gblcblk_batch.data() + 8 * slot;
 }
 
 #ifdef CHECKPOINTS
@@ -1038,10 +1063,87 @@ static double PQ_energy(double omega) {
 /* main loops */
 /*****************************************************************/
 
-void ELC_add_force() {
+/** All Fourier modes of the far formula, in the order P, Q, PQ.
+ *  The second condition on p and q is just for the case of numerical
+ *  accident.
+ */
+static std::vector<FarMode> far_modes() {
+  std::vector<FarMode> modes;
   int p, q;
-  double omega;
 
+  for (p = 1; ux * (p - 1) < elc_params.far_cut && p <= n_scxcache; p++)
+    modes.push_back({p, 0, C_2PI * ux * p});
+
+  for (q = 1; uy * (q - 1) < elc_params.far_cut && q <= n_scycache; q++)
+    modes.push_back({0, q, C_2PI * uy * q});
+
+  for (p = 1; ux * (p - 1) < elc_params.far_cut && p <= n_scxcache; p++) {
+    for (q = 1; Utils::sqr(ux * (p - 1)) + Utils::sqr(uy * (q - 1)) <
+                    elc_params.far_cut2 &&
+                q <= n_scycache;
+         q++) {
+      modes.push_back(
+          {p, q, C_2PI * sqrt(Utils::sqr(ux * p) + Utils::sqr(uy * q))});
+    }
+  }
+
+  return modes;
+}
+
+/** Sum the far formula over all modes. The modes are processed in batches,
+ *  which are set up first, then reduced by a single collective, and finally
+ *  applied to the particles. Unless the number of local particles is very
+ *  large, all modes fit into one batch.
+ *
+ *  @param apply   contribution of a mode from the reduced sums
+ *  @return sum of the return values of @p apply
+ */
+template <typename Apply> static double sum_far_modes(Apply apply) {
+  auto const modes = far_modes();
+  if (modes.empty())
+    return 0.;
+
+  int const local_batch_size =
+      std::max(1, std::min(static_cast<int>(modes.size()),
+                           MAX_BATCH_SIZE / std::max(1, 8 * n_localpart)));
+  /* all nodes have to agree on the batches of the collective */
+  int batch_size;
+  MPI_Allreduce(&local_batch_size, &batch_size, 1, MPI_INT, MPI_MIN,
+                comm_cart);
+
+  partblk_batch.resize(8 * n_localpart * batch_size);
+  gblcblk_batch.resize(8 * batch_size);
+
+  double ret = 0.;
+  for (int start = 0; start < modes.size(); start += batch_size) {
+    int const end = std::min(start + batch_size, static_cast<int>(modes.size()));
+
+    std::fill(gblcblk_batch.begin(), gblcblk_batch.end(), 0.);
+    for (int i = start; i < end; i++) {
+      auto const &mode = modes[i];
+      select_mode_slot(i - start);
+      if (mode.q == 0)
+        setup_P(mode.p, mode.omega);
+      else if (mode.p == 0)
+        setup_Q(mode.q, mode.omega);
+      else
+        setup_PQ(mode.p, mode.q, mode.omega);
+    }
+
+    select_mode_slot(0);
+    distribute(8 * (end - start));
+
+    for (int i = start; i < end; i++) {
+      select_mode_slot(i - start);
+      ret += apply(modes[i]);
+    }
+  }
+
+  select_mode_slot(0);
+  return ret;
+}
+
+void ELC_add_force() {
   prepare_scx_cache();
   prepare_scy_cache();
 
@@ -1055,76 +1157,44 @@ void ELC_add_force() {
 
   clear_log_forces("z_force");
 
-  /* the second condition is just for the case of numerical accident */
-  for (p = 1; ux * (p - 1) < elc_params.far_cut && p <= n_scxcache; p++) {
-    omega = C_2PI * ux * p;
-    setup_P(p, omega);
-    distribute(4);
-    add_P_force();
-    checkpoint("************distri p", p, 0, 2);
-  }
-
-  for (q = 1; uy * (q - 1) < elc_params.far_cut && q <= n_scycache; q++) {
-    omega = C_2PI * uy * q;
-    setup_Q(q, omega);
-    distribute(4);
-    add_Q_force();
-    checkpoint("************distri q", 0, q, 2);
-  }
-
-  for (p = 1; ux * (p - 1) < elc_params.far_cut && p <= n_scxcache; p++) {
-    for (q = 1; Utils::sqr(ux * (p - 1)) + Utils::sqr(uy * (q - 1)) <
-                    elc_params.far_cut2 &&
-                q <= n_scycache;
-         q++) {
-      omega = C_2PI * sqrt(Utils::sqr(ux * p) + Utils::sqr(uy * q));
-      setup_PQ(p, q, omega);
-      distribute(8);
-      add_PQ_force(p, q, omega);
-      checkpoint("************distri pq", p, q, 4);
+  sum_far_modes([](FarMode const &mode) {
+    if (mode.q == 0) {
+      add_P_force();
+      checkpoint("************distri p", mode.p, 0, 2);
+    } else if (mode.p == 0) {
+      add_Q_force();
+      checkpoint("************distri q", 0, mode.q, 2);
+    } else {
+      add_PQ_force(mode.p, mode.q, mode.omega);
+      checkpoint("************distri pq", mode.p, mode.q, 4);
     }
-  }
+    return 0.;
+  });
 
   clear_log_forces("end");
 }
 
 double ELC_energy() {
   double eng;
-  int p, q;
-  double omega;
 
   eng = dipole_energy();
   eng += z_energy();
   prepare_scx_cache();
   prepare_scy_cache();
 
-  /* the second condition is just for the case of numerical accident */
-  for (p = 1; ux * (p - 1) < elc_params.far_cut && p <= n_scxcache; p++) {
-    omega = C_2PI * ux * p;
-    setup_P(p, omega);
-    distribute(4);
-    eng += P_energy(omega);
-    checkpoint("E************distri p", p, 0, 2);
-  }
-  for (q = 1; uy * (q - 1) < elc_params.far_cut && q <= n_scycache; q++) {
-    omega = C_2PI * uy * q;
-    setup_Q(q, omega);
-    distribute(4);
-    eng += Q_energy(omega);
-    checkpoint("E************distri q", 0, q, 2);
-  }
-  for (p = 1; ux * (p - 1) < elc_params.far_cut && p <= n_scxcache; p++) {
-    for (q = 1; Utils::sqr(ux * (p - 1)) + Utils::sqr(uy * (q - 1)) <
-                    elc_params.far_cut2 &&
-                q <= n_scycache;
-         q++) {
-      omega = C_2PI * sqrt(Utils::sqr(ux * p) + Utils::sqr(uy * q));
-      setup_PQ(p, q, omega);
-      distribute(8);
-      eng += PQ_energy(omega);
-      checkpoint("E************distri pq", p, q, 4);
+  eng += sum_far_modes([](FarMode const &mode) {
+    if (mode.q == 0) {
+      checkpoint("E************distri p", mode.p, 0, 2);
+      return P_energy(mode.omega);
     }
-  }
+    if (mode.p == 0) {
+      checkpoint("E************distri q", 0, mode.q, 2);
+      return Q_energy(mode.omega);
+    }
+    checkpoint("E************distri pq", mode.p, mode.q, 4);
+    return PQ_energy(mode.omega);
+  });
+
   /* we count both i<->j and j<->i, so return just half of it */
   return 0.5 * eng;
 }
@@ -1252,7 +1322,8 @@ void ELC_on_resort_particles() {
   scycache =
       Utils::realloc(scycache, n_scycache * n_localpart * sizeof(SCCache));
 
-  partblk = Utils::realloc(partblk, n_localpart * 8 * sizeof(double));
+  partblk_batch.resize(n_localpart * 8);
+  select_mode_slot(0);
 }
 
 int ELC_set_params(double maxPWerror, double gap_size, double far_cut,
@@ -33,6 +33,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <vector>
 
 #include "electrostatics_magnetostatics/p3m_gpu.hpp"
 
@@ -76,6 +78,137 @@ inline void add_non_bonded_pair_force_iccp3m(Particle *p1, Particle *p2,
   p2->f.f -= force;
 }
 
+namespace {
+bool is_icc_particle(Particle const &p) {
+  return p.p.identity < iccp3m_cfg.n_ic + iccp3m_cfg.first_id &&
+         p.p.identity >= iccp3m_cfg.first_id;
+}
+
+double dot(std::vector<double> const &a, std::vector<double> const &b) {
+  double res = 0.;
+  for (std::size_t i = 0; i < a.size(); i++)
+    res += a[i] * b[i];
+  return res;
+}
+
+/** Anderson mixing for the ICC fixed-point iteration.
+ *
+ *  The plain iteration updates the charge densities as
+ *  h' = h + beta r with the residual r = G(h) - h. Anderson mixing
+ *  additionally uses the differences of the last iterates and residuals
+ *  to minimize the linearized residual, and updates
+ *  h' = h + beta r - (dH + beta dR) gamma, where gamma is the least-squares
+ *  solution of dR gamma = r. The vectors are stored per local ICC particle,
+ *  in the order of the local cell iteration, which does not change during
+ *  a relaxation. The small normal equations are reduced over all nodes, so
+ *  that every node computes the same gamma.
+ */
+class AndersonMixing {
+public:
+  explicit AndersonMixing(int depth) : m_depth(depth) {}
+
+  /** @brief Correction to subtract from the relaxed update.
+   *
+   *  Has to be called on all nodes in every iteration.
+   */
+  std::vector<double> correction(std::vector<double> const &h,
+                                 std::vector<double> const &r, double beta) {
+    std::vector<double> c(h.size(), 0.);
+    if (m_depth <= 0)
+      return c;
+
+    if (m_iteration++ > 0) {
+      m_dH.emplace_back(h.size());
+      m_dR.emplace_back(h.size());
+      for (std::size_t i = 0; i < h.size(); i++) {
+        m_dH.back()[i] = h[i] - m_h_prev[i];
+        m_dR.back()[i] = r[i] - m_r_prev[i];
+      }
+      if (m_dH.size() > static_cast<std::size_t>(m_depth)) {
+        m_dH.pop_front();
+        m_dR.pop_front();
+      }
+    }
+    m_h_prev = h;
+    m_r_prev = r;
+
+    auto const m = m_dR.size();
+    if (m == 0)
+      return c;
+
+    /* Normal equations dR^T dR gamma = dR^T r, stored as [A | b] */
+    std::vector<double> sys(m * (m + 1));
+    for (std::size_t a = 0; a < m; a++) {
+      for (std::size_t b = 0; b <= a; b++) {
+        sys[a * (m + 1) + b] = sys[b * (m + 1) + a] = dot(m_dR[a], m_dR[b]);
+      }
+      sys[a * (m + 1) + m] = dot(m_dR[a], r);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, sys.data(), static_cast<int>(sys.size()),
+                  MPI_DOUBLE, MPI_SUM, comm_cart);
+
+    auto const gamma = solve(sys, m);
+    for (std::size_t a = 0; a < m; a++) {
+      for (std::size_t i = 0; i < c.size(); i++) {
+        c[i] += gamma[a] * (m_dH[a][i] + beta * m_dR[a][i]);
+      }
+    }
+
+    return c;
+  }
+
+private:
+  /** Gaussian elimination with partial pivoting on the (slightly
+   *  regularized) normal equations. Returns zero if the history is
+   *  degenerate, which falls back to the plain relaxation.
+   */
+  static std::vector<double> solve(std::vector<double> sys, std::size_t m) {
+    auto const w = m + 1;
+    std::vector<double> x(m, 0.);
+
+    double diag_max = 0.;
+    for (std::size_t a = 0; a < m; a++)
+      diag_max = std::max(diag_max, sys[a * w + a]);
+    if (diag_max <= 0.)
+      return x;
+    for (std::size_t a = 0; a < m; a++)
+      sys[a * w + a] += 1e-10 * diag_max;
+
+    for (std::size_t k = 0; k < m; k++) {
+      auto piv = k;
+      for (std::size_t a = k + 1; a < m; a++)
+        if (std::abs(sys[a * w + k]) > std::abs(sys[piv * w + k]))
+          piv = a;
+      if (sys[piv * w + k] == 0.)
+        return std::vector<double>(m, 0.);
+      if (piv != k)
+        for (std::size_t b = 0; b < w; b++)
+          std::swap(sys[k * w + b], sys[piv * w + b]);
+      for (std::size_t a = k + 1; a < m; a++) {
+        auto const f = sys[a * w + k] / sys[k * w + k];
+        for (std::size_t b = k; b < w; b++)
+          sys[a * w + b] -= f * sys[k * w + b];
+      }
+    }
+    for (std::size_t k = m; k-- > 0;) {
+      auto v = sys[k * w + m];
+      for (std::size_t b = k + 1; b < m; b++)
+        v -= sys[k * w + b] * x[b];
+      x[k] = v / sys[k * w + k];
+    }
+
+    return x;
+  }
+
+  int m_depth;
+  int m_iteration = 0;
+  std::vector<double> m_h_prev;
+  std::vector<double> m_r_prev;
+  std::deque<std::vector<double>> m_dH;
+  std::deque<std::vector<double>> m_dR;
+};
+} // namespace
+
 void iccp3m_alloc_lists() {
   auto const n_ic = iccp3m_cfg.n_ic;
 
@@ -101,6 +234,13 @@ int iccp3m_iteration() {
 
   double globalmax = 1e100;
 
+  /* The induced charges of the previous call are the starting point of the
+   * relaxation, so consecutive MD steps are warm-started. */
+  AndersonMixing mixing(iccp3m_cfg.anderson_depth);
+  std::vector<Particle *> icc_particles;
+  std::vector<double> h;
+  std::vector<double> r;
+
   for (int j = 0; j < iccp3m_cfg.num_iteration; j++) {
     double hmax = 0.;
 
@@ -108,11 +248,12 @@ int iccp3m_iteration() {
                             source source interaction*/
     ghost_communicator(&cell_structure.collect_ghost_force_comm);
 
-    double diff = 0;
+    icc_particles.clear();
+    h.clear();
+    r.clear();
 
     for (auto &p : local_cells.particles()) {
-      if (p.p.identity < iccp3m_cfg.n_ic + iccp3m_cfg.first_id &&
-          p.p.identity >= iccp3m_cfg.first_id) {
+      if (is_icc_particle(p)) {
         auto const id = p.p.identity - iccp3m_cfg.first_id;
         /* the dielectric-related prefactor: */
         auto const del_eps = (iccp3m_cfg.ein[id] - iccp3m_cfg.eout) /
@@ -138,34 +279,47 @@ int iccp3m_iteration() {
                                   (iccp3m_cfg.eout + iccp3m_cfg.ein[id]) *
                                   (iccp3m_cfg.sigma[id])
                             : 0.;
-        /* relative variation: never use an estimator which can be negative
-         * here */
-        auto const hnew =
-            (1. - iccp3m_cfg.relax) * hold + (iccp3m_cfg.relax) * (f1 + f2);
-
-        /* Take the largest error to check for convergence */
-        auto const relative_difference =
-            std::abs(1 * (hnew - hold) / (hmax + std::abs(hnew + hold)));
 
-        diff = std::max(diff, relative_difference);
+        icc_particles.push_back(&p);
+        h.push_back(hold);
+        r.push_back(f1 + f2 - hold);
+      }
+    } /* cell particles */
 
-        p.p.q = hnew * iccp3m_cfg.areas[id];
+    auto const correction = mixing.correction(h, r, iccp3m_cfg.relax);
 
-        /* check if the charge now is more than 1e6, to determine if ICC still
-         * leads to reasonable results */
-        /* this is kind a arbitrary measure but, does a good job spotting
-         * divergence !*/
-        if (std::abs(p.p.q) > 1e6) {
-          runtimeErrorMsg()
-              << "too big charge assignment in iccp3m! q >1e6 , assigned "
-                 "charge= "
-              << p.p.q;
+    double diff = 0;
 
-          diff = 1e90; /* A very high value is used as error code */
-          break;
-        }
+    for (std::size_t i = 0; i < icc_particles.size(); i++) {
+      auto &p = *icc_particles[i];
+      auto const id = p.p.identity - iccp3m_cfg.first_id;
+      auto const hold = h[i];
+      /* relative variation: never use an estimator which can be negative
+       * here */
+      auto const hnew = hold + iccp3m_cfg.relax * r[i] - correction[i];
+
+      /* Take the largest error to check for convergence */
+      auto const relative_difference =
+          std::abs(1 * (hnew - hold) / (hmax + std::abs(hnew + hold)));
+
+      diff = std::max(diff, relative_difference);
+
+      p.p.q = hnew * iccp3m_cfg.areas[id];
+
+      /* check if the charge now is more than 1e6, to determine if ICC still
+       * leads to reasonable results */
+      /* this is kind a arbitrary measure but, does a good job spotting
+       * divergence !*/
+      if (std::abs(p.p.q) > 1e6) {
+        runtimeErrorMsg()
+            << "too big charge assignment in iccp3m! q >1e6 , assigned "
+               "charge= "
+            << p.p.q;
+
+        diff = 1e90; /* A very high value is used as error code */
+        break;
       }
-    } /* cell particles */
+    }
     /* Update charges on ghosts. */
     ghost_communicator(&cell_structure.exchange_ghosts_comm);
 
@@ -191,6 +345,10 @@ void force_calc_iccp3m() {
   init_forces_iccp3m();
 
   short_range_loop(Utils::NoOp{}, [](Particle &p1, Particle &p2, Distance &d) {
+    /* Only the field on the ICC particles is used, so the short range
+     * part of the source-source interaction can be skipped. */
+    if (not(is_icc_particle(p1) or is_icc_particle(p2)))
+      return;
     /* calc non bonded interactions */
     add_non_bonded_pair_force_iccp3m(&(p1), &(p2), d.vec21.data(),
                                      sqrt(d.dist2), d.dist2);
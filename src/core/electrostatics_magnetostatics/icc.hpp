@@ -74,6 +74,7 @@ struct iccp3m_struct {
   double relax = 0.7; /* relaxation parameter for iterative */
   int citeration = 0; /* current number of iterations*/
   int first_id = 0;
+  int anderson_depth = 0; /* Anderson mixing history, 0 for plain relaxation */
 
   template <typename Archive>
   void serialize(Archive &ar, long int /* version */) {
@@ -89,6 +90,7 @@ struct iccp3m_struct {
     ar &sigma;
     ar &ext_field;
     ar &citeration;
+    ar &anderson_depth;
   }
 };
 extern iccp3m_struct iccp3m_cfg; /* global variable with ICCP3M configuration */
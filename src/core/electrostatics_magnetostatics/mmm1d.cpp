@@ -43,6 +43,9 @@ using Utils::strcat_alloc;
 #include <utils/constants.hpp>
 #include <utils/math/sqr.hpp>
 
+#include <algorithm>
+#include <vector>
+
 /** How many trial calculations */
 #define TEST_INTEGRATIONS 1000
 
@@ -53,6 +56,11 @@ using Utils::strcat_alloc;
 /** minimal radius for the far formula in multiples of box_l[2] */
 #define MIN_RAD 0.01
 
+/** Initial number of grid points per dimension of the image sum tables */
+#define TABLE_MIN_POINTS 16
+/** Maximal number of grid points per dimension of the image sum tables */
+#define TABLE_MAX_POINTS 512
+
 /** if you define this, the Besselfunctions are calculated up
     to machine precision, otherwise 10^-14, which should be
     definitely enough for daily life. */
@@ -68,11 +76,216 @@ using Utils::strcat_alloc;
 static double uz, L2, uz2, prefuz2, prefL3_i;
 /*@}*/
 
-MMM1D_struct mmm1d_params = {0.05, 1e-5, 0};
+MMM1D_struct mmm1d_params = {0.05, 1e-5, 0, false};
 /** From which distance a certain Bessel cutoff is valid. Can't be part of the
     params since these get broadcasted. */
 static double *bessel_radii;
 
+/** Polygamma series of the near formula.
+ *  @param[in]  rxy2_d  squared xy-distance in units of box_l[2]
+ *  @param[in]  z_d     z-distance in units of box_l[2]
+ *  @param[out] sr      radial sum
+ *  @param[out] sz      axial sum
+ */
+static void near_image_sums(double rxy2_d, double z_d, double &sr,
+                            double &sz) {
+  sr = 0;
+  sz = mod_psi_odd(0, z_d);
+
+  double r2nm1 = 1.0;
+  for (int n = 1; n < n_modPsi; n++) {
+    double deriv = 2 * n;
+    double mpe = mod_psi_even(n, z_d);
+    double mpo = mod_psi_odd(n, z_d);
+    double r2n = r2nm1 * rxy2_d;
+
+    sz += r2n * mpo;
+    sr += deriv * r2nm1 * mpe;
+
+    if (fabs(deriv * r2nm1 * mpe) < mmm1d_params.maxPWerror)
+      break;
+
+    r2nm1 = r2n;
+  }
+}
+
+/** Bessel series of the far formula, without the prefactors.
+ *  @param[in]  rxy     xy-distance
+ *  @param[in]  z_d     z-distance in units of box_l[2]
+ *  @param[out] sr      radial sum
+ *  @param[out] sz      axial sum
+ *  @param[in]  rxy_cut xy-distance which determines the Bessel cutoff
+ */
+static void far_image_sums(double rxy, double z_d, double &sr, double &sz,
+                           double rxy_cut) {
+  double rxy_d = rxy * uz;
+  sr = 0;
+  sz = 0;
+
+  for (int bp = 1; bp < MAXIMAL_B_CUT; bp++) {
+    if (bessel_radii[bp - 1] < rxy_cut)
+      break;
+
+    double fq = C_2PI * bp, k0, k1;
+#ifdef BESSEL_MACHINE_PREC
+    k0 = K0(fq * rxy_d);
+    k1 = K1(fq * rxy_d);
+#else
+    LPK01(fq * rxy_d, &k0, &k1);
+#endif
+    sr += bp * k1 * cos(fq * z_d);
+    sz += bp * k0 * sin(fq * z_d);
+  }
+}
+
+namespace {
+/** Radial and axial image sums tabulated on a uniform grid in (x, |z_d|),
+ *  where x is the radial argument of the respective series. The radial
+ *  sum is even and the axial sum is odd in z_d, so only 0 <= z_d <= 0.5
+ *  is stored. Values are interpolated by tensor-product cubic Lagrange
+ *  polynomials on a fixed 4x4 stencil, which is free of data-dependent
+ *  branches and therefore vectorizes well.
+ */
+class ImageSumTable {
+  double m_x_min = 0., m_x_max = 0.;
+  double m_inv_hx = 0., m_inv_hz = 0.;
+  int m_nx = 0, m_nz = 0;
+  /** Interleaved (sr, sz) pairs, row-major in x. */
+  std::vector<double> m_data;
+
+  /** Stencil start index and the four Lagrange weights at @p s. */
+  static int weights(double s, int n, double w[4]) {
+    auto const i = std::min(std::max(static_cast<int>(s) - 1, 0), n - 4);
+    auto const t = s - i;
+    auto const t1 = t - 1., t2 = t - 2., t3 = t - 3.;
+    w[0] = -t1 * t2 * t3 / 6.;
+    w[1] = t * t2 * t3 / 2.;
+    w[2] = -t * t1 * t3 / 2.;
+    w[3] = t * t1 * t2 / 6.;
+    return i;
+  }
+
+public:
+  bool empty() const { return m_data.empty(); }
+  void clear() {
+    m_data.clear();
+    m_data.shrink_to_fit();
+  }
+  double x_min() const { return m_x_min; }
+  double x_max() const { return m_x_max; }
+
+  /** Sample @p series on a grid of @p nx x @p nz points. */
+  template <typename Series>
+  void fill(double x_min, double x_max, int nx, int nz, Series series) {
+    m_x_min = x_min;
+    m_x_max = x_max;
+    m_nx = nx;
+    m_nz = nz;
+    m_inv_hx = (nx - 1) / (x_max - x_min);
+    m_inv_hz = 2. * (nz - 1);
+    m_data.resize(2 * nx * nz);
+
+    for (int i = 0; i < nx; i++) {
+      auto const x = x_min + i / m_inv_hx;
+      for (int j = 0; j < nz; j++) {
+        auto const idx = 2 * (i * nz + j);
+        series(x, j / m_inv_hz, m_data[idx], m_data[idx + 1]);
+      }
+    }
+  }
+
+  /** Interpolate the image sums, @p x must lie within the tabulated range. */
+  void operator()(double x, double z_d, double &sr, double &sz) const {
+    double wx[4], wz[4];
+    auto const ix = weights((x - m_x_min) * m_inv_hx, m_nx, wx);
+    auto const iz = weights(fabs(z_d) * m_inv_hz, m_nz, wz);
+
+    double r = 0., a = 0.;
+    for (int i = 0; i < 4; i++) {
+      auto const row = m_data.data() + 2 * ((ix + i) * m_nz + iz);
+      double rr = 0., ra = 0.;
+      for (int j = 0; j < 4; j++) {
+        rr += wz[j] * row[2 * j];
+        ra += wz[j] * row[2 * j + 1];
+      }
+      r += wx[i] * rr;
+      a += wx[i] * ra;
+    }
+    sr = r;
+    sz = (z_d < 0) ? -a : a;
+  }
+
+  /** Largest deviation from @p series at the centers of all grid cells. */
+  template <typename Series> double max_error(Series series) const {
+    double err = 0.;
+    for (int i = 0; i < m_nx - 1; i++) {
+      auto const x = m_x_min + (i + 0.5) / m_inv_hx;
+      for (int j = 0; j < m_nz - 1; j++) {
+        auto const z_d = (j + 0.5) / m_inv_hz;
+        double sr, sz, sr_tab, sz_tab;
+        series(x, z_d, sr, sz);
+        (*this)(x, z_d, sr_tab, sz_tab);
+        err = std::max(err, std::max(fabs(sr - sr_tab), fabs(sz - sz_tab)));
+      }
+    }
+    return err;
+  }
+};
+
+/** Image sums of the near formula as a function of (rxy2_d, z_d). */
+ImageSumTable near_table;
+/** Image sums of the far formula as a function of (rxy, z_d). */
+ImageSumTable far_table;
+} // namespace
+
+/** Tabulate @p series on [@p x_min, @p x_max], refining the grid until the
+ *  interpolation error drops below @ref MMM1D_struct::maxPWerror.
+ *  @return whether the requested accuracy was reached.
+ */
+template <typename Series>
+static bool build_image_sum_table(ImageSumTable &table, double x_min,
+                                  double x_max, Series series) {
+  for (int n = TABLE_MIN_POINTS; n <= TABLE_MAX_POINTS; n *= 2) {
+    table.fill(x_min, x_max, n, n, series);
+    if (table.max_error(series) < mmm1d_params.maxPWerror)
+      return true;
+  }
+  table.clear();
+  return false;
+}
+
+static void prepare_image_sum_tables() {
+  near_table.clear();
+  far_table.clear();
+
+  if (!mmm1d_params.tabulate || mmm1d_params.far_switch_radius_2 <= 0)
+    return;
+
+  auto const near_ok = build_image_sum_table(
+      near_table, 0., mmm1d_params.far_switch_radius_2 * uz2, near_image_sums);
+
+  /* beyond the first Bessel radius, the far formula has no series terms.
+     Inside, the table uses the Bessel cutoff of the smallest radius, so
+     that the tabulated function is smooth. */
+  auto const rxy_min = sqrt(mmm1d_params.far_switch_radius_2);
+  auto const far_ok =
+      (bessel_radii[0] <= rxy_min) ||
+      build_image_sum_table(
+          far_table, rxy_min, bessel_radii[0],
+          [rxy_min](double rxy, double z_d, double &sr, double &sz) {
+            far_image_sums(rxy, z_d, sr, sz, rxy_min);
+          });
+
+  if (!near_ok || !far_ok) {
+    near_table.clear();
+    far_table.clear();
+    runtimeWarningMsg() << "MMM1D: could not tabulate the image sums to "
+                           "maxPWerror, falling back to the series";
+  }
+}
+
+bool MMM1D_is_tabulated() { return !near_table.empty(); }
+
 static double far_error(int P, double minrad) {
   // this uses an upper bound to all force components and the potential
   double rhores = 2 * M_PI * uz * minrad;
@@ -137,10 +350,11 @@ static void prepare_polygamma_series(double maxPWerror, double maxrad2) {
   } while (err > 0.1 * maxPWerror);
 }
 
-int MMM1D_set_params(double switch_rad, double maxPWerror) {
+int MMM1D_set_params(double switch_rad, double maxPWerror, bool tabulate) {
   mmm1d_params.far_switch_radius_2 =
       (switch_rad > 0) ? Utils::sqr(switch_rad) : -1;
   mmm1d_params.maxPWerror = maxPWerror;
+  mmm1d_params.tabulate = tabulate;
   coulomb.method = COULOMB_MMM1D;
 
   mpi_bcast_coulomb_params();
@@ -178,6 +392,7 @@ void MMM1D_init() {
   determine_bessel_radii(mmm1d_params.maxPWerror, MAXIMAL_B_CUT);
   prepare_polygamma_series(mmm1d_params.maxPWerror,
                            mmm1d_params.far_switch_radius_2);
+  prepare_image_sum_tables();
 }
 
 void add_mmm1d_coulomb_pair_force(double chpref, const double d[3], double r,
@@ -194,29 +409,13 @@ void add_mmm1d_coulomb_pair_force(double chpref, const double d[3], double r,
 
   if (rxy2 <= mmm1d_params.far_switch_radius_2) {
     /* near range formula */
-    double sr, sz, r2nm1, rt, rt2, shift_z;
-    int n;
+    double sr, sz, rt, rt2, shift_z;
 
     /* polygamma summation */
-    sr = 0;
-    sz = mod_psi_odd(0, z_d);
-
-    r2nm1 = 1.0;
-    for (n = 1; n < n_modPsi; n++) {
-      double deriv = 2 * n;
-      double mpe = mod_psi_even(n, z_d);
-      double mpo = mod_psi_odd(n, z_d);
-      double r2n = r2nm1 * rxy2_d;
-
-      sz += r2n * mpo;
-      sr += deriv * r2nm1 * mpe;
-
-      if (fabs(deriv * r2nm1 * mpe) < mmm1d_params.maxPWerror)
-        break;
-
-      r2nm1 = r2n;
-    }
-    // fprintf(stderr, "max_n %d\n", n);
+    if (near_table.empty())
+      near_image_sums(rxy2_d, z_d, sr, sz);
+    else
+      near_table(rxy2_d, z_d, sr, sz);
 
     Fx = prefL3_i * sr * d[0];
     Fy = prefL3_i * sr * d[1];
@@ -251,24 +450,13 @@ void add_mmm1d_coulomb_pair_force(double chpref, const double d[3], double r,
   } else {
     /* far range formula */
     double rxy = sqrt(rxy2);
-    double rxy_d = rxy * uz;
     double sr = 0, sz = 0;
-    int bp;
 
-    for (bp = 1; bp < MAXIMAL_B_CUT; bp++) {
-      if (bessel_radii[bp - 1] < rxy)
-        break;
+    if (far_table.empty())
+      far_image_sums(rxy, z_d, sr, sz, rxy);
+    else if (rxy < far_table.x_max())
+      far_table(rxy, z_d, sr, sz);
 
-      double fq = C_2PI * bp, k0, k1;
-#ifdef BESSEL_MACHINE_PREC
-      k0 = K0(fq * rxy_d);
-      k1 = K1(fq * rxy_d);
-#else
-      LPK01(fq * rxy_d, &k0, &k1);
-#endif
-      sr += bp * k1 * cos(fq * z_d);
-      sz += bp * k0 * sin(fq * z_d);
-    }
     sr *= uz2 * 4 * C_2PI;
     sz *= uz2 * 4 * C_2PI;
 
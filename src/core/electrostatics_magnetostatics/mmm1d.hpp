@@ -45,6 +45,12 @@ typedef struct {
   double maxPWerror;
   /** cutoff of the Bessel sum. Only used by the GPU implementation */
   int bessel_cutoff;
+  /** whether to replace the polygamma and Bessel series by tabulated
+   *  image sums, which are built in @ref MMM1D_init to an accuracy of
+   *  @ref maxPWerror. Falls back to the series if this accuracy cannot
+   *  be reached with a table of reasonable size.
+   */
+  bool tabulate;
 } MMM1D_struct;
 extern MMM1D_struct mmm1d_params;
 
@@ -55,8 +61,10 @@ extern MMM1D_struct mmm1d_params;
  *  @param switch_rad at which xy-distance the calculation switches from the far
  *      to the near formula. If -1, this parameter will be tuned automatically.
  *  @param maxPWerror @copydoc MMM1D_struct::maxPWerror
+ *  @param tabulate @copybrief MMM1D_struct::tabulate
  */
-int MMM1D_set_params(double switch_rad, double maxPWerror);
+int MMM1D_set_params(double switch_rad, double maxPWerror,
+                     bool tabulate = false);
 
 /// check that MMM1D can run with the current parameters
 int MMM1D_sanity_checks();
@@ -64,6 +72,12 @@ int MMM1D_sanity_checks();
 /// initialize the MMM1D constants
 void MMM1D_init();
 
+/** Whether the image sums are currently interpolated from tables, i.e.
+ *  @ref MMM1D_struct::tabulate is set and the tables reached the requested
+ *  accuracy in the last call to @ref MMM1D_init.
+ */
+bool MMM1D_is_tabulated();
+
 void add_mmm1d_coulomb_pair_force(double chpref, const double d[3], double r,
                                   double force[3]);
 
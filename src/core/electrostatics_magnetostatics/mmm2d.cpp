@@ -43,6 +43,7 @@
 #include <cmath>
 #include <mpi.h>
 #include <numeric>
+#include <vector>
 
 char const *mmm2d_errors[] = {
     "ok",
@@ -301,22 +302,31 @@ void MMM2D_setup_constants() {
 
 static SCCache sc(double arg) { return {sin(arg), cos(arg)}; }
 
+/** Fill the sin/cos cache of all frequencies. Only the base frequency is
+ *  evaluated explicitly, higher frequencies follow from the angle addition
+ *  theorem.
+ */
 template <size_t dir>
 static void prepare_sc_cache(std::vector<SCCache> &sccache, double u,
                              int n_sccache) {
-  for (int freq = 1; freq <= n_sccache; freq++) {
-    auto const pref = C_2PI * u * freq;
-    auto const o = (freq - 1) * n_localpart;
-
-    int ic = 0;
-    for (int c = 1; c <= n_layers; c++) {
-      auto const np = cells[c].n;
-      auto part = cells[c].part;
-      for (int i = 0; i < np; i++) {
-        auto const arg = pref * part[i].r.p[dir];
-        sccache[o + ic] = sc(arg);
-        ic++;
+  if (n_sccache < 1)
+    return;
+
+  auto const pref = C_2PI * u;
+
+  int ic = 0;
+  for (int c = 1; c <= n_layers; c++) {
+    auto const np = cells[c].n;
+    auto part = cells[c].part;
+    for (int i = 0; i < np; i++) {
+      auto const base = sc(pref * part[i].r.p[dir]);
+      auto cur = base;
+      sccache[ic] = cur;
+      for (int freq = 2; freq <= n_sccache; freq++) {
+        cur = {cur.s * base.c + cur.c * base.s, cur.c * base.c - cur.s * base.s};
+        sccache[(freq - 1) * n_localpart + ic] = cur;
       }
+      ic++;
     }
   }
 }
@@ -422,60 +432,86 @@ void gather_image_contributions(int e_size) {
     copy_vec(abventry(gblcblk, n_layers - 1, e_size), recvbuf + e_size, e_size);
 }
 
-/* the data transfer routine for the lclcblks itself */
+/* the data transfer routine for the lclcblks itself.
+   The sums over the layers below (above) a node follow a linear recursion,
+   which damps by fac per layer. Instead of passing the partial sums from
+   node to node, every node therefore contributes the damped sum over its own
+   layers and its boundary layers to a single collective, from which all
+   nodes evaluate the recursion across the nodes below (above) themselves.
+   Also builds up the gblcblk. */
 void distribute(int e_size, double fac) {
-  int c, node, inv_node;
-  double sendbuf[8];
-  double recvbuf[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  MPI_Status status;
-
-  /* send/recv to/from other nodes. Also builds up the gblcblk. */
-  for (node = 0; node < n_nodes; node++) {
-    inv_node = n_nodes - node - 1;
-    /* up */
-    if (node == this_node) {
-      /* calculate sums of cells below */
-      for (c = 1; c < n_layers; c++)
-        addscale_vec(blwentry(gblcblk, c, e_size), fac,
-                     blwentry(gblcblk, c - 1, e_size),
-                     blwentry(lclcblk, c - 1, e_size), e_size);
-
-      /* calculate my ghost contribution only if a node above exists */
-      if (node + 1 < n_nodes) {
-        addscale_vec(sendbuf, fac, blwentry(gblcblk, n_layers - 1, e_size),
-                     blwentry(lclcblk, n_layers - 1, e_size), e_size);
-        copy_vec(sendbuf + e_size, blwentry(lclcblk, n_layers, e_size), e_size);
-        MPI_Send(sendbuf, 2 * e_size, MPI_DOUBLE, node + 1, 0, comm_cart);
-      }
-    } else if (node + 1 == this_node) {
-      MPI_Recv(recvbuf, 2 * e_size, MPI_DOUBLE, node, 0, comm_cart, &status);
-      copy_vec(blwentry(gblcblk, 0, e_size), recvbuf, e_size);
-      copy_vec(blwentry(lclcblk, 0, e_size), recvbuf + e_size, e_size);
+  static std::vector<double> sendbuf, recvbuf;
+  int c;
+
+  /* damping across all layers of one node */
+  auto const fac_n1 = pow(fac, n_layers - 1);
+  auto const fac_n = fac * fac_n1;
+
+  /* per node: sum below the top layer, top layer, sum above the bottom
+     layer, bottom layer */
+  auto const n_entries = 4 * e_size;
+  sendbuf.assign(n_entries, 0.);
+  recvbuf.resize(n_entries * n_nodes);
+  auto const blw_sum = sendbuf.data();
+  auto const blw_top = blw_sum + e_size;
+  auto const abv_sum = blw_top + e_size;
+  auto const abv_bot = abv_sum + e_size;
+
+  /* the lowest (highest) node also includes its image layers */
+  if (this_node == 0)
+    copy_vec(blw_sum, blwentry(gblcblk, 0, e_size), e_size);
+  for (c = (this_node == 0) ? 0 : 1; c < n_layers; c++)
+    addscale_vec(blw_sum, fac, blw_sum, blwentry(lclcblk, c, e_size), e_size);
+  copy_vec(blw_top, blwentry(lclcblk, n_layers, e_size), e_size);
+
+  if (this_node == n_nodes - 1)
+    copy_vec(abv_sum, abventry(gblcblk, n_layers - 1, e_size), e_size);
+  for (c = (this_node == n_nodes - 1) ? n_layers + 1 : n_layers; c > 1; c--)
+    addscale_vec(abv_sum, fac, abv_sum, abventry(lclcblk, c, e_size), e_size);
+  copy_vec(abv_bot, abventry(lclcblk, 1, e_size), e_size);
+
+  if (n_nodes > 1)
+    MPI_Allgather(sendbuf.data(), n_entries, MPI_DOUBLE, recvbuf.data(),
+                  n_entries, MPI_DOUBLE, comm_cart);
+
+  auto const entry = [&](int node, int index) {
+    return recvbuf.data() + node * n_entries + index * e_size;
+  };
+
+  /* contributions from the nodes below */
+  if (this_node > 0) {
+    auto gbl = blwentry(gblcblk, 0, e_size);
+    copy_vec(gbl, entry(0, 0), e_size);
+    for (int node = 1; node < this_node; node++) {
+      addscale_vec(gbl, fac_n, gbl, entry(node, 0), e_size);
+      addscale_vec(gbl, fac_n1, entry(node - 1, 1), gbl, e_size);
     }
+    copy_vec(blwentry(lclcblk, 0, e_size), entry(this_node - 1, 1), e_size);
+  }
 
-    /* down */
-    if (inv_node == this_node) {
-      /* calculate sums of all cells above */
-      for (c = n_layers + 1; c > 2; c--)
-        addscale_vec(abventry(gblcblk, c - 3, e_size), fac,
-                     abventry(gblcblk, c - 2, e_size),
-                     abventry(lclcblk, c, e_size), e_size);
-
-      /* calculate my ghost contribution only if a node below exists */
-      if (inv_node - 1 >= 0) {
-        addscale_vec(sendbuf, fac, abventry(gblcblk, 0, e_size),
-                     abventry(lclcblk, 2, e_size), e_size);
-        copy_vec(sendbuf + e_size, abventry(lclcblk, 1, e_size), e_size);
-        MPI_Send(sendbuf, 2 * e_size, MPI_DOUBLE, inv_node - 1, 0, comm_cart);
-      }
-    } else if (inv_node - 1 == this_node) {
-      MPI_Recv(recvbuf, 2 * e_size, MPI_DOUBLE, inv_node, 0, comm_cart,
-               &status);
-      copy_vec(abventry(gblcblk, n_layers - 1, e_size), recvbuf, e_size);
-      copy_vec(abventry(lclcblk, n_layers + 1, e_size), recvbuf + e_size,
-               e_size);
+  /* contributions from the nodes above */
+  if (this_node < n_nodes - 1) {
+    auto gbl = abventry(gblcblk, n_layers - 1, e_size);
+    copy_vec(gbl, entry(n_nodes - 1, 2), e_size);
+    for (int node = n_nodes - 2; node > this_node; node--) {
+      addscale_vec(gbl, fac_n, gbl, entry(node, 2), e_size);
+      addscale_vec(gbl, fac_n1, entry(node + 1, 3), gbl, e_size);
     }
+    copy_vec(abventry(lclcblk, n_layers + 1, e_size), entry(this_node + 1, 3),
+             e_size);
   }
+
+  /* calculate sums of cells below */
+  for (c = 1; c < n_layers; c++)
+    addscale_vec(blwentry(gblcblk, c, e_size), fac,
+                 blwentry(gblcblk, c - 1, e_size),
+                 blwentry(lclcblk, c - 1, e_size), e_size);
+
+  /* calculate sums of all cells above */
+  for (c = n_layers + 1; c > 2; c--)
+    addscale_vec(abventry(gblcblk, c - 3, e_size), fac,
+                 abventry(gblcblk, c - 2, e_size), abventry(lclcblk, c, e_size),
+                 e_size);
 }
 
 #ifdef CHECKPOINTS
@@ -180,11 +180,13 @@ typedef struct {
   /** additional points around the charge assignment mesh, for method like
    *  dielectric ELC creating virtual charges. */
   double additional_mesh[3] = {};
+  /** use an interpolation table for the real space part (charges only). */
+  bool tabulate = false;
 
   template <typename Archive> void serialize(Archive &ar, long int) {
     ar &tuning &alpha_L &r_cut_iL &mesh;
     ar &mesh_off &cao &inter &accuracy &epsilon &cao_cut;
-    ar &a &ai &alpha &r_cut &inter2 &cao3 &additional_mesh;
+    ar &a &ai &alpha &r_cut &inter2 &cao3 &additional_mesh &tabulate;
   }
 
 } P3MParameters;
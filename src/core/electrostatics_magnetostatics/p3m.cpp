@@ -51,10 +51,12 @@ using Utils::strcat_alloc;
 #include <utils/constants.hpp>
 #include <utils/math/sqr.hpp>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <mpi.h>
+#include <vector>
 
 /************************************************
  * variables
@@ -198,6 +200,16 @@ static void p3m_calc_influence_function_force();
  */
 static void p3m_calc_influence_function_energy();
 
+/** Build the real space kernel table @ref p3m_data_struct::rs_table
+ *  "rs_table" for the current @ref p3m_parameter_struct::alpha "alpha" and
+ *  @ref p3m_parameter_struct::r_cut "r_cut", if
+ *  @ref p3m_parameter_struct::tabulate "tabulate" is set.
+ *
+ *  The grid is refined until the interpolation error is well below
+ *  the real space error estimate, otherwise the table is not used.
+ */
+static void p3m_init_real_space_table();
+
 /** Calculate the aliasing sums for the optimal influence function.
  *
  *  Calculate the aliasing sums in the nominator and denominator of
@@ -497,6 +509,14 @@ int p3m_set_ninterpol(int n) {
   return ES_OK;
 }
 
+int p3m_set_tabulate(bool tabulate) {
+  p3m.params.tabulate = tabulate;
+
+  mpi_bcast_coulomb_params();
+
+  return ES_OK;
+}
+
 void p3m_interpolate_charge_assignment_function() {
   double dInterpol = 0.5 / (double)p3m.params.inter;
   int i;
@@ -2369,6 +2389,132 @@ void p3m_scaleby_box_l() {
   p3m_sanity_checks_boxl();
   p3m_calc_influence_function_force();
   p3m_calc_influence_function_energy();
+  p3m_init_real_space_table();
+}
+
+namespace {
+/** erf(alpha r)/r as function of r^2, with the series for small r. */
+double erf_part_ri(double alpha, double r2) {
+  auto const x2 = Utils::sqr(alpha) * r2;
+  if (x2 < 1e-2) {
+    double sum = 0.0, term = 1.0;
+    for (int n = 0; n < 8; n++) {
+      sum += term / (2 * n + 1);
+      term *= -x2 / (n + 1);
+    }
+    return 2.0 * alpha * Utils::sqrt_pi_i() * sum;
+  }
+  auto const r = sqrt(r2);
+  return erf(alpha * r) / r;
+}
+
+/** (erf(alpha r)/r - 2 alpha/sqrt(pi) exp(-alpha^2 r^2))/r^2 as function of
+ *  r^2, with the series for small r. */
+double erf_force_part(double alpha, double r2) {
+  auto const x2 = Utils::sqr(alpha) * r2;
+  if (x2 < 1e-2) {
+    double sum = 0.0, term = 1.0;
+    for (int n = 1; n < 9; n++) {
+      sum += term * 2 * n / (2 * n + 1);
+      term *= -x2 / (n + 1);
+    }
+    return 2.0 * Utils::int_pow<3>(alpha) * Utils::sqrt_pi_i() * sum;
+  }
+  return (erf_part_ri(alpha, r2) -
+          2.0 * alpha * Utils::sqrt_pi_i() * exp(-x2)) /
+         r2;
+}
+
+/** Coefficients of the cubic polynomials through four neighboring grid
+ *  points of @p f, in the local coordinate of each of the n intervals.
+ */
+std::vector<double> cubic_coefficients(std::vector<double> const &f) {
+  auto const n = static_cast<int>(f.size()) - 1;
+  std::vector<double> coeffs(4 * n);
+
+  for (int i = 0; i < n; i++) {
+    auto const j0 = std::min(std::max(i - 1, 0), n - 3);
+    double u[4];
+    for (int k = 0; k < 4; k++)
+      u[k] = j0 + k - i;
+
+    auto *c = coeffs.data() + 4 * i;
+    for (int k = 0; k < 4; k++) {
+      /* Lagrange basis polynomial as (t - a)(t - b)(t - c) / denominator */
+      double roots[3], denom = 1.0;
+      for (int m = 0, l = 0; m < 4; m++) {
+        if (m != k) {
+          roots[l++] = u[m];
+          denom *= u[k] - u[m];
+        }
+      }
+      auto const w = f[j0 + k] / denom;
+      c[0] -= w * roots[0] * roots[1] * roots[2];
+      c[1] += w * (roots[0] * roots[1] + roots[1] * roots[2] +
+                   roots[2] * roots[0]);
+      c[2] -= w * (roots[0] + roots[1] + roots[2]);
+      c[3] += w;
+    }
+  }
+
+  return coeffs;
+}
+} // namespace
+
+void p3m_init_real_space_table() {
+  auto &table = p3m.rs_table;
+  table = p3m_real_space_table{};
+
+  if (not p3m.params.tabulate or p3m.params.tuning or p3m.params.r_cut <= 0.0)
+    return;
+
+  auto const alpha = p3m.params.alpha;
+  auto const r_cut = p3m.params.r_cut;
+  auto const r2_max = Utils::sqr(r_cut);
+
+  /* The tabulation errors of the pairs of a particle add up randomly,
+   * similar to the truncation errors of the real space sum. Requiring
+   * the per pair force error times the square root of the number of
+   * neighbors to stay well below the real space error estimate for unit
+   * charges makes the bound independent of the particle number. */
+  auto const n_neighbors_per_density =
+      4.0 / 3.0 * Utils::pi() * Utils::int_pow<3>(r_cut);
+  auto const tolerance =
+      0.1 *
+      p3m_real_space_error(1.0, p3m.params.r_cut_iL, 1, 1.0,
+                           p3m.params.alpha_L) *
+      sqrt(box_l[0] * box_l[1] * box_l[2] / n_neighbors_per_density);
+
+  for (int n = 64; n <= 4096; n *= 2) {
+    auto const dr2 = r2_max / n;
+    std::vector<double> f_force(n + 1), f_energy(n + 1);
+    for (int i = 0; i <= n; i++) {
+      f_force[i] = erf_force_part(alpha, i * dr2);
+      f_energy[i] = erf_part_ri(alpha, i * dr2);
+    }
+
+    table.dr2_i = 1.0 / dr2;
+    table.force = cubic_coefficients(f_force);
+    table.energy = cubic_coefficients(f_energy);
+
+    /* The interpolation error is largest close to the interval centers. */
+    double error = 0.0;
+    for (int i = 0; i < n; i++) {
+      auto const r2 = (i + 0.5) * dr2;
+      error = std::max(
+          error, sqrt(r2) * std::abs(table.force_part(r2) -
+                                     erf_force_part(alpha, r2)));
+      error = std::max(error, std::abs(table.energy_part(r2) -
+                                       erf_part_ri(alpha, r2)));
+    }
+
+    if (error <= tolerance)
+      return;
+  }
+
+  table = p3m_real_space_table{};
+  runtimeWarningMsg() << "P3M: the real space table did not reach the "
+                         "required accuracy, using the direct evaluation.";
 }
 
 void p3m_calc_kspace_stress(double *stress) {
@@ -62,10 +62,49 @@
 #include <utils/constants.hpp>
 #include <utils/math/AS_erfc_part.hpp>
 
+#include <algorithm>
+#include <vector>
+
 /************************************************
  * data types
  ************************************************/
 
+/** Cubic interpolation table for the real space kernels.
+ *
+ *  Only the smooth parts erf(alpha r)/r of the energy and
+ *  (erf(alpha r)/r - 2 alpha/sqrt(pi) exp(-alpha^2 r^2))/r^2 of the force
+ *  are tabulated, the singular parts 1/r and 1/r^3 are evaluated directly.
+ *  Both smooth parts are analytic functions of r^2, so the table uses a
+ *  uniform grid in r^2 and needs neither a square root nor an exponential.
+ *  Every interval stores the four coefficients of its polynomial, which
+ *  makes the evaluation a branch free Horner scheme.
+ */
+struct p3m_real_space_table {
+  /** inverse grid spacing in r^2, zero if no table is present. */
+  double dr2_i = 0.0;
+  /** polynomial coefficients of the force part, 4 per interval. */
+  std::vector<double> force;
+  /** polynomial coefficients of the energy part, 4 per interval. */
+  std::vector<double> energy;
+
+  bool active() const { return dr2_i > 0.0; }
+
+  static double eval(std::vector<double> const &coeffs, double x) {
+    auto const i = std::min(static_cast<int>(x),
+                            static_cast<int>(coeffs.size() / 4) - 1);
+    auto const t = x - i;
+    auto const *c = coeffs.data() + 4 * i;
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+  }
+
+  /** Smooth part of the force factor at squared distance @p dist2. */
+  double force_part(double dist2) const { return eval(force, dist2 * dr2_i); }
+  /** Smooth part of the energy at squared distance @p dist2. */
+  double energy_part(double dist2) const {
+    return eval(energy, dist2 * dr2_i);
+  }
+};
+
 struct p3m_data_struct {
   p3m_data_struct();
 
@@ -124,6 +163,10 @@ struct p3m_data_struct {
   double *recv_grid;
 
   fft_data_struct fft;
+
+  /** real space kernel table, only present if
+   *  @ref p3m_parameter_struct::tabulate "tabulate" is set. */
+  p3m_real_space_table rs_table;
 };
 
 /** P3M parameters. */
@@ -227,6 +270,14 @@ inline void p3m_add_pair_force(double q1q2, double const *d, double dist,
                                double *force) {
   if (dist < p3m.params.r_cut) {
     if (dist > 0.0) {
+      if (p3m.rs_table.active()) {
+        auto const dist2 = dist * dist;
+        auto const fac2 =
+            q1q2 * (1.0 / (dist * dist2) - p3m.rs_table.force_part(dist2));
+        for (int j = 0; j < 3; j++)
+          force[j] += fac2 * d[j];
+        return;
+      }
       double adist = p3m.params.alpha * dist;
 #if USE_ERFC_APPROXIMATION
       auto const erfc_part_ri = Utils::AS_erfc_part(adist) / dist;
@@ -292,9 +343,18 @@ int p3m_set_eps(double eps);
  */
 int p3m_set_ninterpol(int n);
 
+/** Set @ref p3m_parameter_struct::tabulate "tabulate" parameter
+ *
+ *  @param[in]  tabulate     @copybrief p3m_parameter_struct::tabulate
+ */
+int p3m_set_tabulate(bool tabulate);
+
 /** Calculate real space contribution of Coulomb pair energy. */
 inline double p3m_pair_energy(double chgfac, double dist) {
   if (dist < p3m.params.r_cut && dist != 0) {
+    if (p3m.rs_table.active()) {
+      return chgfac * (1.0 / dist - p3m.rs_table.energy_part(dist * dist));
+    }
     double adist = p3m.params.alpha * dist;
 #if USE_ERFC_APPROXIMATION
     double erfc_part_ri = Utils::AS_erfc_part(adist) / dist;
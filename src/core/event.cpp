@@ -25,10 +25,12 @@
  */
 #include "event.hpp"
 
+#include "bonded_interactions/bond_topology.hpp"
 #include "bonded_interactions/thermalized_bond.hpp"
 #include "cells.hpp"
 #include "collision.hpp"
 #include "communication.hpp"
+#include "constraints.hpp"
 #include "cuda_init.hpp"
 #include "cuda_interface.hpp"
 #include "dpd.hpp"
@@ -41,9 +43,12 @@
 #include "grid_based_algorithms/electrokinetics.hpp"
 #include "grid_based_algorithms/lb_boundaries.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
+#include "immersed_boundaries.hpp"
+#include "integrate.hpp"
 #include "metadynamics.hpp"
 #include "npt.hpp"
 #include "nsquare.hpp"
+#include "object-in-fluid/oif_global_forces.hpp"
 #include "partCfg_global.hpp"
 #include "particle_data.hpp"
 #include "pressure.hpp"
@@ -55,6 +60,7 @@
 #include "swimmer_reaction.hpp"
 #include "thermostat.hpp"
 #include "virtual_sites.hpp"
+#include "virtual_sites/VirtualSitesRelative.hpp"
 
 #include <utils/mpi/all_compare.hpp>
 
@@ -166,6 +172,9 @@ void on_integration_start() {
   invalidate_obs();
   partCfg().invalidate();
   invalidate_fetch_cache();
+  /* The shapes and interactions of the constraints can have changed
+   * without notice. */
+  Constraints::constraints.invalidate_cell_constraints();
 
 #ifdef ADDITIONAL_CHECKS
 
@@ -241,6 +250,17 @@ void on_particle_change() {
   EVENT_TRACE(fprintf(stderr, "%d: on_particle_change\n", this_node));
 
   set_resort_particles(Cells::RESORT_LOCAL);
+  invalidate_bond_topology();
+#ifdef OIF_GLOBAL_FORCES
+  invalidate_oif_global_triangles();
+#endif
+#ifdef IMMERSED_BOUNDARY
+  immersed_boundaries.invalidate_triangles();
+#endif
+  invalidate_local_particle_features();
+#ifdef VIRTUAL_SITES_RELATIVE
+  invalidate_vs_relative_bodies();
+#endif
   reinit_electrostatics = 1;
   reinit_magnetostatics = 1;
 
@@ -288,6 +308,13 @@ void on_short_range_ia_change() {
 
   recalc_maximal_cutoff();
   cells_on_geometry_change(0);
+  invalidate_bond_topology();
+#ifdef OIF_GLOBAL_FORCES
+  invalidate_oif_global_triangles();
+#endif
+#ifdef IMMERSED_BOUNDARY
+  immersed_boundaries.invalidate_triangles();
+#endif
 
   recalc_forces = 1;
 }
@@ -295,6 +322,7 @@ void on_short_range_ia_change() {
 void on_constraint_change() {
   EVENT_TRACE(fprintf(stderr, "%d: on_constraint_change\n", this_node));
   invalidate_obs();
+  Constraints::constraints.invalidate_cell_constraints();
   recalc_forces = 1;
 }
 
@@ -317,6 +345,18 @@ void on_resort_particles() {
 
   /* DIPOLAR interactions so far don't need this */
 
+  invalidate_bond_topology();
+#ifdef OIF_GLOBAL_FORCES
+  invalidate_oif_global_triangles();
+#endif
+#ifdef IMMERSED_BOUNDARY
+  immersed_boundaries.invalidate_triangles();
+#endif
+  invalidate_local_particle_features();
+#ifdef VIRTUAL_SITES_RELATIVE
+  invalidate_vs_relative_bodies();
+#endif
+
   recalc_forces = 1;
 }
 
@@ -349,6 +389,19 @@ void on_boxl_change() {
 void on_cell_structure_change() {
   EVENT_TRACE(fprintf(stderr, "%d: on_cell_structure_change\n", this_node));
 
+  invalidate_bond_topology();
+#ifdef OIF_GLOBAL_FORCES
+  invalidate_oif_global_triangles();
+#endif
+#ifdef IMMERSED_BOUNDARY
+  immersed_boundaries.invalidate_triangles();
+#endif
+  invalidate_local_particle_features();
+#ifdef VIRTUAL_SITES_RELATIVE
+  invalidate_vs_relative_bodies();
+#endif
+  Constraints::constraints.invalidate_cell_constraints();
+
 /* Now give methods a chance to react to the change in cell
    structure.  Most ES methods need to reinitialize, as they depend
    on skin, node grid and so on. Only for a change in box length we
@@ -432,6 +485,10 @@ void on_parameter_change(int field) {
   case FIELD_NPTISO_PISTON:
     reinit_thermo = 1;
     break;
+  case FIELD_RESPA_INTERVAL:
+    /* the stored forces contain the long range part with the old weight */
+    recalc_forces = 1;
+    break;
 #ifdef NPT
   case FIELD_INTEG_SWITCH:
     if (integ_switch != INTEG_METHOD_NPT_ISO)
@@ -452,6 +509,12 @@ void on_parameter_change(int field) {
     /* LB needs ghost velocities */
     on_ghost_flags_change();
     break;
+#endif
+#ifdef OIF_GLOBAL_FORCES
+  case FIELD_MAX_OIF_OBJECTS:
+    invalidate_oif_global_triangles();
+    recalc_forces = 1;
+    break;
 #endif
   case FIELD_FORCE_CAP:
     /* If the force cap changed, forces are invalid */
@@ -38,11 +38,13 @@
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "immersed_boundaries.hpp"
+#include "integrate.hpp"
 #include "short_range_loop.hpp"
 
 #include <profiler/profiler.hpp>
 
 #include <cassert>
+#include <vector>
 
 ActorList forceActors;
 
@@ -61,8 +63,16 @@ void init_forces() {
      or zero depending on the thermostat
      set torque to zero for all and rescale quaternions
   */
-  for (auto &p : local_cells.particles()) {
-    init_local_particle_force(&p);
+  auto const &features = local_particle_features();
+  if (features.fixed_coordinates or features.external_forces or
+      features.swimming) {
+    for (auto &p : local_cells.particles()) {
+      init_local_particle_force<true>(&p);
+    }
+  } else {
+    for (auto &p : local_cells.particles()) {
+      init_local_particle_force<false>(&p);
+    }
   }
 
   /* initialize ghost forces with zero
@@ -92,6 +102,41 @@ void check_forces() {
   }
 }
 
+namespace {
+/** Add the long range forces with the weight of the current multiple time
+ *  stepping phase, see @ref respa_long_range_weight.
+ */
+void calc_weighted_long_range_forces() {
+  auto const weight = respa_long_range_weight();
+
+  if (weight == 1) {
+    calc_long_range_forces();
+    return;
+  }
+  if (weight == 0)
+    return;
+
+  /* The long range methods add to the forces of the local particles,
+   * so the difference to the forces before is the long range part. */
+  std::vector<ParticleForce> f_before;
+  f_before.reserve(local_cells.particles().size());
+  for (auto const &p : local_cells.particles()) {
+    f_before.push_back(p.f);
+  }
+
+  calc_long_range_forces();
+
+  auto f_old = f_before.begin();
+  for (auto &p : local_cells.particles()) {
+    p.f.f = f_old->f + weight * (p.f.f - f_old->f);
+#ifdef ROTATION
+    p.f.torque = f_old->torque + weight * (p.f.torque - f_old->torque);
+#endif
+    ++f_old;
+  }
+}
+} // namespace
+
 void force_calc() {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
@@ -113,37 +158,23 @@ void force_calc() {
 #endif
   }
 
-  calc_long_range_forces();
+  calc_weighted_long_range_forces();
+
+  add_bonded_forces();
 
   // Only calculate pair forces if the maximum cutoff is >0
   if (max_cut > 0) {
-    short_range_loop([](Particle &p) { add_single_particle_force(&p); },
+    short_range_loop([](Particle &) {},
                      [](Particle &p1, Particle &p2, Distance &d) {
                        add_non_bonded_pair_force(&(p1), &(p2), d.vec21.data(),
                                                  sqrt(d.dist2), d.dist2);
                      });
-  } else {
-    // Otherwise only do single-particle contributions
-    for (auto &p : local_cells.particles()) {
-      add_single_particle_force(&p);
-    }
   }
-  auto local_parts = local_cells.particles();
-  Constraints::constraints.add_forces(local_parts, sim_time);
+  Constraints::constraints.add_forces(local_cells, sim_time);
 
 #ifdef OIF_GLOBAL_FORCES
   if (max_oif_objects) {
-    double area_volume[2]; // There are two global quantities that need to be
-    // evaluated: object's surface and object's volume. One
-    // can add another quantity.
-    area_volume[0] = 0.0;
-    area_volume[1] = 0.0;
-    for (int i = 0; i < max_oif_objects; i++) {
-      calc_oif_global(area_volume, i);
-      if (fabs(area_volume[0]) < 1e-100 && fabs(area_volume[1]) < 1e-100)
-        break;
-      add_oif_global_forces(area_volume, i);
-    }
+    add_oif_global_forces();
   }
 #endif
 
@@ -26,6 +26,7 @@
 #include "bonded_interactions/angle_cosine.hpp"
 #include "bonded_interactions/angle_cossquare.hpp"
 #include "bonded_interactions/angle_harmonic.hpp"
+#include "bonded_interactions/bond_topology.hpp"
 #include "bonded_interactions/bonded_tab.hpp"
 #include "bonded_interactions/dihedral.hpp"
 #include "bonded_interactions/fene.hpp"
@@ -90,7 +91,11 @@ inline void init_ghost_force(Particle *part) {
 #endif
 }
 
-/** Initialize the forces for a real particle */
+/** Initialize the forces for a real particle
+ *  @tparam generic Handle fixed coordinates, external forces and torques
+ *                  and swimming.
+ */
+template <bool generic = true>
 inline void init_local_particle_force(Particle *part) {
   if (thermo_switch & THERMO_LANGEVIN)
     friction_thermo_langevin(part);
@@ -99,25 +104,26 @@ inline void init_local_particle_force(Particle *part) {
   }
 
 #ifdef EXTERNAL_FORCES
-  // If individual coordinates are fixed, set force to 0.
-  for (int j = 0; j < 3; j++)
-    if (part->p.ext_flag & COORD_FIXED(j))
-      part->f.f[j] = 0;
-  // Add external force
-  if (part->p.ext_flag & PARTICLE_EXT_FORCE)
-    part->f.f += part->p.ext_force;
+  if (generic) {
+    // If individual coordinates are fixed, set force to 0.
+    for (int j = 0; j < 3; j++)
+      if (part->p.ext_flag & COORD_FIXED(j))
+        part->f.f[j] = 0;
+    // Add external force
+    if (part->p.ext_flag & PARTICLE_EXT_FORCE)
+      part->f.f += part->p.ext_force;
+  }
 #endif
 
 #ifdef ROTATION
   {
-    double scale;
     /* set torque to zero */
     part->f.torque[0] = 0;
     part->f.torque[1] = 0;
     part->f.torque[2] = 0;
 
 #ifdef EXTERNAL_FORCES
-    if (part->p.ext_flag & PARTICLE_EXT_TORQUE) {
+    if (generic and (part->p.ext_flag & PARTICLE_EXT_TORQUE)) {
       part->f.torque[0] += part->p.ext_torque[0];
       part->f.torque[1] += part->p.ext_torque[1];
       part->f.torque[2] += part->p.ext_torque[2];
@@ -127,22 +133,10 @@ inline void init_local_particle_force(Particle *part) {
 #ifdef ENGINE
     // apply a swimming force in the direction of
     // the particle's orientation axis
-    if (part->swim.swimming) {
+    if (generic and part->swim.swimming) {
       part->f.f += part->swim.f_swim * part->r.calc_director();
     }
 #endif
-
-    /* and rescale quaternion, so it is exactly of unit length */
-    scale = sqrt(Utils::sqr(part->r.quat[0]) + Utils::sqr(part->r.quat[1]) +
-                 Utils::sqr(part->r.quat[2]) + Utils::sqr(part->r.quat[3]));
-    if (scale == 0) {
-      part->r.quat[0] = 1;
-    } else {
-      part->r.quat[0] /= scale;
-      part->r.quat[1] /= scale;
-      part->r.quat[2] /= scale;
-      part->r.quat[3] /= scale;
-    }
   }
 #endif
 }
@@ -414,234 +408,278 @@ inline int calc_bond_pair_force(Particle *p1, Particle *p2,
   return bond_broken;
 }
 
-/** Calculate bonded forces for one particle.
- *  @param p1   particle for which to calculate forces
+/** Calculate and add the forces of one bond.
+ *  @param type_num  bond type, index in @ref bonded_ia_params
+ *  @param p1        particle that owns the bond
+ *  @param partners  the @ref Bonded_ia_parameters::num bond partners
  */
-inline void add_bonded_force(Particle *p1) {
-  Particle *p3 = nullptr, *p4 = nullptr;
-  int bond_broken = 1;
-
-  int i = 0;
-  while (i < p1->bl.n) {
-    double dx[3] = {0., 0., 0.};
-    double force[3] = {0., 0., 0.};
-    double force2[3] = {0., 0., 0.};
-    double force3[3] = {0., 0., 0.};
+inline void add_bond_force(int type_num, Particle *p1,
+                           Particle *const *partners) {
+  auto const iaparams = &bonded_ia_params[type_num];
+  double dx[3] = {0., 0., 0.};
+  double force[3] = {0., 0., 0.};
+  double force2[3] = {0., 0., 0.};
+  double force3[3] = {0., 0., 0.};
 #if defined(OIF_LOCAL_FORCES)
-    double force4[3] = {0., 0., 0.};
-#endif
-    int type_num = p1->bl.e[i++];
-    auto iaparams = &bonded_ia_params[type_num];
-    int type = iaparams->type;
-    int n_partners = iaparams->num;
-
-    Particle *p2 = nullptr;
-    if (n_partners) {
-      p2 = local_particles[p1->bl.e[i++]];
-      if (!p2) {
-        runtimeErrorMsg() << "bond broken between particles " << p1->p.identity;
-        return;
-      }
-
-      /* fetch particle 3 eventually */
-      if (n_partners >= 2) {
-        p3 = local_particles[p1->bl.e[i++]];
-        if (!p3) {
-          runtimeErrorMsg()
-              << "bond broken between particles " << p1->p.identity << ", "
-              << p1->bl.e[i - 2] << " and " << p1->bl.e[i - 1]
-              << " (particles are not stored on the same node)";
-          return;
-        }
-      }
+  double force4[3] = {0., 0., 0.};
+#endif
+  int type = iaparams->type;
+  int n_partners = iaparams->num;
 
-      /* fetch particle 4 eventually */
-      if (n_partners >= 3) {
-        p4 = local_particles[p1->bl.e[i++]];
-        if (!p4) {
-          runtimeErrorMsg()
-              << "bond broken between particles " << p1->p.identity << ", "
-              << p1->bl.e[i - 3] << ", " << p1->bl.e[i - 2] << " and "
-              << p1->bl.e[i - 1] << " (particles not stored on the same node)";
-          return;
-        }
-      }
-    }
+  Particle *p2 = (n_partners >= 1) ? partners[0] : nullptr;
+  Particle *p3 = (n_partners >= 2) ? partners[1] : nullptr;
+  Particle *p4 = (n_partners >= 3) ? partners[2] : nullptr;
+  int bond_broken = 1;
 
-    if (n_partners == 1) {
-      /* because of the NPT pressure calculation for pair forces, we need the
-         1->2 distance vector here. For many body interactions this vector is
-         not needed,
-         and the pressure calculation not yet clear. */
-      get_mi_vector(dx, p1->r.p, p2->r.p);
-      bond_broken = calc_bond_pair_force(p1, p2, iaparams, dx, force);
+  if (n_partners == 1) {
+    /* because of the NPT pressure calculation for pair forces, we need the
+       1->2 distance vector here. For many body interactions this vector is
+       not needed,
+       and the pressure calculation not yet clear. */
+    get_mi_vector(dx, p1->r.p, p2->r.p);
+    bond_broken = calc_bond_pair_force(p1, p2, iaparams, dx, force);
 
 #ifdef NPT
-      if (integ_switch == INTEG_METHOD_NPT_ISO)
-        for (int j = 0; j < 3; j++)
-          nptiso.p_vir[j] += force[j] * dx[j];
+    if (integ_switch == INTEG_METHOD_NPT_ISO)
+      for (int j = 0; j < 3; j++)
+        nptiso.p_vir[j] += force[j] * dx[j];
 #endif
 
-      switch (type) {
-      case BONDED_IA_THERMALIZED_DIST:
-        bond_broken =
-            calc_thermalized_bond_forces(p1, p2, iaparams, dx, force, force2);
-        break;
+    switch (type) {
+    case BONDED_IA_THERMALIZED_DIST:
+      bond_broken =
+          calc_thermalized_bond_forces(p1, p2, type_num, dx, force, force2);
+      break;
 
-      default:
-        break;
-      }
-    } // 1 partner
-    else if (n_partners == 2) {
-      switch (type) {
-      case BONDED_IA_ANGLE_HARMONIC:
-        bond_broken = calc_angle_harmonic_force(p1, p2, p3, iaparams, force,
-                                                force2, force3);
-        break;
-      case BONDED_IA_ANGLE_COSINE:
-        bond_broken = calc_angle_cosine_force(p1, p2, p3, iaparams, force,
+    default:
+      break;
+    }
+  } // 1 partner
+  else if (n_partners == 2) {
+    switch (type) {
+    case BONDED_IA_ANGLE_HARMONIC:
+      bond_broken = calc_angle_harmonic_force(p1, p2, p3, iaparams, force,
                                               force2, force3);
-        break;
-      case BONDED_IA_ANGLE_COSSQUARE:
-        bond_broken = calc_angle_cossquare_force(p1, p2, p3, iaparams, force,
-                                                 force2, force3);
-        break;
+      break;
+    case BONDED_IA_ANGLE_COSINE:
+      bond_broken = calc_angle_cosine_force(p1, p2, p3, iaparams, force,
+                                            force2, force3);
+      break;
+    case BONDED_IA_ANGLE_COSSQUARE:
+      bond_broken = calc_angle_cossquare_force(p1, p2, p3, iaparams, force,
+                                               force2, force3);
+      break;
 #ifdef OIF_GLOBAL_FORCES
-      case BONDED_IA_OIF_GLOBAL_FORCES:
-        bond_broken = 0;
-        break;
+    case BONDED_IA_OIF_GLOBAL_FORCES:
+      bond_broken = 0;
+      break;
 #endif
 #ifdef TABULATED
-      case BONDED_IA_TABULATED:
-        if (iaparams->num == 2)
-          bond_broken =
-              calc_tab_angle_force(p1, p2, p3, iaparams, force, force2, force3);
-        break;
+    case BONDED_IA_TABULATED:
+      if (iaparams->num == 2)
+        bond_broken =
+            calc_tab_angle_force(p1, p2, p3, iaparams, force, force2, force3);
+      break;
 #endif
 #ifdef IMMERSED_BOUNDARY
-      case BONDED_IA_IBM_TRIEL:
-        bond_broken = IBM_Triel_CalcForce(p1, p2, p3, iaparams);
-        break;
+    case BONDED_IA_IBM_TRIEL:
+      bond_broken = IBM_Triel_CalcForce(p1, p2, p3, iaparams);
+      break;
 #endif
-      default:
-        runtimeErrorMsg() << "add_bonded_force: bond type of atom "
-                          << p1->p.identity << " unknown " << type << ","
-                          << n_partners << "\n";
-        return;
-      }
-    } // 2 partners (angle bonds...)
-    else if (n_partners == 3) {
-      switch (type) {
+    default:
+      runtimeErrorMsg() << "add_bond_force: bond type of atom "
+                        << p1->p.identity << " unknown " << type << ","
+                        << n_partners << "\n";
+      return;
+    }
+  } // 2 partners (angle bonds...)
+  else if (n_partners == 3) {
+    switch (type) {
 #ifdef MEMBRANE_COLLISION
-      case BONDED_IA_OIF_OUT_DIRECTION:
-        bond_broken = calc_out_direction(p1, p2, p3, p4, iaparams);
-        break;
+    case BONDED_IA_OIF_OUT_DIRECTION:
+      bond_broken = calc_out_direction(p1, p2, p3, p4, iaparams);
+      break;
 #endif
 #ifdef OIF_LOCAL_FORCES
-      case BONDED_IA_OIF_LOCAL_FORCES:
-        bond_broken = calc_oif_local(p1, p2, p3, p4, iaparams, force, force2,
-                                     force3, force4);
-        break;
+    case BONDED_IA_OIF_LOCAL_FORCES:
+      bond_broken = calc_oif_local(p1, p2, p3, p4, iaparams, force, force2,
+                                   force3, force4);
+      break;
 #endif
 // IMMERSED_BOUNDARY
 #ifdef IMMERSED_BOUNDARY
-      case BONDED_IA_IBM_TRIBEND: {
-        IBM_Tribend_CalcForce(p1, p2, p3, p4, *iaparams);
-        bond_broken = 0;
+    case BONDED_IA_IBM_TRIBEND: {
+      IBM_Tribend_CalcForce(p1, p2, p3, p4, *iaparams);
+      bond_broken = 0;
 
-        break;
-      }
+      break;
+    }
 #endif
-      case BONDED_IA_DIHEDRAL:
-        bond_broken = calc_dihedral_force(p1, p2, p3, p4, iaparams, force,
-                                          force2, force3);
-        break;
+    case BONDED_IA_DIHEDRAL:
+      bond_broken = calc_dihedral_force(p1, p2, p3, p4, iaparams, force,
+                                        force2, force3);
+      break;
 #ifdef TABULATED
-      case BONDED_IA_TABULATED:
-        if (iaparams->num == 3)
-          bond_broken = calc_tab_dihedral_force(p1, p2, p3, p4, iaparams, force,
-                                                force2, force3);
-        break;
+    case BONDED_IA_TABULATED:
+      if (iaparams->num == 3)
+        bond_broken = calc_tab_dihedral_force(p1, p2, p3, p4, iaparams, force,
+                                              force2, force3);
+      break;
 #endif
+    default:
+      runtimeErrorMsg() << "add_bond_force: bond type of atom "
+                        << p1->p.identity << " unknown " << type << ","
+                        << n_partners << "\n";
+      return;
+    }
+  } // 3 bond partners
+
+  switch (n_partners) {
+  case 1:
+    if (bond_broken) {
+      runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
+                        << " and " << p2->p.identity
+                        << ". Distance vector: " << dx[0] << " " << dx[1]
+                        << " " << dx[2];
+      return;
+    }
+
+    for (int j = 0; j < 3; j++) {
+      switch (type) {
+      case BONDED_IA_THERMALIZED_DIST:
+        p1->f.f[j] += force[j];
+        p2->f.f[j] += force2[j];
+        break;
       default:
-        runtimeErrorMsg() << "add_bonded_force: bond type of atom "
-                          << p1->p.identity << " unknown " << type << ","
-                          << n_partners << "\n";
-        return;
+        p1->f.f[j] += force[j];
+        p2->f.f[j] -= force[j];
       }
-    } // 3 bond partners
-
-    switch (n_partners) {
-    case 1:
-      if (bond_broken) {
-        runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
-                          << " and " << p2->p.identity
-                          << ". Distance vector: " << dx[0] << " " << dx[1]
-                          << " " << dx[2];
-        continue;
+    }
+    break;
+  case 2:
+    if (bond_broken) {
+      runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
+                        << ", " << p2->p.identity << " and "
+                        << p3->p.identity;
+      return;
+    }
+
+    for (int j = 0; j < 3; j++) {
+      switch (type) {
+      default:
+        p1->f.f[j] += force[j];
+        p2->f.f[j] += force2[j];
+        p3->f.f[j] += force3[j];
       }
+    }
+    break;
+  case 3:
+    if (bond_broken) {
+      runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
+                        << ", " << p2->p.identity << ", " << p3->p.identity
+                        << " and " << p4->p.identity;
+      return;
+    }
 
+    switch (type) {
+    case BONDED_IA_DIHEDRAL:
       for (int j = 0; j < 3; j++) {
-        switch (type) {
-        case BONDED_IA_THERMALIZED_DIST:
-          p1->f.f[j] += force[j];
-          p2->f.f[j] += force2[j];
-          break;
-        default:
-          p1->f.f[j] += force[j];
-          p2->f.f[j] -= force[j];
-        }
+        p1->f.f[j] += force[j];
+        p2->f.f[j] += force2[j];
+        p3->f.f[j] += force3[j];
+        p4->f.f[j] -= force[j] + force2[j] + force3[j];
       }
       break;
-    case 2:
-      if (bond_broken) {
-        runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
-                          << ", " << p2->p.identity << " and "
-                          << p3->p.identity;
-        continue;
-      }
 
+#ifdef OIF_LOCAL_FORCES
+    case BONDED_IA_OIF_LOCAL_FORCES:
       for (int j = 0; j < 3; j++) {
-        switch (type) {
-        default:
-          p1->f.f[j] += force[j];
-          p2->f.f[j] += force2[j];
-          p3->f.f[j] += force3[j];
-        }
+        p1->f.f[j] += force2[j];
+        p2->f.f[j] += force[j];
+        p3->f.f[j] += force3[j];
+        p4->f.f[j] += force4[j];
       }
       break;
-    case 3:
-      if (bond_broken) {
-        runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
-                          << ", " << p2->p.identity << ", " << p3->p.identity
-                          << " and " << p4->p.identity;
-        continue;
-      }
+#endif
+    } // Switch type of 4-particle bond
+    break;
+  } // switch number of partners (add forces to particles)
+}
 
-      switch (type) {
-      case BONDED_IA_DIHEDRAL:
-        for (int j = 0; j < 3; j++) {
-          p1->f.f[j] += force[j];
-          p2->f.f[j] += force2[j];
-          p3->f.f[j] += force3[j];
-          p4->f.f[j] -= force[j] + force2[j] + force3[j];
-        }
-        break;
+/** Calculate and add the forces of all bonds of a pair bond type.
+ *  @param group   bonds of the type
+ *  @param kernel  force of one bond, signature as @ref calc_bond_pair_force
+ */
+template <class Kernel>
+void add_pair_bond_forces(BondGroup const &group, Kernel kernel) {
+  for (std::size_t i = 0; i < group.size(); i++) {
+    auto const p1 = group[i][0];
+    auto const p2 = group[i][1];
+
+    double dx[3];
+    get_mi_vector(dx, p1->r.p, p2->r.p);
+    double force[3] = {0., 0., 0.};
+    if (kernel(dx, force)) {
+      runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
+                        << " and " << p2->p.identity
+                        << ". Distance vector: " << dx[0] << " " << dx[1]
+                        << " " << dx[2];
+      continue;
+    }
 
-#ifdef OIF_LOCAL_FORCES
-      case BONDED_IA_OIF_LOCAL_FORCES:
-        for (int j = 0; j < 3; j++) {
-          p1->f.f[j] += force2[j];
-          p2->f.f[j] += force[j];
-          p3->f.f[j] += force3[j];
-          p4->f.f[j] += force4[j];
-        }
-        break;
+#ifdef NPT
+    if (integ_switch == INTEG_METHOD_NPT_ISO)
+      for (int j = 0; j < 3; j++)
+        nptiso.p_vir[j] += force[j] * dx[j];
 #endif
-      } // Switch type of 4-particle bond
+
+    for (int j = 0; j < 3; j++) {
+      p1->f.f[j] += force[j];
+      p2->f.f[j] -= force[j];
+    }
+  }
+}
+
+/** Calculate bonded forces of the local particles.
+ *
+ *  The bonds are processed type by type from the compiled
+ *  @ref local_bond_topology. The common pair bonds are evaluated
+ *  by a dedicated loop, all other types by @ref add_bond_force.
+ */
+inline void add_bonded_forces() {
+  for (auto const &group : local_bond_topology()) {
+    auto const iaparams = &bonded_ia_params[group.type_num];
+
+    switch (iaparams->type) {
+    case BONDED_IA_FENE:
+      add_pair_bond_forces(group, [iaparams](double const *dx, double *force) {
+        return calc_fene_pair_force(iaparams, Utils::Vector3d{dx, dx + 3},
+                                    force);
+      });
+      break;
+    case BONDED_IA_HARMONIC:
+      add_pair_bond_forces(group, [iaparams](double const *dx, double *force) {
+        return calc_harmonic_pair_force(iaparams, Utils::Vector3d{dx, dx + 3},
+                                        force);
+      });
+      break;
+    case BONDED_IA_QUARTIC:
+      add_pair_bond_forces(group, [iaparams](double const *dx, double *force) {
+        return calc_quartic_pair_force(iaparams, Utils::Vector3d{dx, dx + 3},
+                                       force);
+      });
+      break;
+    /* Constraints and virtual bonds do not contribute forces */
+    case BONDED_IA_RIGID_BOND:
+    case BONDED_IA_VIRTUAL_BOND:
       break;
-    } // switch number of partners (add forces to particles)
-  }   // loop over the particle's bond list
+    default:
+      for (std::size_t i = 0; i < group.size(); i++) {
+        auto const bond = group[i];
+        add_bond_force(group.type_num, bond[0], bond + 1);
+      }
+    }
+  }
 }
 
 inline void check_particle_force(Particle *part) {
@@ -662,10 +700,4 @@ inline void check_particle_force(Particle *part) {
 #endif
 }
 
-inline void add_single_particle_force(Particle *p) {
-  if (p->bl.n) {
-    add_bonded_force(p);
-  }
-}
-
 #endif
@@ -169,7 +169,13 @@ const std::unordered_map<int, Datafield> fields{
       "n_thermalized_bonds"}}, /* 56 from thermalized_bond.cpp */
     {FIELD_FORCE_CAP, {&force_cap, Datafield::Type::DOUBLE, 1, "force_cap"}},
     {FIELD_THERMO_VIRTUAL,
-     {&thermo_virtual, Datafield::Type::BOOL, 1, "thermo_virtual"}}};
+     {&thermo_virtual, Datafield::Type::BOOL, 1, "thermo_virtual"}},
+    {FIELD_RESPA_INTERVAL,
+     {&respa_interval, Datafield::Type::INT, 1,
+      "respa_interval"}}, /* from integrate.cpp */
+    {FIELD_RATTLE_ITERATIONS,
+     {&rattle_iterations, Datafield::Type::INT, 1,
+      "rattle_iterations"}}}; /* from rattle.cpp */
 
 std::size_t hash_value(Datafield const &field) {
   using boost::hash_range;
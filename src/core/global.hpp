@@ -111,7 +111,11 @@ enum Fields {
   FIELD_THERMALIZEDBONDS,
   FIELD_FORCE_CAP,
   FIELD_THERMO_VIRTUAL,
-  FIELD_SWIMMING_PARTICLES_EXIST
+  FIELD_SWIMMING_PARTICLES_EXIST,
+  /** index of \ref respa_interval */
+  FIELD_RESPA_INTERVAL,
+  /** index of \ref rattle_iterations */
+  FIELD_RATTLE_ITERATIONS
 };
 
 #endif
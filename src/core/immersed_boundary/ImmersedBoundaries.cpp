@@ -20,14 +20,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "ImmersedBoundaries.hpp"
 
 #ifdef IMMERSED_BOUNDARY
+#include "bonded_interactions/bond_topology.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
-#include "cells.hpp"
 #include "communication.hpp"
 #include "grid.hpp"
 #include "particle_data.hpp"
 
 #include <utils/constants.hpp>
 
+#include <boost/mpi/collectives.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
 /************
   IBM_VolumeConservation
 Calculate (1) volumes, (2) volume force and (3) add it to each virtual particle
@@ -58,8 +65,14 @@ void ImmersedBoundaries::init_volume_conservation() {
   // Also check if volume has been set due to reading of a checkpoint
   if (!VolumeInitDone) {
 
-    // Calculate volumes
-    calc_volumes();
+    // Calculate volumes. The reference volumes are set on all nodes, so
+    // here the volumes of all soft particles are summed up on all nodes.
+    auto const partial = partial_volumes();
+    std::vector<double> tempVol(MaxNumIBM);
+    for (std::size_t i = 0; i < partial.size(); i++)
+      tempVol[VolumeReduction.objects()[i]] = partial[i];
+    boost::mpi::all_reduce(comm_cart, tempVol.data(), MaxNumIBM,
+                           VolumesCurrent.data(), std::plus<double>());
 
     // numWriteCOM = 0;
 
@@ -148,134 +161,127 @@ int ImmersedBoundaries::volume_conservation_set_params(const int bond_type,
 }
 
 /****************
-   calc_volumes
-Calculate partial volumes on all compute nodes
-and call MPI to sum up
+   compile_triangles
+Collect the triels of the soft particles with volume conservation from
+the local bond topology
 ****************/
 
-void ImmersedBoundaries::calc_volumes() {
+void ImmersedBoundaries::compile_triangles() {
+  Triangles.clear();
+  std::vector<int> softIDs;
 
-  // Partial volumes for each soft particle, to be summed up
-  std::vector<double> tempVol(MaxNumIBM);
+  for (auto const &group : local_bond_topology()) {
+    if (bonded_ia_params[group.type_num].type != BONDED_IA_IBM_TRIEL)
+      continue;
 
-  // Loop over all particles on local node
-  for (int c = 0; c < local_cells.n; c++) {
-    const Cell *const cell = local_cells.cell[c];
+    for (std::size_t t = 0; t < group.size(); t++) {
+      // Our particle is the leading particle of a triel
+      Particle *const p1 = group[t][0];
 
-    for (int i = 0; i < cell->n; i++) {
-      Particle &p1 = cell->part[i];
-
-      // Check if particle has a BONDED_IA_IBM_TRIEL and a
-      // BONDED_IA_IBM_VOLUME_CONSERVATION Basically this loops over all
-      // triangles, not all particles First round to check for volume
-      // conservation and virtual Loop over all bonds of this particle Actually
-      // j loops over the bond-list, i.e. the bond partners (see
+      // Check if the particle also has a BONDED_IA_IBM_VOLUME_CONSERVATION
+      // Loop over all bonds of this particle
+      // Actually j loops over the bond-list, i.e. the bond partners (see
       // particle_data.hpp)
-      int softID = -1;
+      int volCons = -1;
       int j = 0;
-      while (j < p1.bl.n) {
-        const int type_num = p1.bl.e[j];
+      while (j < p1->bl.n) {
+        const int type_num = p1->bl.e[j];
         const Bonded_ia_parameters &iaparams = bonded_ia_params[type_num];
-        const int type = iaparams.type;
-        if (type == BONDED_IA_IBM_VOLUME_CONSERVATION) {
-          if (p1.p.is_virtual)
-            softID = iaparams.p.ibmVolConsParameters.softID;
-          else {
+        if (iaparams.type == BONDED_IA_IBM_VOLUME_CONSERVATION) {
+          if (!p1->p.is_virtual) {
             printf("Error. Encountered non-virtual particle with "
                    "VOLUME_CONSERVATION_IBM\n");
             std::abort();
           }
+          volCons = type_num;
         }
-        // Iterate, increase by the number of partners of this bond + 1 for bond
-        // type
+        // Iterate, increase by the number of partners of this bond + 1 for
+        // bond type
         j += iaparams.num + 1;
       }
 
-      // Second round for triel
-      if (softID > -1) {
-        j = 0;
-        while (j < p1.bl.n) {
-          const int type_num = p1.bl.e[j];
-          const Bonded_ia_parameters &iaparams = bonded_ia_params[type_num];
-          const int type = iaparams.type;
-
-          if (type == BONDED_IA_IBM_TRIEL) {
-            // Our particle is the leading particle of a triel
-            // Get second and third particle of the triangle
-            Particle *p2 = local_particles[p1.bl.e[j + 1]];
-            if (!p2) {
-              runtimeErrorMsg()
-                  << "{IBM_calc_volumes: 078 bond broken between particles "
-                  << p1.p.identity << " and " << p1.bl.e[j + 1]
-                  << " (particles not stored on the same node)} ";
-              return;
-            }
-            Particle *p3 = local_particles[p1.bl.e[j + 2]];
-            if (!p3) {
-              runtimeErrorMsg()
-                  << "{IBM_calc_volumes: 078 bond broken between particles "
-                  << p1.p.identity << " and " << p1.bl.e[j + 2]
-                  << " (particles not stored on the same node)} ";
-              return;
-            }
-
-            // Unfold position of first node
-            // this is to get a continuous trajectory with no jumps when box
-            // boundaries are crossed
-            double x1[3] = {p1.r.p[0], p1.r.p[1], p1.r.p[2]};
-            int img[3] = {p1.l.i[0], p1.l.i[1], p1.l.i[2]};
-            unfold_position(x1, img);
-
-            // Unfolding seems to work only for the first particle of a triel
-            // so get the others from relative vectors considering PBC
-            double a12[3];
-            get_mi_vector(a12, p2->r.p, x1);
-            double a13[3];
-            get_mi_vector(a13, p3->r.p, x1);
-
-            double x2[3];
-            double x3[3];
-
-            for (int i = 0; i < 3; i++) {
-              x2[i] = x1[i] + a12[i];
-              x3[i] = x1[i] + a13[i];
-            }
-
-            // Volume of this tetrahedron
-            // See Cha Zhang et.al. 2001, doi:10.1109/ICIP.2001.958278
-            // http://research.microsoft.com/en-us/um/people/chazhang/publications/icip01_ChaZhang.pdf
-            // The volume can be negative, but it is not necessarily the "signed
-            // volume" in the above paper (the sign of the real "signed volume"
-            // must be calculated using the normal vector; the result of the
-            // calculation here is simply a term in the sum required to
-            // calculate the volume of a particle). Again, see the paper. This
-            // should be equivalent to the formulation using vector identities
-            // in Krüger thesis
-
-            const double v321 = x3[0] * x2[1] * x1[2];
-            const double v231 = x2[0] * x3[1] * x1[2];
-            const double v312 = x3[0] * x1[1] * x2[2];
-            const double v132 = x1[0] * x3[1] * x2[2];
-            const double v213 = x2[0] * x1[1] * x3[2];
-            const double v123 = x1[0] * x2[1] * x3[2];
-
-            tempVol[softID] +=
-                1.0 / 6.0 * (-v321 + v231 + v312 - v132 - v213 + v123);
-          }
-          // Iterate, increase by the number of partners of this bond + 1 for
-          // bond type
-          j += iaparams.num + 1;
-        }
+      if (volCons > -1) {
+        const int softID =
+            bonded_ia_params[volCons].p.ibmVolConsParameters.softID;
+        softIDs.push_back(softID);
+        Triangles.push_back({softID, volCons, p1, group[t][1], group[t][2]});
       }
     }
   }
 
-  for (int i = 0; i < MaxNumIBM; i++)
-    VolumesCurrent[i] = 0;
+  std::sort(softIDs.begin(), softIDs.end());
+  softIDs.erase(std::unique(softIDs.begin(), softIDs.end()), softIDs.end());
+  for (auto &triangle : Triangles)
+    triangle.object = static_cast<int>(
+        std::lower_bound(softIDs.begin(), softIDs.end(), triangle.object) -
+        softIDs.begin());
+
+  VolumeReduction.set_objects(comm_cart, std::move(softIDs));
+  TrianglesValid = true;
+}
+
+/****************
+   partial_volumes
+Calculate partial volumes of the soft particles on this node
+****************/
+
+std::vector<double> ImmersedBoundaries::partial_volumes() {
+  if (!TrianglesValid)
+    compile_triangles();
+
+  // Partial volumes for each soft particle, to be summed up
+  std::vector<double> tempVol(VolumeReduction.objects().size());
+
+  for (auto const &triangle : Triangles) {
+    Particle const &p1 = *triangle.p1;
+
+    // Unfold position of first node
+    // this is to get a continuous trajectory with no jumps when box
+    // boundaries are crossed
+    auto const x1 = unfolded_position(p1);
+
+    // Unfolding seems to work only for the first particle of a triel
+    // so get the others from relative vectors considering PBC
+    auto const x2 = x1 + get_mi_vector(triangle.p2->r.p, x1);
+    auto const x3 = x1 + get_mi_vector(triangle.p3->r.p, x1);
+
+    // Volume of this tetrahedron
+    // See Cha Zhang et.al. 2001, doi:10.1109/ICIP.2001.958278
+    // http://research.microsoft.com/en-us/um/people/chazhang/publications/icip01_ChaZhang.pdf
+    // The volume can be negative, but it is not necessarily the "signed
+    // volume" in the above paper (the sign of the real "signed volume"
+    // must be calculated using the normal vector; the result of the
+    // calculation here is simply a term in the sum required to
+    // calculate the volume of a particle). Again, see the paper. This
+    // should be equivalent to the formulation using vector identities
+    // in Krüger thesis
+
+    const double v321 = x3[0] * x2[1] * x1[2];
+    const double v231 = x2[0] * x3[1] * x1[2];
+    const double v312 = x3[0] * x1[1] * x2[2];
+    const double v132 = x1[0] * x3[1] * x2[2];
+    const double v213 = x2[0] * x1[1] * x3[2];
+    const double v123 = x1[0] * x2[1] * x3[2];
+
+    tempVol[triangle.object] +=
+        1.0 / 6.0 * (-v321 + v231 + v312 - v132 - v213 + v123);
+  }
+
+  return tempVol;
+}
+
+/****************
+   calc_volumes
+Calculate partial volumes on all compute nodes
+and sum them up over the nodes holding the same soft particles
+****************/
 
+void ImmersedBoundaries::calc_volumes() {
   // Sum up and communicate
-  MPI_Allreduce(&(tempVol.front()), &(VolumesCurrent.front()), MaxNumIBM,
-                MPI_DOUBLE, MPI_SUM, comm_cart);
+  auto const volumes = VolumeReduction.reduce(partial_volumes());
+
+  for (std::size_t i = 0; i < volumes.size(); i++)
+    VolumesCurrent[VolumeReduction.objects()[i]] = volumes[i];
 }
 
 /*****************
@@ -284,112 +290,68 @@ Calculate and add the volume force to each node
 *******************/
 
 void ImmersedBoundaries::calc_volume_force() {
-  // Loop over all particles on local node
-  for (int c = 0; c < local_cells.n; c++) {
-    const Cell *const cell = local_cells.cell[c];
-
-    for (int i = 0; i < cell->n; i++) {
-      Particle &p1 = cell->part[i];
-
-      // Check if particle has a BONDED_IA_IBM_TRIEL and a
-      // BONDED_IA_IBM_VOLUME_CONSERVATION Basically this loops over all
-      // triangles, not all particles First round to check for volume
-      // conservation and virtual Loop over all bonds of this particle Actually
-      // j loops over the bond-list, i.e. the bond partners (see
-      // particle_data.hpp)
-      int softID = -1;
-      double volRef = 0.;
-      double kappaV = 0.;
-      int j = 0;
-      while (j < p1.bl.n) {
-        const int type_num = p1.bl.e[j];
-        const Bonded_ia_parameters &iaparams = bonded_ia_params[type_num];
-        const int type = iaparams.type;
-        if (type == BONDED_IA_IBM_VOLUME_CONSERVATION) {
-          if (!p1.p.is_virtual) {
-            printf("Error. Encountered non-virtual particle with "
-                   "VOLUME_CONSERVATION_IBM\n");
-            std::abort();
-          }
-          softID = iaparams.p.ibmVolConsParameters.softID;
-          volRef = iaparams.p.ibmVolConsParameters.volRef;
-          kappaV = iaparams.p.ibmVolConsParameters.kappaV;
-        }
-        // Iterate, increase by the number of partners of this bond + 1 for bond
-        // type
-        j += iaparams.num + 1;
-      }
-
-      // Second round for triel
-      if (softID > -1) {
-        j = 0;
-        while (j < p1.bl.n) {
-          const int type_num = p1.bl.e[j];
-          const Bonded_ia_parameters &iaparams = bonded_ia_params[type_num];
-          const int type = iaparams.type;
-
-          if (type == BONDED_IA_IBM_TRIEL) {
-            // Our particle is the leading particle of a triel
-            // Get second and third particle of the triangle
-            Particle *p2 = local_particles[p1.bl.e[j + 1]];
-            Particle *p3 = local_particles[p1.bl.e[j + 2]];
-
-            // Unfold position of first node
-            // this is to get a continuous trajectory with no jumps when box
-            // boundaries are crossed
-            double x1[3] = {p1.r.p[0], p1.r.p[1], p1.r.p[2]};
-            int img[3] = {p1.l.i[0], p1.l.i[1], p1.l.i[2]};
-            unfold_position(x1, img);
-
-            // Unfolding seems to work only for the first particle of a triel
-            // so get the others from relative vectors considering PBC
-            auto const a12 = get_mi_vector(p2->r.p, x1);
-            auto const a13 = get_mi_vector(p3->r.p, x1);
-
-            // Now we have the true and good coordinates
-            // Compute force according to eq. C.46 Krüger thesis
-            // It is the same as deriving Achim's equation w.r.t x
-            /*                        const double fact = kappaV * 1/6. *
-            (IBMVolumesCurrent[softID] - volRef) / IBMVolumesCurrent[softID];
-
-             double x2[3];
-            double x3[3];
-
-            for (int i=0; i < 3; i++)
-            {
-              x2[i] = x1[i] + a12[i];
-              x3[i] = x1[i] + a13[i];
-            }
-
-             double n[3];
-             vector_product(x3, x2, n);
-             for (int k=0; k < 3; k++) p1.f.f[k] += fact*n[k];
-             vector_product(x1, x3, n);
-             for (int k=0; k < 3; k++) p2->f.f[k] += fact*n[k];
-             vector_product(x2, x1, n);
-             for (int k=0; k < 3; k++) p3->f.f[k] += fact*n[k];*/
-
-            // This is Dupin 2008. I guess the result will be very similar as
-            // the code above
-            auto const n = vector_product(a12, a13);
-            const double ln = n.norm();
-            const double A = 0.5 * ln;
-            const double fact = kappaV * (VolumesCurrent[softID] - volRef) /
-                                VolumesCurrent[softID];
-
-            auto const nHat = n / ln;
-            auto const force = -fact * A * nHat;
-
-            p1.f.f += force;
-            p2->f.f += force;
-            p3->f.f += force;
-          }
-          // Iterate, increase by the number of partners of this bond + 1 for
-          // bond type
-          j += iaparams.num + 1;
-        }
-      }
+  if (!TrianglesValid)
+    compile_triangles();
+
+  // Loop over all triels of soft particles on local node
+  for (auto const &triangle : Triangles) {
+    Particle &p1 = *triangle.p1;
+    Particle *p2 = triangle.p2;
+    Particle *p3 = triangle.p3;
+
+    const auto &volConsParameters =
+        bonded_ia_params[triangle.volCons].p.ibmVolConsParameters;
+    const int softID = volConsParameters.softID;
+    const double volRef = volConsParameters.volRef;
+    const double kappaV = volConsParameters.kappaV;
+
+    // Unfold position of first node
+    // this is to get a continuous trajectory with no jumps when box
+    // boundaries are crossed
+    auto const x1 = unfolded_position(p1);
+
+    // Unfolding seems to work only for the first particle of a triel
+    // so get the others from relative vectors considering PBC
+    auto const a12 = get_mi_vector(p2->r.p, x1);
+    auto const a13 = get_mi_vector(p3->r.p, x1);
+
+    // Now we have the true and good coordinates
+    // Compute force according to eq. C.46 Krüger thesis
+    // It is the same as deriving Achim's equation w.r.t x
+    /*                        const double fact = kappaV * 1/6. *
+    (IBMVolumesCurrent[softID] - volRef) / IBMVolumesCurrent[softID];
+
+     double x2[3];
+    double x3[3];
+
+    for (int i=0; i < 3; i++)
+    {
+      x2[i] = x1[i] + a12[i];
+      x3[i] = x1[i] + a13[i];
     }
+
+     double n[3];
+     vector_product(x3, x2, n);
+     for (int k=0; k < 3; k++) p1.f.f[k] += fact*n[k];
+     vector_product(x1, x3, n);
+     for (int k=0; k < 3; k++) p2->f.f[k] += fact*n[k];
+     vector_product(x2, x1, n);
+     for (int k=0; k < 3; k++) p3->f.f[k] += fact*n[k];*/
+
+    // This is Dupin 2008. I guess the result will be very similar as
+    // the code above
+    auto const n = vector_product(a12, a13);
+    const double ln = n.norm();
+    const double A = 0.5 * ln;
+    const double fact = kappaV * (VolumesCurrent[softID] - volRef) /
+                        VolumesCurrent[softID];
+
+    auto const nHat = n / ln;
+    auto const force = -fact * A * nHat;
+
+    p1.f.f += force;
+    p2->f.f += force;
+    p3->f.f += force;
   }
 }
 
@@ -20,26 +20,53 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define IMMERSED_BOUNDARY_IMMERSED_BOUNDARIES_HPP
 
 #include "config.hpp"
+#include "ObjectReduction.hpp"
+
 #include <vector>
 
 #ifdef IMMERSED_BOUNDARY
+struct Particle;
+
 class ImmersedBoundaries {
 public:
-  ImmersedBoundaries() : MaxNumIBM(1000), VolumeInitDone(false) {
+  ImmersedBoundaries()
+      : MaxNumIBM(1000), VolumeInitDone(false), VolumeReduction(1) {
     VolumesCurrent.resize(MaxNumIBM);
   }
   void init_volume_conservation();
   void volume_conservation();
   int volume_conservation_reset_params(int bond_type, double volRef);
   int volume_conservation_set_params(int bond_type, int softID, double kappaV);
+  /** Calculate the volumes of the soft particles with triangles on this
+   *  node. The partial volumes are only summed over the nodes holding
+   *  triangles of the same soft particle. */
   void calc_volumes();
   void calc_volume_force();
+  /** Mark the cached triangles as outdated. */
+  void invalidate_triangles() { TrianglesValid = false; }
 
 private:
+  /** A triel of a soft particle with volume conservation. */
+  struct Triangle {
+    /** Index of the soft particle in @ref VolumeReduction. */
+    int object;
+    /** Bond type of the volume conservation of the soft particle. */
+    int volCons;
+    Particle *p1, *p2, *p3;
+  };
+
+  void compile_triangles();
+  /** Partial volumes of the soft particles with triangles on this node. */
+  std::vector<double> partial_volumes();
+
   const int MaxNumIBM;
   std::vector<double> VolumesCurrent;
   bool VolumeInitDone = false;
   bool BoundariesFound = false;
+
+  std::vector<Triangle> Triangles;
+  bool TrianglesValid = false;
+  ObjectReduction VolumeReduction;
 };
 
 #endif
@@ -74,6 +74,8 @@
 
 int integ_switch = INTEG_METHOD_NVT;
 
+int respa_interval = 1;
+
 int n_verlet_updates = 0;
 
 double time_step = -1.0;
@@ -98,7 +100,13 @@ int db_maxf_id = 0, db_maxv_id = 0;
 bool set_py_interrupt = false;
 namespace {
 volatile std::sig_atomic_t ctrl_C = 0;
-}
+
+/** Number of steps since the last long range force evaluation. */
+int respa_phase = 0;
+
+LocalParticleFeatures local_features;
+bool local_features_valid = false;
+} // namespace
 
 /** \name Private Functions */
 /************************************************************/
@@ -125,7 +133,10 @@ void propagate_vel_finalize_p_inst();
 /** Integrator stability check (see compile flag ADDITIONAL_CHECKS). */
 void force_and_velocity_display();
 
-void finalize_p_inst_npt();
+/** Finalize the instantaneous pressure and propagate the piston
+    momentum by a half step.
+    @tparam step First (1) or second (2) half step of the time step. */
+template <int step> void finalize_p_inst_npt();
 
 /*@}*/
 
@@ -135,8 +146,54 @@ void integrator_sanity_checks() {
   if (time_step < 0.0) {
     runtimeErrorMsg() << "time_step not set";
   }
+
+  if (respa_interval > 1) {
+    if (integ_switch == INTEG_METHOD_NPT_ISO) {
+      runtimeErrorMsg()
+          << "multiple time stepping is not supported by the NpT integrator";
+    }
+#if defined(ELECTROSTATICS) && defined(CUDA)
+    if (coulomb.method == COULOMB_P3M_GPU) {
+      runtimeErrorMsg() << "multiple time stepping is not supported by P3M "
+                           "on the GPU";
+    }
+#endif
+  }
+}
+
+int respa_long_range_weight() {
+  if (respa_interval == 1 or integ_switch != INTEG_METHOD_NVT)
+    return 1;
+  return (respa_phase == 0) ? respa_interval : 0;
+}
+
+LocalParticleFeatures const &local_particle_features() {
+  if (not local_features_valid) {
+    local_features = LocalParticleFeatures{};
+
+    for (auto const &p : local_cells.particles()) {
+#ifdef VIRTUAL_SITES
+      local_features.virtual_sites |= static_cast<bool>(p.p.is_virtual);
+#endif
+#ifdef EXTERNAL_FORCES
+      local_features.fixed_coordinates |=
+          static_cast<bool>(p.p.ext_flag & COORDS_FIX_MASK);
+      local_features.external_forces |= static_cast<bool>(
+          p.p.ext_flag & (PARTICLE_EXT_FORCE | PARTICLE_EXT_TORQUE));
+#endif
+#ifdef ENGINE
+      local_features.swimming |= p.swim.swimming;
+#endif
+    }
+
+    local_features_valid = true;
+  }
+
+  return local_features;
 }
 
+void invalidate_local_particle_features() { local_features_valid = false; }
+
 #ifdef NPT
 
 void integrator_npt_sanity_checks() {
@@ -236,11 +293,13 @@ void integrate_vv(int n_steps, int reuse_forces) {
     }
 #endif
 
-    // Langevin philox rng counter
+    // Philox rng counters of the thermostats
     if (n_steps > 0) {
-      langevin_rng_counter_increment();
+      philox_counter_increment();
     }
 
+    // A fresh force calculation starts a new outer RESPA step
+    respa_phase = 0;
     force_calc();
 
     if (integ_switch != INTEG_METHOD_STEEPEST_DESCENT) {
@@ -332,9 +391,10 @@ void integrate_vv(int n_steps, int reuse_forces) {
     }
 #endif
 
-    // Propagate langevin philox rng counter
-    langevin_rng_counter_increment();
+    // Propagate the philox rng counters of the thermostats
+    philox_counter_increment();
 
+    respa_phase = (respa_phase + 1) % respa_interval;
     force_calc();
 
 #ifdef VIRTUAL_SITES
@@ -437,55 +497,73 @@ void integrate_vv(int n_steps, int reuse_forces) {
 /* Private functions */
 /************************************************************/
 
-void propagate_vel_finalize_p_inst() {
-#ifdef NPT
-  if (integ_switch == INTEG_METHOD_NPT_ISO) {
-    nptiso.p_vel[0] = nptiso.p_vel[1] = nptiso.p_vel[2] = 0.0;
-  }
-#endif
-
-  INTEG_TRACE(
-      fprintf(stderr, "%d: propagate_vel_finalize_p_inst:\n", this_node));
-
+namespace {
+/** Integration step 4 of the Velocity Verlet integrator.
+ *  @tparam generic Handle virtual sites, fixed coordinates and NpT.
+ */
+template <bool generic> void propagate_vel_finalize_kernel() {
   for (auto &p : local_cells.particles()) {
     ONEPART_TRACE(if (p.p.identity == check_id) fprintf(
         stderr, "%d: OPT: SCAL f = (%.3e,%.3e,%.3e) v_old = (%.3e,%.3e,%.3e)\n",
         this_node, p.f.f[0], p.f.f[1], p.f.f[2], p.m.v[0], p.m.v[1], p.m.v[2]));
 #ifdef VIRTUAL_SITES
     // Virtual sites are not propagated during integration
-    if (p.p.is_virtual)
+    if (generic and p.p.is_virtual)
       continue;
-#endif
-    for (int j = 0; j < 3; j++) {
-#ifdef EXTERNAL_FORCES
-      if (!(p.p.ext_flag & COORD_FIXED(j))) {
 #endif
 #ifdef NPT
-        if (integ_switch == INTEG_METHOD_NPT_ISO &&
-            (nptiso.geometry & nptiso.nptgeom_dir[j])) {
-          nptiso.p_vel[j] += Utils::sqr(p.m.v[j] * time_step) * p.p.mass;
-          p.m.v[j] += 0.5 * time_step / p.p.mass * p.f.f[j] +
-                      friction_therm0_nptiso(p.m.v[j]) / p.p.mass;
-        } else
+    auto const npt_friction =
+        (generic and integ_switch == INTEG_METHOD_NPT_ISO)
+            ? friction_therm0_nptiso<2>(p.m.v, p.p.identity)
+            : Utils::Vector3d{};
 #endif
-          /* Propagate velocity: v(t+dt) = v(t+0.5*dt) + 0.5*dt * a(t+dt) */
-          p.m.v[j] += 0.5 * time_step * p.f.f[j] / p.p.mass;
+    for (int j = 0; j < 3; j++) {
 #ifdef EXTERNAL_FORCES
-      }
+      if (generic and (p.p.ext_flag & COORD_FIXED(j)))
+        continue;
 #endif
+#ifdef NPT
+      if (generic and integ_switch == INTEG_METHOD_NPT_ISO &&
+          (nptiso.geometry & nptiso.nptgeom_dir[j])) {
+        nptiso.p_vel[j] += Utils::sqr(p.m.v[j] * time_step) * p.p.mass;
+        p.m.v[j] += 0.5 * time_step / p.p.mass * p.f.f[j] +
+                    npt_friction[j] / p.p.mass;
+      } else
+#endif
+        /* Propagate velocity: v(t+dt) = v(t+0.5*dt) + 0.5*dt * a(t+dt) */
+        p.m.v[j] += 0.5 * time_step * p.f.f[j] / p.p.mass;
     }
 
     ONEPART_TRACE(if (p.p.identity == check_id) fprintf(
         stderr, "%d: OPT: PV_2 v_new = (%.3e,%.3e,%.3e)\n", this_node, p.m.v[0],
         p.m.v[1], p.m.v[2]));
   }
+}
+} // namespace
 
+void propagate_vel_finalize_p_inst() {
 #ifdef NPT
-  finalize_p_inst_npt();
+  if (integ_switch == INTEG_METHOD_NPT_ISO) {
+    nptiso.p_vel[0] = nptiso.p_vel[1] = nptiso.p_vel[2] = 0.0;
+  }
+#endif
+
+  INTEG_TRACE(
+      fprintf(stderr, "%d: propagate_vel_finalize_p_inst:\n", this_node));
+
+  auto const &features = local_particle_features();
+  if (features.virtual_sites or features.fixed_coordinates or
+      integ_switch == INTEG_METHOD_NPT_ISO)
+    propagate_vel_finalize_kernel<true>();
+  else
+    propagate_vel_finalize_kernel<false>();
+
+#ifdef NPT
+  finalize_p_inst_npt<2>();
 #endif
 }
 
-void finalize_p_inst_npt() {
+template <int step> void finalize_p_inst_npt() {
 #ifdef NPT
   if (integ_switch == INTEG_METHOD_NPT_ISO) {
     double p_tmp = 0.0;
@@ -504,7 +582,7 @@ void finalize_p_inst_npt() {
       nptiso.p_inst = p_tmp / (nptiso.dimension * nptiso.volume);
       nptiso.p_diff = nptiso.p_diff +
                       (nptiso.p_inst - nptiso.p_ext) * 0.5 * time_step +
-                      friction_thermV_nptiso(nptiso.p_diff);
+                      friction_thermV_nptiso<step>(nptiso.p_diff);
     }
   }
 #endif
@@ -516,7 +594,7 @@ void propagate_press_box_pos_and_rescale_npt() {
     double scal[3] = {0., 0., 0.}, L_new = 0.0;
 
     /* finalize derivation of p_inst */
-    finalize_p_inst_npt();
+    finalize_p_inst_npt<1>();
 
     /* adjust \ref nptiso_struct::nptiso.volume; prepare pos- and
      * vel-rescaling
@@ -607,15 +685,21 @@ void propagate_vel() {
 
   INTEG_TRACE(fprintf(stderr, "%d: propagate_vel:\n", this_node));
 
-  for (auto &p : local_cells.particles()) {
 #ifdef ROTATION
-    propagate_omega_quat_particle(&p);
+  propagate_omega_quat();
 #endif
 
+  for (auto &p : local_cells.particles()) {
 // Don't propagate translational degrees of freedom of vs
 #ifdef VIRTUAL_SITES
     if (p.p.is_virtual)
       continue;
+#endif
+#ifdef NPT
+    auto const npt_friction =
+        (integ_switch == INTEG_METHOD_NPT_ISO)
+            ? friction_therm0_nptiso<1>(p.m.v, p.p.identity)
+            : Utils::Vector3d{};
 #endif
     for (int j = 0; j < 3; j++) {
 #ifdef EXTERNAL_FORCES
@@ -626,7 +710,7 @@ void propagate_vel() {
         if (integ_switch == INTEG_METHOD_NPT_ISO &&
             (nptiso.geometry & nptiso.nptgeom_dir[j])) {
           p.m.v[j] += p.f.f[j] * 0.5 * time_step / p.p.mass +
-                      friction_therm0_nptiso(p.m.v[j]) / p.p.mass;
+                      npt_friction[j] / p.p.mass;
           nptiso.p_vel[j] += Utils::sqr(p.m.v[j] * time_step) * p.p.mass;
         } else
 #endif
@@ -676,41 +760,33 @@ void propagate_pos() {
   announce_resort_particles();
 }
 
-void propagate_vel_pos() {
-  INTEG_TRACE(fprintf(stderr, "%d: propagate_vel_pos:\n", this_node));
-
-#ifdef ADDITIONAL_CHECKS
-  db_max_force = db_max_vel = 0;
-  db_maxf_id = db_maxv_id = -1;
-#endif
-
+namespace {
+/** Integration steps 1 and 2 of the Velocity Verlet integrator.
+ *  @tparam generic Handle virtual sites and fixed coordinates.
+ */
+template <bool generic> void propagate_vel_pos_kernel() {
   for (auto &p : local_cells.particles()) {
-#ifdef ROTATION
-    propagate_omega_quat_particle(&p);
-#endif
-
 // Don't propagate translational degrees of freedom of vs
 #ifdef VIRTUAL_SITES
-    if (p.p.is_virtual)
+    if (generic and p.p.is_virtual)
       continue;
 #endif
     for (int j = 0; j < 3; j++) {
 #ifdef EXTERNAL_FORCES
-      if (!(p.p.ext_flag & COORD_FIXED(j)))
+      if (generic and (p.p.ext_flag & COORD_FIXED(j)))
+        continue;
 #endif
-      {
-        /* Propagate velocities: v(t+0.5*dt) = v(t) + 0.5 * dt * a(t) */
-        p.m.v[j] += 0.5 * time_step * p.f.f[j] / p.p.mass;
+      /* Propagate velocities: v(t+0.5*dt) = v(t) + 0.5 * dt * a(t) */
+      p.m.v[j] += 0.5 * time_step * p.f.f[j] / p.p.mass;
 
-        /* Propagate positions (only NVT): p(t + dt)   = p(t) + dt *
-         * v(t+0.5*dt) */
-        p.r.p[j] += time_step * p.m.v[j];
-      }
+      /* Propagate positions (only NVT): p(t + dt)   = p(t) + dt *
+       * v(t+0.5*dt) */
+      p.r.p[j] += time_step * p.m.v[j];
     }
 
     ONEPART_TRACE(if (p.p.identity == check_id) fprintf(
-        stderr, "%d: OPT: PV_1 v_new = (%.3e,%.3e,%.3e)\n", this_node, p.m.v[0],
-        p.m.v[1], p.m.v[2]));
+        stderr, "%d: OPT: PV_1 v_new = (%.3e,%.3e,%.3e)\n", this_node,
+        p.m.v[0], p.m.v[1], p.m.v[2]));
     ONEPART_TRACE(if (p.p.identity == check_id)
                       fprintf(stderr, "%d: OPT: PPOS p = (%.3e,%.3e,%.3e)\n",
                               this_node, p.r.p[0], p.r.p[1], p.r.p[2]));
@@ -722,6 +798,26 @@ void propagate_vel_pos() {
         skin2)
       set_resort_particles(Cells::RESORT_LOCAL);
   }
+}
+} // namespace
+
+void propagate_vel_pos() {
+  INTEG_TRACE(fprintf(stderr, "%d: propagate_vel_pos:\n", this_node));
+
+#ifdef ADDITIONAL_CHECKS
+  db_max_force = db_max_vel = 0;
+  db_maxf_id = db_maxv_id = -1;
+#endif
+
+#ifdef ROTATION
+  propagate_omega_quat();
+#endif
+
+  auto const &features = local_particle_features();
+  if (features.virtual_sites or features.fixed_coordinates)
+    propagate_vel_pos_kernel<true>();
+  else
+    propagate_vel_pos_kernel<false>();
 
   announce_resort_particles();
 
@@ -803,6 +899,17 @@ void integrate_set_nvt() {
   mpi_bcast_parameter(FIELD_INTEG_SWITCH);
 }
 
+int integrate_set_respa_interval(int interval) {
+  if (interval < 1) {
+    runtimeErrorMsg() << "the RESPA interval has to be a positive integer";
+    return ES_ERROR;
+  }
+
+  respa_interval = interval;
+  mpi_bcast_parameter(FIELD_RESPA_INTERVAL);
+  return ES_OK;
+}
+
 /** Parse integrate npt_isotropic command */
 int integrate_set_npt_isotropic(double ext_pressure, double piston, int xdir,
                                 int ydir, int zdir, bool cubic_box) {
@@ -39,6 +39,12 @@
 /** Switch determining which Integrator to use. */
 extern int integ_switch;
 
+/** Number of time steps between two evaluations of the long range forces
+ *  (impulse multiple time stepping, r-RESPA). The default 1 evaluates them
+ *  every time step.
+ */
+extern int respa_interval;
+
 /** incremented if a Verlet update is done, aka particle resorting. */
 extern int n_verlet_updates;
 
@@ -95,6 +101,48 @@ void integrate_vv(int n_steps, int reuse_forces);
 int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces);
 
 void integrate_set_nvt();
+
+/** Set @ref respa_interval.
+ *  @param interval number of time steps per long range force evaluation
+ *  @retval ES_OK
+ *  @retval ES_ERROR
+ */
+int integrate_set_respa_interval(int interval);
+
+/** Weight of the long range forces in the current force calculation.
+ *
+ *  With multiple time stepping, the long range forces are evaluated only
+ *  at the end of every @ref respa_interval -th step. They then enter the
+ *  two adjacent velocity half steps with @ref respa_interval times their
+ *  weight, which is the impulse of the outer RESPA step. Otherwise the
+ *  weight is zero, and the long range forces are skipped altogether.
+ */
+int respa_long_range_weight();
+
+/** Particle properties in use on this node that need special treatment
+ *  in the integration and force initialization loops. If none of them is
+ *  used, the loops take a fast path without the corresponding checks.
+ */
+struct LocalParticleFeatures {
+  /** Some particles are virtual sites. */
+  bool virtual_sites = false;
+  /** Some particles have fixed coordinates. */
+  bool fixed_coordinates = false;
+  /** Some particles have an external force or torque. */
+  bool external_forces = false;
+  /** Some particles are swimmers. */
+  bool swimming = false;
+};
+
+/** @brief Features used by the local particles.
+ *
+ *  They are determined if they were invalidated since the last call.
+ */
+LocalParticleFeatures const &local_particle_features();
+
+/** Mark the features of the local particles as outdated. */
+void invalidate_local_particle_features();
+
 int integrate_set_npt_isotropic(double ext_pressure, double piston, int xdir,
                                 int ydir, int zdir, bool cubic_box);
 
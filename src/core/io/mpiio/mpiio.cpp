@@ -51,17 +51,42 @@
 #include "config.hpp"
 
 #include "bonded_interactions/bonded_interaction_data.hpp"
+#include "bonded_interactions/thermalized_bond.hpp"
 #include "cells.hpp"
+#include "dpd.hpp"
 #include "errorhandling.hpp"
 #include "event.hpp"
+#include "grid.hpp"
+#include "grid_based_algorithms/lb.hpp"
+#include "grid_based_algorithms/lb_interface.hpp"
+#include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "integrate.hpp"
 #include "mpiio.hpp"
 #include "particle_data.hpp"
+#include "quantized_codec.hpp"
+#include "random.hpp"
+#include "serialization/Particle.hpp"
+#include "thermostat.hpp"
+
+#include <utils/index.hpp>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/optional.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/optional.hpp>
+#include <boost/serialization/string.hpp>
 
 #include <mpi.h>
 
 #include <cerrno>
 #include <cstring>
+#include <deque>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -69,19 +94,48 @@
 
 namespace Mpiio {
 
-/** Dumps arr of size len starting from prefix pref of type T using
- * MPI_T as MPI datatype. Beware, that T and MPI_T have to match!
+/** Snapshot of the output of one call to mpi_mpiio_common_write()
+ *  and the file operations writing it. The buffers must not be
+ *  touched until all requests are complete.
+ */
+struct PendingWrite {
+  std::vector<double> pos, vel;
+  std::vector<int> id, type, boff, bond;
+  /** Quantized positions and velocities */
+  std::vector<char> qpos, qvel;
+  int pref;
+  long long qpos_pref, qvel_pref;
+  std::vector<std::string> filenames;
+  std::vector<MPI_File> files;
+  std::vector<MPI_Request> requests;
+};
+
+/** Asynchronous writes in the order they were started. */
+static std::deque<std::unique_ptr<PendingWrite>> pending_writes;
+/** Completed writes, kept to reuse their buffers. */
+static std::vector<std::unique_ptr<PendingWrite>> spare_writes;
+/** Maximal number of asynchronous writes in flight. If a further
+ *  write is started, the oldest one is completed first. */
+static constexpr size_t max_pending_writes = 2;
+
+/** Starts to dump arr of size len starting from prefix pref of type T
+ * using MPI_T as MPI datatype. Beware, that T and MPI_T have to match!
+ * The write is registered in w and has to be completed by
+ * complete_write().
  *
  * \param fn The file name to dump to. Must not exist already
  * \param arr The array to dump
  * \param len The number of elements to dump
  * \param pref The prefix for this process
  * \param MPI_T The MPI_Datatype corresponding to the template parameter T.
+ * \param w The write the request belongs to.
  */
 template <typename T>
 static void mpiio_dump_array(const std::string &fn, T *arr, size_t len,
-                             size_t pref, MPI_Datatype MPI_T) {
+                             size_t pref, MPI_Datatype MPI_T,
+                             PendingWrite &w) {
   MPI_File f;
+  MPI_Request req;
   int ret;
 
   ret = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(fn.c_str()),
@@ -99,12 +153,49 @@ static void mpiio_dump_array(const std::string &fn, T *arr, size_t len,
   }
   ret = MPI_File_set_view(f, pref * sizeof(T), MPI_T, MPI_T,
                           const_cast<char *>("native"), MPI_INFO_NULL);
-  ret |= MPI_File_write_all(f, arr, len, MPI_T, MPI_STATUS_IGNORE);
-  MPI_File_close(&f);
+#if MPI_VERSION > 3 || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+  ret |= MPI_File_iwrite_all(f, arr, len, MPI_T, &req);
+#else
+  ret |= MPI_File_iwrite(f, arr, len, MPI_T, &req);
+#endif
   if (ret) {
     fprintf(stderr, "MPI-IO Error: Could not write file \"%s\".\n", fn.c_str());
     errexit();
   }
+  w.filenames.push_back(fn);
+  w.files.push_back(f);
+  w.requests.push_back(req);
+}
+
+/** Waits for all file operations of a write and closes the files.
+ *  To be called by all processes.
+ */
+static void complete_write(PendingWrite &w) {
+  std::vector<MPI_Status> statuses(w.requests.size());
+  auto const ret =
+      MPI_Waitall(w.requests.size(), w.requests.data(), statuses.data());
+
+  for (auto &f : w.files)
+    MPI_File_close(&f);
+
+  if (ret) {
+    for (auto const &fn : w.filenames)
+      fprintf(stderr, "MPI-IO Error: Could not write file \"%s\".\n",
+              fn.c_str());
+    errexit();
+  }
+
+  w.filenames.clear();
+  w.files.clear();
+  w.requests.clear();
+}
+
+void mpi_mpiio_common_flush() {
+  while (!pending_writes.empty()) {
+    complete_write(*pending_writes.front());
+    spare_writes.push_back(std::move(pending_writes.front()));
+    pending_writes.pop_front();
+  }
 }
 
 /** Dumps some generic infos like the dumped fields and info to process
@@ -113,8 +204,11 @@ static void mpiio_dump_array(const std::string &fn, T *arr, size_t len,
  *
  * \param fn The filename to write to
  * \param fields The dumped fields
+ * \param precision The quantization step, only written if
+ *        MPIIO_OUT_QUANTIZED is set in fields.
  */
-static void dump_info(const std::string &fn, unsigned fields) {
+static void dump_info(const std::string &fn, unsigned fields,
+                      double precision) {
   static std::vector<int> npartners;
   int success;
   FILE *f = fopen(fn.c_str(), "wb");
@@ -140,6 +234,8 @@ static void dump_info(const std::string &fn, unsigned fields) {
   success =
       success && (fwrite(npartners.data(), sizeof(int), bonded_ia_params.size(),
                          f) == bonded_ia_params.size());
+  if (fields & MPIIO_OUT_QUANTIZED)
+    success = success && (fwrite(&precision, sizeof(double), 1, f) == 1);
   fclose(f);
   if (!success) {
     fprintf(stderr, "MPI-IO Error: Failed to write %s.\n", fn.c_str());
@@ -147,14 +243,68 @@ static void dump_info(const std::string &fn, unsigned fields) {
   }
 }
 
-void mpi_mpiio_common_write(const char *filename, unsigned fields) {
+/** Dumps a variable amount of bytes per process to fn. The byte
+ *  offset of each process is dumped to the file offset_fn. buf and pref
+ *  have to stay valid until the write is completed.
+ */
+static void mpiio_dump_chunk(const std::string &fn,
+                             const std::string &offset_fn,
+                             std::vector<char> &buf, int rank, long long &pref,
+                             PendingWrite &w) {
+  long long nbytes = buf.size();
+  pref = 0;
+  MPI_Exscan(&nbytes, &pref, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+  mpiio_dump_array<long long>(offset_fn, &pref, 1, rank, MPI_LONG_LONG, w);
+  mpiio_dump_array<char>(fn, buf.data(), buf.size(), pref, MPI_BYTE, w);
+}
+
+/** Quantizes and compresses n 3d vectors and dumps them to fn. The
+ *  byte offset of each process is dumped to the file offset_fn.
+ */
+static void mpiio_dump_quantized(const std::string &fn,
+                                 const std::string &offset_fn,
+                                 std::vector<double> const &values, int n,
+                                 double precision, bool delta, int rank,
+                                 std::vector<char> &buf, long long &pref,
+                                 PendingWrite &w) {
+  buf.clear();
+  QuantizedCodec::encode(values.data(), n, precision, delta, buf);
+  mpiio_dump_chunk(fn, offset_fn, buf, rank, pref, w);
+}
+
+void mpi_mpiio_common_write(const char *filename, unsigned fields, bool async,
+                            double precision) {
   std::string fnam(filename);
   int nlocalpart = cells_get_n_particles(), pref = 0, bpref = 0;
   int rank;
-  // Keep static buffers in order not having to allocate them on every
-  // function call
-  static std::vector<double> pos, vel;
-  static std::vector<int> id, type, boff, bond;
+
+  if (precision > 0.)
+    fields |= MPIIO_OUT_QUANTIZED;
+  else
+    fields &= ~MPIIO_OUT_QUANTIZED;
+
+  // Bound the number of writes in flight
+  if (pending_writes.size() >= max_pending_writes) {
+    complete_write(*pending_writes.front());
+    spare_writes.push_back(std::move(pending_writes.front()));
+    pending_writes.pop_front();
+  }
+
+  // Reuse the buffers of a completed write in order not having to
+  // allocate them on every function call
+  std::unique_ptr<PendingWrite> w;
+  if (spare_writes.empty()) {
+    w = std::make_unique<PendingWrite>();
+  } else {
+    w = std::move(spare_writes.back());
+    spare_writes.pop_back();
+  }
+  auto &pos = w->pos;
+  auto &vel = w->vel;
+  auto &id = w->id;
+  auto &type = w->type;
+  auto &boff = w->boff;
+  auto &bond = w->bond;
 
   // Nlocalpart prefixes
   // Prefixes based for arrays: 3 * pref for vel, pos.
@@ -199,18 +349,31 @@ void mpi_mpiio_common_write(const char *filename, unsigned fields) {
 
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   if (rank == 0)
-    dump_info(fnam + ".head", fields);
-  mpiio_dump_array<int>(fnam + ".pref", &pref, 1, rank, MPI_INT);
-  mpiio_dump_array<int>(fnam + ".id", id.data(), nlocalpart, pref, MPI_INT);
-  if (fields & MPIIO_OUT_POS)
-    mpiio_dump_array<double>(fnam + ".pos", pos.data(), 3 * nlocalpart,
-                             3 * pref, MPI_DOUBLE);
-  if (fields & MPIIO_OUT_VEL)
-    mpiio_dump_array<double>(fnam + ".vel", vel.data(), 3 * nlocalpart,
-                             3 * pref, MPI_DOUBLE);
+    dump_info(fnam + ".head", fields, precision);
+  w->pref = pref;
+  mpiio_dump_array<int>(fnam + ".pref", &w->pref, 1, rank, MPI_INT, *w);
+  mpiio_dump_array<int>(fnam + ".id", id.data(), nlocalpart, pref, MPI_INT,
+                        *w);
+  if (fields & MPIIO_OUT_QUANTIZED) {
+    // Positions are stored as differences, consecutive particles
+    // are from the same cell.
+    if (fields & MPIIO_OUT_POS)
+      mpiio_dump_quantized(fnam + ".pos", fnam + ".poff", pos, nlocalpart,
+                           precision, true, rank, w->qpos, w->qpos_pref, *w);
+    if (fields & MPIIO_OUT_VEL)
+      mpiio_dump_quantized(fnam + ".vel", fnam + ".voff", vel, nlocalpart,
+                           precision, false, rank, w->qvel, w->qvel_pref, *w);
+  } else {
+    if (fields & MPIIO_OUT_POS)
+      mpiio_dump_array<double>(fnam + ".pos", pos.data(), 3 * nlocalpart,
+                               3 * pref, MPI_DOUBLE, *w);
+    if (fields & MPIIO_OUT_VEL)
+      mpiio_dump_array<double>(fnam + ".vel", vel.data(), 3 * nlocalpart,
+                               3 * pref, MPI_DOUBLE, *w);
+  }
   if (fields & MPIIO_OUT_TYP)
     mpiio_dump_array<int>(fnam + ".type", type.data(), nlocalpart, pref,
-                          MPI_INT);
+                          MPI_INT, *w);
 
   if (fields & MPIIO_OUT_BND) {
     // Convert the bond counts to bond prefixes
@@ -232,9 +395,16 @@ void mpi_mpiio_common_write(const char *filename, unsigned fields) {
     // Determine the prefixes in the bond file
     MPI_Exscan(&numbonds, &bpref, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
     mpiio_dump_array<int>(fnam + ".boff", boff.data(), nlocalpart + 1,
-                          pref + rank, MPI_INT);
+                          pref + rank, MPI_INT, *w);
     mpiio_dump_array<int>(fnam + ".bond", bond.data(), numbonds, bpref,
-                          MPI_INT);
+                          MPI_INT, *w);
+  }
+
+  if (async) {
+    pending_writes.push_back(std::move(w));
+  } else {
+    complete_write(*w);
+    spare_writes.push_back(std::move(w));
   }
 }
 
@@ -292,15 +462,19 @@ static void mpiio_read_array(const std::string &fn, T *arr, size_t len,
   }
 }
 
-/** Read the header file and store the information in the pointer
- *  "field". To be called by all processes.
+/** Read the header file and store the information in the pointers
+ *  "field" and "precision". To be called by all processes.
  *
  * \param fn Filename of the head file
  * \param rank The rank of the current process in MPI_COMM_WORLD
  * \param fields Pointer to store the fields to
+ * \param precision Pointer to store the quantization step to, 0 if
+ *        the data is not quantized
  */
-static void read_head(const std::string &fn, int rank, unsigned *fields) {
+static void read_head(const std::string &fn, int rank, unsigned *fields,
+                      double *precision) {
   FILE *f = nullptr;
+  *precision = 0.;
   if (rank == 0) {
     if (!(f = fopen(fn.c_str(), "rb"))) {
       fprintf(stderr, "MPI-IO: Could not open %s.head.\n", fn.c_str());
@@ -310,10 +484,22 @@ static void read_head(const std::string &fn, int rank, unsigned *fields) {
       fprintf(stderr, "MPI-IO: Read on %s.head failed.\n", fn.c_str());
       errexit();
     }
+    if (*fields & MPIIO_OUT_QUANTIZED) {
+      // Skip the bond information
+      size_t ia_params_size;
+      if (fread(&ia_params_size, sizeof(size_t), 1, f) != 1 ||
+          fseek(f, ia_params_size * sizeof(int), SEEK_CUR) != 0 ||
+          fread(precision, sizeof(double), 1, f) != 1) {
+        fprintf(stderr, "MPI-IO: Read on %s.head failed.\n", fn.c_str());
+        errexit();
+      }
+    }
     MPI_Bcast(fields, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+    MPI_Bcast(precision, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
     fclose(f);
   } else {
     MPI_Bcast(fields, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+    MPI_Bcast(precision, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
   }
 }
 
@@ -340,11 +526,90 @@ static void read_prefs(const std::string &fn, int rank, int size,
   *nlocalpart -= *pref;
 }
 
+/** Reads the bytes dumped by mpiio_dump_chunk for this process.
+ *  Needs to be called by all processes.
+ *
+ * \param fn The file name of the data
+ * \param offset_fn The file name of the byte offsets
+ * \param rank The rank of the current process in MPI_COMM_WORLD
+ * \param size The size of MPI_COMM_WORLD
+ */
+static std::vector<char> mpiio_read_chunk(const std::string &fn,
+                                          const std::string &offset_fn,
+                                          int rank, int size) {
+  long long pref, end;
+  mpiio_read_array<long long>(offset_fn, &pref, 1, rank, MPI_LONG_LONG);
+  if (rank > 0)
+    MPI_Send(&pref, 1, MPI_LONG_LONG, rank - 1, 0, MPI_COMM_WORLD);
+  if (rank < size - 1)
+    MPI_Recv(&end, 1, MPI_LONG_LONG, rank + 1, MPI_ANY_TAG, MPI_COMM_WORLD,
+             MPI_STATUS_IGNORE);
+  else
+    end = get_num_elem(fn, 1);
+
+  std::vector<char> buf(end - pref);
+  mpiio_read_array<char>(fn, buf.data(), buf.size(), pref, MPI_BYTE);
+
+  return buf;
+}
+
+/** Reads n 3d vectors dumped by mpiio_dump_quantized. Needs to be
+ *  called by all processes.
+ *
+ * \param fn The file name of the compressed data
+ * \param offset_fn The file name of the byte offsets
+ * \param rank The rank of the current process in MPI_COMM_WORLD
+ * \param size The size of MPI_COMM_WORLD
+ * \param n The number of local vectors
+ * \param precision The quantization step
+ * \param delta Whether differences were stored
+ * \param values Output, 3 * n values
+ */
+static void mpiio_read_quantized(const std::string &fn,
+                                 const std::string &offset_fn, int rank,
+                                 int size, int n, double precision, bool delta,
+                                 std::vector<double> &values) {
+  auto const buf = mpiio_read_chunk(fn, offset_fn, rank, size);
+
+  values.resize(3 * n);
+  if (!QuantizedCodec::decode(buf.data(), buf.data() + buf.size(), n,
+                              precision, delta, values.data())) {
+    fprintf(stderr, "MPI-IO Error: Corrupt data in file \"%s\".\n",
+            fn.c_str());
+    errexit();
+  }
+}
+
+/** Creates a particle at pos on this node. Quantized positions can lie
+ * just outside of the local domain, such particles are put into the
+ * first local cell and moved to their node by the global resort at the
+ * end of the read.
+ *
+ * \param id The id of the particle
+ * \param pos The unfolded position
+ */
+static void place_read_particle(int id, const double *pos) {
+  Particle p;
+  p.p.identity = id;
+  p.r.p = {pos[0], pos[1], pos[2]};
+  fold_position(p.r.p, p.l.i);
+#ifdef BOND_CONSTRAINT
+  p.r.p_old = p.r.p;
+#endif
+
+  auto cell = cell_structure.position_to_cell(p.r.p);
+  append_indexed_particle(cell ? cell : local_cells.cell[0], std::move(p));
+}
+
 void mpi_mpiio_common_read(const char *filename, unsigned fields) {
   std::string fnam(filename);
   int size, rank;
   int nproc, nglobalpart, pref, nlocalpart, nlocalbond, bpref;
   unsigned avail_fields;
+  double precision;
+
+  // The files may still be written to
+  mpi_mpiio_common_flush();
 
   local_remove_all_particles();
 
@@ -362,7 +627,7 @@ void mpi_mpiio_common_read(const char *filename, unsigned fields) {
   // 1.head on master node:
   // Read head to determine fields at time of writing.
   // Compare this var to the current fields.
-  read_head(fnam + ".head", rank, &avail_fields);
+  read_head(fnam + ".head", rank, &avail_fields, &precision);
   if (rank == 0 && (fields & avail_fields) != fields) {
     fprintf(stderr,
             "MPI-IO Error: Requesting to read fields which were not dumped.\n");
@@ -392,11 +657,15 @@ void mpi_mpiio_common_read(const char *filename, unsigned fields) {
     // 1.pos on all nodes:
     // Read nlocalpart * 3 doubles at defined prefix * 3
     std::vector<double> pos(3 * nlocalpart);
-    mpiio_read_array<double>(fnam + ".pos", pos.data(), 3 * nlocalpart,
-                             3 * pref, MPI_DOUBLE);
+    if (avail_fields & MPIIO_OUT_QUANTIZED)
+      mpiio_read_quantized(fnam + ".pos", fnam + ".poff", rank, size,
+                           nlocalpart, precision, true, pos);
+    else
+      mpiio_read_array<double>(fnam + ".pos", pos.data(), 3 * nlocalpart,
+                               3 * pref, MPI_DOUBLE);
 
     for (int i = 0; i < nlocalpart; ++i) {
-      local_place_particle(id[i], &pos[3 * i], 1);
+      place_read_particle(id[i], &pos[3 * i]);
     }
   }
 
@@ -415,8 +684,12 @@ void mpi_mpiio_common_read(const char *filename, unsigned fields) {
     // 1.vel on all nodes:
     // Read nlocalpart * 3 doubles at defined prefix * 3
     std::vector<double> vel(3 * nlocalpart);
-    mpiio_read_array<double>(fnam + ".vel", vel.data(), 3 * nlocalpart,
-                             3 * pref, MPI_DOUBLE);
+    if (avail_fields & MPIIO_OUT_QUANTIZED)
+      mpiio_read_quantized(fnam + ".vel", fnam + ".voff", rank, size,
+                           nlocalpart, precision, false, vel);
+    else
+      mpiio_read_array<double>(fnam + ".vel", vel.data(), 3 * nlocalpart,
+                               3 * pref, MPI_DOUBLE);
 
     for (int i = 0; i < nlocalpart; ++i)
       for (int k = 0; k < 3; ++k)
@@ -457,4 +730,318 @@ void mpi_mpiio_common_read(const char *filename, unsigned fields) {
   set_resort_particles(Cells::RESORT_GLOBAL);
 }
 
+namespace {
+/** Global part of a checkpoint. */
+struct CheckpointHead {
+  int n_nodes;
+  int n_part;
+  int max_seen_particle;
+  /** Particles are stored as raw memory, so the features have to match. */
+  unsigned long long particle_size;
+  /** Philox counters of the thermostats, if initialized. */
+  boost::optional<uint64_t> langevin_counter;
+  boost::optional<uint64_t> dpd_counter;
+  boost::optional<uint64_t> npt_iso_counter;
+  boost::optional<uint64_t> thermalized_bond_counter;
+  /** Global grid of the CPU LB fluid, if stored. */
+  boost::optional<std::array<int, 3>> lb_grid;
+  boost::optional<uint64_t> lb_fluid_counter;
+  boost::optional<uint64_t> lb_coupling_counter;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &n_nodes &n_part &max_seen_particle &particle_size &langevin_counter
+        &dpd_counter &npt_iso_counter &thermalized_bond_counter &lb_grid
+        &lb_fluid_counter &lb_coupling_counter;
+  }
+};
+
+/** Buffers of a checkpoint write, kept in order not having to allocate
+ *  them on every function call.
+ */
+struct CheckpointBuffers {
+  std::vector<char> head, part;
+  std::vector<double> lb;
+  long long part_pref;
+} checkpoint_buffers;
+
+template <class T> void serialize_to(T const &t, std::vector<char> &buf) {
+  namespace io = boost::iostreams;
+  buf.clear();
+  io::stream<io::back_insert_device<std::vector<char>>> os(buf);
+  boost::archive::binary_oarchive oa(os, boost::archive::no_header);
+  oa << t;
+}
+
+/** MPI datatype of the local part of the LB populations in a file storing
+ *  all nodes in the order of Utils::get_linear_index.
+ */
+MPI_Datatype lb_file_type() {
+  MPI_Datatype type;
+  auto const &l = lblattice;
+  int const sizes[4] = {l.global_grid[2], l.global_grid[1], l.global_grid[0],
+                        19};
+  int const subsizes[4] = {l.grid[2], l.grid[1], l.grid[0], 19};
+  /* All nodes have the same number of LB nodes, see
+     Lattice::map_lattice_to_node */
+  int const starts[4] = {node_pos[2] * l.grid[2], node_pos[1] * l.grid[1],
+                         node_pos[0] * l.grid[0], 0};
+  MPI_Type_create_subarray(4, sizes, subsizes, starts, MPI_ORDER_C, MPI_DOUBLE,
+                           &type);
+  MPI_Type_commit(&type);
+  return type;
+}
+
+/** Calls f(index, i) for all local LB nodes, where index is the index
+ *  in lbfluid and i the position in the local part of the file.
+ */
+template <class F> void for_each_local_lb_node(F f) {
+  auto const &l = lblattice;
+  int i = 0;
+  for (int z = 1; z <= l.grid[2]; z++)
+    for (int y = 1; y <= l.grid[1]; y++)
+      for (int x = 1; x <= l.grid[0]; x++)
+        f(Utils::get_linear_index(x, y, z, l.halo_grid), i++);
+}
+
+/** Collectively opens fn and sets a view. Aborts on error. */
+MPI_File mpiio_open_view(const std::string &fn, int amode, MPI_Datatype etype,
+                         MPI_Datatype filetype) {
+  MPI_File f;
+  auto ret = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(fn.c_str()),
+                           amode, MPI_INFO_NULL, &f);
+  if (ret) {
+    fprintf(stderr, "MPI-IO Error: Could not open file \"%s\".\n", fn.c_str());
+    errexit();
+  }
+  ret = MPI_File_set_view(f, 0, etype, filetype, const_cast<char *>("native"),
+                          MPI_INFO_NULL);
+  if (ret) {
+    fprintf(stderr, "MPI-IO Error: Could not set view on \"%s\".\n",
+            fn.c_str());
+    errexit();
+  }
+  return f;
+}
+} // namespace
+
+void mpi_mpiio_checkpoint_write(const char *filename) {
+  std::string fnam(filename);
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  auto &buf = checkpoint_buffers;
+
+  mpi_mpiio_common_flush();
+
+  // Global state, only the head node writes data
+  CheckpointHead head;
+  head.n_nodes = size;
+  head.n_part = n_part;
+  head.max_seen_particle = max_seen_particle;
+  head.particle_size = sizeof(Particle);
+  if (langevin_rng_counter)
+    head.langevin_counter = langevin_rng_counter->value();
+#ifdef DPD
+  if (dpd_rng_counter)
+    head.dpd_counter = dpd_rng_counter->value();
+#endif
+#ifdef NPT
+  if (npt_iso_rng_counter)
+    head.npt_iso_counter = npt_iso_rng_counter->value();
+#endif
+  if (thermalized_bond_rng_counter)
+    head.thermalized_bond_counter = thermalized_bond_rng_counter->value();
+#ifdef LB
+  if (lattice_switch == ActiveLB::CPU) {
+    auto const &g = lblattice.global_grid;
+    head.lb_grid = std::array<int, 3>{{g[0], g[1], g[2]}};
+    if (rng_counter_fluid)
+      head.lb_fluid_counter = rng_counter_fluid->value();
+    if (lb_particle_coupling.rng_counter_coupling)
+      head.lb_coupling_counter =
+          lb_particle_coupling.rng_counter_coupling->value();
+  }
+#endif
+  serialize_to(head, buf.head);
+
+  // Local particles and the state of the local random number generator
+  {
+    namespace io = boost::iostreams;
+    buf.part.clear();
+    io::stream<io::back_insert_device<std::vector<char>>> os(buf.part);
+    boost::archive::binary_oarchive oa(os, boost::archive::no_header);
+
+    std::ostringstream rng_state;
+    rng_state << Random::generator;
+    oa << rng_state.str();
+
+    auto const particles = local_cells.particles();
+    int n = particles.size();
+    oa << n;
+    for (auto const &p : particles)
+      oa << p;
+  }
+
+  PendingWrite w;
+  mpiio_dump_array<char>(fnam + ".chead", buf.head.data(),
+                         (rank == 0) ? buf.head.size() : 0, 0, MPI_BYTE, w);
+  mpiio_dump_chunk(fnam + ".cpart", fnam + ".coff", buf.part, rank,
+                   buf.part_pref, w);
+
+#ifdef LB
+  if (head.lb_grid) {
+    auto const n_nodes = lblattice.grid[0] * lblattice.grid[1] *
+                         lblattice.grid[2];
+    buf.lb.resize(19 * n_nodes);
+    for_each_local_lb_node([&](int index, int i) {
+      for (int q = 0; q < 19; q++)
+        buf.lb[19 * i + q] = lbfluid[q][index];
+    });
+
+    auto filetype = lb_file_type();
+    auto f = mpiio_open_view(fnam + ".clb",
+                             MPI_MODE_WRONLY | MPI_MODE_CREATE | MPI_MODE_EXCL,
+                             MPI_DOUBLE, filetype);
+    auto const ret = MPI_File_write_all(f, buf.lb.data(), buf.lb.size(),
+                                        MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_close(&f);
+    MPI_Type_free(&filetype);
+    if (ret) {
+      fprintf(stderr, "MPI-IO Error: Could not write file \"%s.clb\".\n",
+              fnam.c_str());
+      errexit();
+    }
+  }
+#endif
+
+  complete_write(w);
+}
+
+void mpi_mpiio_checkpoint_read(const char *filename) {
+  namespace io = boost::iostreams;
+  std::string fnam(filename);
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  mpi_mpiio_common_flush();
+
+  // Every process reads the head
+  CheckpointHead head;
+  {
+    std::vector<char> buf(get_num_elem(fnam + ".chead", 1));
+    mpiio_read_array<char>(fnam + ".chead", buf.data(), buf.size(), 0,
+                           MPI_BYTE);
+    io::stream<io::array_source> is(buf.data(), buf.size());
+    boost::archive::binary_iarchive ia(is, boost::archive::no_header);
+    ia >> head;
+  }
+
+  if (head.n_nodes != size) {
+    if (rank == 0)
+      fprintf(stderr, "MPI-IO Error: Trying to read a checkpoint with a "
+                      "different COMM size than at point of writing.\n");
+    errexit();
+  }
+  if (head.particle_size != sizeof(Particle)) {
+    if (rank == 0)
+      fprintf(stderr, "MPI-IO Error: The checkpoint was written with a "
+                      "different set of features.\n");
+    errexit();
+  }
+
+  local_remove_all_particles();
+  realloc_local_particles(head.max_seen_particle);
+  max_seen_particle = head.max_seen_particle;
+  n_part = head.n_part;
+
+  {
+    auto const buf = mpiio_read_chunk(fnam + ".cpart", fnam + ".coff", rank,
+                                      size);
+    io::stream<io::array_source> is(buf.data(), buf.size());
+    boost::archive::binary_iarchive ia(is, boost::archive::no_header);
+
+    std::string rng_state;
+    ia >> rng_state;
+    std::istringstream(rng_state) >> Random::generator;
+
+    int n;
+    ia >> n;
+    for (int i = 0; i < n; i++) {
+      Particle p;
+      ia >> p;
+      // The cell system may have changed, particles which do not belong
+      // to a local cell are sorted out by the global resort below.
+      auto cell = cell_structure.position_to_cell(p.r.p);
+      append_indexed_particle(cell ? cell : local_cells.cell[0], std::move(p));
+    }
+  }
+
+  if (head.langevin_counter)
+    langevin_rng_counter =
+        std::make_unique<Utils::Counter<uint64_t>>(*head.langevin_counter);
+#ifdef DPD
+  if (head.dpd_counter)
+    dpd_rng_counter =
+        std::make_unique<Utils::Counter<uint64_t>>(*head.dpd_counter);
+#endif
+#ifdef NPT
+  if (head.npt_iso_counter)
+    npt_iso_rng_counter =
+        std::make_unique<Utils::Counter<uint64_t>>(*head.npt_iso_counter);
+#endif
+  if (head.thermalized_bond_counter)
+    thermalized_bond_rng_counter = std::make_unique<Utils::Counter<uint64_t>>(
+        *head.thermalized_bond_counter);
+
+  if (head.lb_grid) {
+#ifdef LB
+    auto const &g = lblattice.global_grid;
+    if (lattice_switch != ActiveLB::CPU or (*head.lb_grid)[0] != g[0] or
+        (*head.lb_grid)[1] != g[1] or (*head.lb_grid)[2] != g[2]) {
+      if (rank == 0)
+        fprintf(stderr, "MPI-IO Error: The checkpoint requires a CPU LB fluid "
+                        "with the same grid size.\n");
+      errexit();
+    }
+
+    auto &lb = checkpoint_buffers.lb;
+    lb.resize(19 * lblattice.grid[0] * lblattice.grid[1] * lblattice.grid[2]);
+    auto filetype = lb_file_type();
+    auto f = mpiio_open_view(fnam + ".clb", MPI_MODE_RDONLY, MPI_DOUBLE,
+                             filetype);
+    auto const ret = MPI_File_read_all(f, lb.data(), lb.size(), MPI_DOUBLE,
+                                       MPI_STATUS_IGNORE);
+    MPI_File_close(&f);
+    MPI_Type_free(&filetype);
+    if (ret) {
+      fprintf(stderr, "MPI-IO Error: Could not read file \"%s.clb\".\n",
+              fnam.c_str());
+      errexit();
+    }
+    for_each_local_lb_node([&](int index, int i) {
+      for (int q = 0; q < 19; q++)
+        lbfluid[q][index] = lb[19 * i + q];
+    });
+
+    if (head.lb_fluid_counter)
+      rng_counter_fluid = Utils::Counter<uint64_t>(*head.lb_fluid_counter);
+    if (head.lb_coupling_counter)
+      lb_particle_coupling.rng_counter_coupling =
+          Utils::Counter<uint64_t>(*head.lb_coupling_counter);
+#else
+    if (rank == 0)
+      fprintf(stderr, "MPI-IO Error: The checkpoint contains a LB fluid, "
+                      "but ESPResSo was compiled without LB.\n");
+    errexit();
+#endif
+  }
+
+  if (rank == 0)
+    clear_particle_node();
+
+  on_particle_change();
+  set_resort_particles(Cells::RESORT_GLOBAL);
+}
+
 } // namespace Mpiio
@@ -36,6 +36,9 @@ enum MPIIOOutputFields : unsigned int {
   MPIIO_OUT_VEL = 2u,
   MPIIO_OUT_TYP = 4u,
   MPIIO_OUT_BND = 8u,
+  /** Positions and velocities are quantized and compressed. Set from
+   *  the precision argument of @ref mpi_mpiio_common_write. */
+  MPIIO_OUT_QUANTIZED = 16u,
 };
 
 /** Parallel binary output using MPI-IO. To be called by all MPI
@@ -43,8 +46,24 @@ enum MPIIOOutputFields : unsigned int {
  *
  * \param filename A null-terminated filename prefix.
  * \param fields Output specifier which fields to dump.
+ * \param async If true, return as soon as the data is copied into
+ *        output buffers. The files are written with non-blocking
+ *        MPI-IO and are complete after @ref mpi_mpiio_common_flush,
+ *        which the Python interface also calls at exit.
+ *        At most two writes are in flight, a further write first waits
+ *        for the oldest one.
+ * \param precision If positive, positions and velocities are rounded
+ *        to multiples of precision and stored compressed, see
+ *        quantized_codec.hpp. The files can only be read by
+ *        @ref mpi_mpiio_common_read.
  */
-void mpi_mpiio_common_write(const char *filename, unsigned fields);
+void mpi_mpiio_common_write(const char *filename, unsigned fields,
+                            bool async = false, double precision = 0.);
+
+/** Wait for all asynchronous writes to complete. To be called by all
+ * MPI processes. Aborts ESPResSo if an error occurs.
+ */
+void mpi_mpiio_common_flush();
 
 /** Parallel binary input using MPI-IO. To be called by all MPI
  * processes. Aborts ESPResSo if an error occurs.
@@ -54,6 +73,27 @@ void mpi_mpiio_common_write(const char *filename, unsigned fields);
  */
 void mpi_mpiio_common_read(const char *filename, unsigned fields);
 
+/** Write a checkpoint of the particles, the CPU LB fluid and the states
+ * of the random number generators using MPI-IO. Every process writes
+ * its own particles and LB nodes collectively, no data is collected on
+ * the head node. Interactions and other global parameters are not
+ * stored. To be called by all MPI processes. Aborts ESPResSo if an
+ * error occurs.
+ *
+ * \param filename A null-terminated filename prefix.
+ */
+void mpi_mpiio_checkpoint_write(const char *filename);
+
+/** Restore a checkpoint written by @ref mpi_mpiio_checkpoint_write. All
+ * existing particles are removed. The number of processes, the compiled
+ * features and, if the checkpoint contains a LB fluid, the LB grid have
+ * to be the same as at the time of writing. To be called by all MPI
+ * processes. Aborts ESPResSo if an error occurs.
+ *
+ * \param filename A null-terminated filename prefix.
+ */
+void mpi_mpiio_checkpoint_read(const char *filename);
+
 } // namespace Mpiio
 
 #endif
@@ -0,0 +1,120 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *  Lossy compression of 3d vectors for the MPI-IO output.
+ *
+ *  The values are rounded to integer multiples of a fixed precision.
+ *  The resulting integers are stored component by component, i.e. all
+ *  x values, then all y values and then all z values, optionally as
+ *  differences to the value of the previous vector. Each integer is
+ *  zigzag encoded and written as a variable length quantity of 7 bits
+ *  per byte, so small differences take a single byte.
+ *
+ *  The particles of one cell are spatially close, so the differences
+ *  of consecutive positions are small compared to the box length.
+ */
+
+#ifndef ESPRESSO_MPIIO_QUANTIZED_CODEC_HPP
+#define ESPRESSO_MPIIO_QUANTIZED_CODEC_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mpiio {
+namespace QuantizedCodec {
+
+inline std::uint64_t zigzag(std::int64_t v) {
+  return (static_cast<std::uint64_t>(v) << 1) ^
+         static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t v) {
+  return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+/** @brief Append the compressed representation of n 3d vectors.
+ *
+ *  @param values 3 * n values.
+ *  @param n Number of vectors.
+ *  @param precision Quantization step, the absolute error of each
+ *         value is at most precision / 2.
+ *  @param delta Store differences of consecutive vectors.
+ *  @param out Buffer the bytes are appended to.
+ */
+inline void encode(double const *values, std::size_t n, double precision,
+                   bool delta, std::vector<char> &out) {
+  for (std::size_t k = 0; k < 3; ++k) {
+    std::int64_t prev = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      auto const q = std::llround(values[3 * i + k] / precision);
+      auto u = zigzag(q - prev);
+      if (delta)
+        prev = q;
+
+      while (u >= 0x80) {
+        out.push_back(static_cast<char>((u & 0x7f) | 0x80));
+        u >>= 7;
+      }
+      out.push_back(static_cast<char>(u));
+    }
+  }
+}
+
+/** @brief Decode n 3d vectors written by @ref encode.
+ *
+ *  @param begin Start of the compressed data.
+ *  @param end End of the compressed data.
+ *  @param n Number of vectors.
+ *  @param precision Quantization step used for encoding.
+ *  @param delta Whether differences were stored.
+ *  @param values Output, 3 * n values.
+ *  @return False if the data is truncated.
+ */
+inline bool decode(char const *begin, char const *end, std::size_t n,
+                   double precision, bool delta, double *values) {
+  auto it = begin;
+  for (std::size_t k = 0; k < 3; ++k) {
+    std::int64_t prev = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      std::uint64_t u = 0;
+      for (unsigned shift = 0;; shift += 7) {
+        if (it == end or shift > 63)
+          return false;
+        auto const byte = static_cast<unsigned char>(*it++);
+        u |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (not(byte & 0x80))
+          break;
+      }
+
+      auto const q = prev + unzigzag(u);
+      if (delta)
+        prev = q;
+      values[3 * i + k] = static_cast<double>(q) * precision;
+    }
+  }
+
+  return true;
+}
+
+} // namespace QuantizedCodec
+} // namespace Mpiio
+
+#endif
@@ -0,0 +1,169 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "mpiio_reader.hpp"
+
+#include "mpiio.hpp"
+#include "quantized_codec.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace Reader {
+
+MappedFile::MappedFile(std::string const &filename) {
+  auto const fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Could not open " + filename + ": " +
+                             strerror(errno));
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not get file size of " + filename);
+  }
+
+  m_size = static_cast<std::size_t>(st.st_size);
+  // Mapping an empty file is an error, keep m_data a nullptr instead.
+  if (m_size > 0) {
+    auto const addr = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map " + filename + ": " +
+                               strerror(errno));
+    }
+    m_data = static_cast<char const *>(addr);
+  }
+  close(fd);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_data(other.m_data), m_size(other.m_size) {
+  other.m_data = nullptr;
+  other.m_size = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  if (m_data)
+    munmap(const_cast<char *>(m_data), m_size);
+}
+
+namespace {
+/** Fields and precision from the head file, see dump_info in mpiio.cpp. */
+std::pair<unsigned, double> read_head(std::string const &filename) {
+  MappedFile head(filename);
+  auto p = head.data();
+  auto const end = p + head.size();
+
+  auto read = [&](void *dst, std::size_t n) {
+    if (p + n > end)
+      throw std::runtime_error("Truncated file " + filename);
+    std::memcpy(dst, p, n);
+    p += n;
+  };
+
+  unsigned fields;
+  double precision = 0.;
+  read(&fields, sizeof(fields));
+  if (fields & Mpiio::MPIIO_OUT_QUANTIZED) {
+    std::size_t ia_params_size;
+    read(&ia_params_size, sizeof(ia_params_size));
+    p += ia_params_size * sizeof(int);
+    read(&precision, sizeof(precision));
+  }
+
+  return {fields, precision};
+}
+} // namespace
+
+Utils::Span<const double>
+MpiioFrame::vectors(std::string const &prefix, std::string const &ext,
+                    std::string const &offset_ext, bool delta,
+                    MappedFile &file, std::vector<double> &decoded) {
+  file = MappedFile(prefix + ext);
+
+  if (not(m_fields & Mpiio::MPIIO_OUT_QUANTIZED)) {
+    auto const values = file.as<double>();
+    if (values.size() != 3 * m_ids.size())
+      throw std::runtime_error("Inconsistent size of " + prefix + ext);
+    return values;
+  }
+
+  // Every rank compressed its particles separately
+  MappedFile offset_file(prefix + offset_ext);
+  auto const offsets = offset_file.as<long long>();
+  if (offsets.size() != m_pref.size())
+    throw std::runtime_error("Inconsistent size of " + prefix + offset_ext);
+
+  decoded.resize(3 * m_ids.size());
+  for (std::size_t rank = 0; rank < offsets.size(); rank++) {
+    auto const last = rank + 1 == offsets.size();
+    auto const begin = static_cast<std::size_t>(offsets[rank]);
+    auto const end =
+        last ? file.size() : static_cast<std::size_t>(offsets[rank + 1]);
+    auto const first_part = static_cast<std::size_t>(m_pref[rank]);
+    auto const n =
+        (last ? m_ids.size() : static_cast<std::size_t>(m_pref[rank + 1])) -
+        first_part;
+
+    if (begin > end or end > file.size() or
+        not Mpiio::QuantizedCodec::decode(
+            file.data() + begin, file.data() + end, n, m_precision, delta,
+            decoded.data() + 3 * first_part))
+      throw std::runtime_error("Corrupt data in " + prefix + ext);
+  }
+
+  return {decoded.data(), decoded.size()};
+}
+
+MpiioFrame::MpiioFrame(std::string const &prefix) {
+  std::tie(m_fields, m_precision) = read_head(prefix + ".head");
+
+  m_pref_file = MappedFile(prefix + ".pref");
+  m_pref = m_pref_file.as<int>();
+  m_id_file = MappedFile(prefix + ".id");
+  m_ids = m_id_file.as<int>();
+
+  if (m_fields & Mpiio::MPIIO_OUT_POS)
+    m_pos = vectors(prefix, ".pos", ".poff", true, m_pos_file, m_pos_decoded);
+  if (m_fields & Mpiio::MPIIO_OUT_VEL)
+    m_vel = vectors(prefix, ".vel", ".voff", false, m_vel_file, m_vel_decoded);
+  if (m_fields & Mpiio::MPIIO_OUT_TYP) {
+    m_type_file = MappedFile(prefix + ".type");
+    m_type = m_type_file.as<int>();
+    if (m_type.size() != m_ids.size())
+      throw std::runtime_error("Inconsistent size of " + prefix + ".type");
+  }
+}
+
+} // namespace Reader
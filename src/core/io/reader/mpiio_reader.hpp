@@ -0,0 +1,109 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** \file
+ *  Read-only access to files written by the MPI-IO output
+ *  (@ref Mpiio::mpi_mpiio_common_write) without a running simulation.
+ *
+ *  The files are memory mapped, the arrays returned by @ref
+ *  Reader::MpiioFrame point directly into the mapping. Only quantized
+ *  positions and velocities are decoded into memory owned by the frame.
+ *  The reader does not depend on MPI or the simulation core, frames can be
+ *  processed concurrently by several threads or processes.
+ */
+
+#ifndef ESPRESSO_READER_MPIIO_READER_HPP
+#define ESPRESSO_READER_MPIIO_READER_HPP
+
+#include <utils/Span.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Reader {
+
+/** Read-only memory mapping of a complete file. */
+class MappedFile {
+public:
+  MappedFile() = default;
+  /** @brief Map the file.
+   *  @throws std::runtime_error if the file can not be mapped.
+   */
+  explicit MappedFile(std::string const &filename);
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  ~MappedFile();
+
+  char const *data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+
+  template <class T> Utils::Span<const T> as() const {
+    return {reinterpret_cast<T const *>(m_data), m_size / sizeof(T)};
+  }
+
+private:
+  char const *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+/** One frame of MPI-IO output, i.e. the files with one common prefix. */
+class MpiioFrame {
+public:
+  /** @brief Open the files with the given prefix.
+   *  @throws std::runtime_error if a file is missing or inconsistent.
+   */
+  explicit MpiioFrame(std::string const &prefix);
+
+  /** Dumped fields, see @ref Mpiio::MPIIOOutputFields. */
+  unsigned fields() const { return m_fields; }
+  /** Quantization step, or 0 if positions and velocities are exact. */
+  double precision() const { return m_precision; }
+  /** Number of MPI ranks that wrote the frame. */
+  int n_ranks() const { return static_cast<int>(m_pref.size()); }
+  int n_part() const { return static_cast<int>(m_ids.size()); }
+
+  /** Particle ids in the order of the other arrays. */
+  Utils::Span<const int> ids() const { return m_ids; }
+  /** Folded positions, 3 values per particle, empty if not dumped. */
+  Utils::Span<const double> positions() const { return m_pos; }
+  /** Velocities, 3 values per particle, empty if not dumped. */
+  Utils::Span<const double> velocities() const { return m_vel; }
+  /** Particle types, empty if not dumped. */
+  Utils::Span<const int> types() const { return m_type; }
+
+private:
+  Utils::Span<const double> vectors(std::string const &prefix,
+                                    std::string const &ext,
+                                    std::string const &offset_ext,
+                                    bool delta, MappedFile &file,
+                                    std::vector<double> &decoded);
+
+  unsigned m_fields = 0;
+  double m_precision = 0.;
+  MappedFile m_pref_file, m_id_file, m_pos_file, m_vel_file, m_type_file;
+  Utils::Span<const int> m_pref, m_ids, m_type;
+  Utils::Span<const double> m_pos, m_vel;
+  std::vector<double> m_pos_decoded, m_vel_decoded;
+};
+
+} // namespace Reader
+
+#endif
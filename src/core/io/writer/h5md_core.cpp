@@ -23,11 +23,79 @@
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
+
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 namespace Writer {
 namespace H5md {
 
+/**
+ * @brief Distribute data to the nodes by particle id.
+ *
+ * Node i receives the entries with ids in the i-th of equally sized
+ * id ranges, sorted by id. Together with an exclusive prefix sum
+ * over the number of received entries this is a distributed sort:
+ * the nodes hold consecutive parts of the globally ordered data.
+ *
+ * @param data Local entries, is reordered.
+ * @param recv Entries assigned to this node, sorted by id.
+ * @param key Returns the id of an entry.
+ */
+template <typename T, typename Key>
+static void redistribute_by_id(std::vector<T> &data, std::vector<T> &recv,
+                               Key key, MPI_Comm comm) {
+  int n_nodes, local_max_id = -1, max_id;
+  MPI_Comm_size(comm, &n_nodes);
+  for (auto const &e : data)
+    local_max_id = std::max(local_max_id, key(e));
+  MPI_Allreduce(&local_max_id, &max_id, 1, MPI_INT, MPI_MAX, comm);
+
+  auto const ids_per_node = max_id / n_nodes + 1;
+  auto const compare = [&key](T const &a, T const &b) {
+    return key(a) < key(b);
+  };
+
+  /* Sorting by id also groups the entries by destination. */
+  std::stable_sort(data.begin(), data.end(), compare);
+
+  std::vector<int> send_counts(n_nodes, 0), recv_counts(n_nodes);
+  for (auto const &e : data)
+    send_counts[key(e) / ids_per_node] += sizeof(T);
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT,
+               comm);
+
+  std::vector<int> send_displs(n_nodes, 0), recv_displs(n_nodes, 0);
+  std::partial_sum(send_counts.begin(), std::prev(send_counts.end()),
+                   std::next(send_displs.begin()));
+  std::partial_sum(recv_counts.begin(), std::prev(recv_counts.end()),
+                   std::next(recv_displs.begin()));
+
+  recv.resize((recv_displs.back() + recv_counts.back()) / sizeof(T));
+  MPI_Alltoallv(data.data(), send_counts.data(), send_displs.data(), MPI_BYTE,
+                recv.data(), recv_counts.data(), recv_displs.data(), MPI_BYTE,
+                comm);
+
+  /* Entries with the same id all come from one node, a stable sort
+   * keeps their order. */
+  std::stable_sort(recv.begin(), recv.end(), compare);
+}
+
+/**
+ * @brief Number of particles per chunk of a particle dataset.
+ *
+ * Chunks of about 1 MiB are large enough for efficient I/O and
+ * still fit into the default chunk cache of HDF5. Larger systems
+ * are split into several chunks per frame, which also allows the
+ * collective writes of the nodes to go to different chunks.
+ */
+static hsize_t chunk_particles(hsize_t n_values, size_t type_size) {
+  auto const max_chunk_particles =
+      std::max<hsize_t>(1, (1u << 20) / (n_values * type_size));
+  return std::min<hsize_t>(std::max(n_part, 1), max_chunk_particles);
+}
+
 static void backup_file(const std::string &from, const std::string &to) {
 #ifdef H5MD_DEBUG
   std::cout << "Called " << __func__ << " on node " << this_node << std::endl;
@@ -100,14 +168,18 @@ void File::InitFile() {
   std::cout << "Called " << __func__ << " on node " << this_node << std::endl;
 #endif
   m_backup_filename = m_filename + ".bak";
-  // use a separate mpi communicator if we want to write out ordered data. This
-  // is in order to avoid  blocking by collective functions
-  if (m_write_ordered)
-    MPI_Comm_split(MPI_COMM_WORLD, this_node, 0, &m_hdf5_comm);
-  else
-    m_hdf5_comm = MPI_COMM_WORLD;
-  if (m_write_ordered && this_node != 0)
-    return;
+  /* All nodes write collectively, also in ordered mode. */
+  m_hdf5_comm = MPI_COMM_WORLD;
+  if (m_dxpl < 0) {
+    m_dxpl = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(m_dxpl, H5FD_MPIO_COLLECTIVE);
+  }
+
+  if (m_compression < 0 or m_compression > 9) {
+    throw std::invalid_argument(
+        "The compression of the H5MD file has to be a deflate level "
+        "between 0 and 9.");
+  }
 
   if (n_part <= 0) {
     throw std::runtime_error("Please first set up particles before "
@@ -124,8 +196,7 @@ void File::InitFile() {
   bool backup_file_exists = boost::filesystem::exists(m_backup_filename);
   /* Perform a barrier synchronization. Otherwise one process might already
    * create the file while another still checks for its existence. */
-  if (!m_write_ordered)
-    MPI_Barrier(m_hdf5_comm);
+  MPI_Barrier(m_hdf5_comm);
   if (file_exists) {
     if (check_for_H5MD_structure(m_filename)) {
       /*
@@ -198,16 +269,19 @@ void File::create_datasets(bool only_load) {
       int creation_size_dataset = 0; // creation size of all datasets is 0. Make
                                      // sure to call ExtendDataset before
                                      // writing to dataset
-      int chunk_size = 1;
+      hsize_t chunk_size = 1;
       if (descr.dim > 1) {
         // we deal now with a particle based property, change chunk. Important
         // for IO performance!
-        chunk_size = n_part;
+        chunk_size = chunk_particles(descr.dim == 3 ? 3 : 1,
+                                     H5Tget_size(descr.type.get_type_id()));
       }
       auto dims = create_dims(descr.dim, creation_size_dataset);
       auto chunk_dims = create_chunk_dims(descr.dim, chunk_size, 1);
       auto maxdims = create_maxdims(descr.dim);
       auto storage = h5xx::policy::storage::chunked(chunk_dims);
+      if (descr.dim > 1 and m_compression > 0)
+        storage.add(h5xx::policy::filter::deflate(m_compression));
       if (descr.type.get_type_id() == H5T_NATIVE_INT)
         storage.set(h5xx::policy::storage::fill_value(static_cast<int>(-10)));
       else if (descr.type.get_type_id() == H5T_NATIVE_DOUBLE)
@@ -319,88 +393,64 @@ void File::Close() {
     boost::filesystem::remove(m_backup_filename);
 }
 
-void File::fill_arrays_for_h5md_write_with_particle_property(
-    int particle_index, int_array_3d &id, int_array_3d &typ,
-    double_array_3d &mass, double_array_3d &pos, int_array_3d &image,
-    double_array_3d &vel, double_array_3d &f, double_array_3d &charge,
-    Particle const &current_particle, int write_dat, int_array_3d &bond) {
+File::~File() {
+  if (m_dxpl >= 0)
+    H5Pclose(m_dxpl);
+}
+
+void File::collect_local_records() {
 #ifdef H5MD_DEBUG
-  /* Turn on hdf5 error messages */
   std::cout << "Called " << __func__ << " on node " << this_node << std::endl;
 #endif
-  bool write_species = write_dat & W_TYPE;
-  bool write_pos = write_dat & W_POS;
-  bool write_vel = write_dat & W_V;
-  bool write_force = write_dat & W_F;
-  bool write_mass = write_dat & W_MASS;
-  bool write_charge = write_dat & W_CHARGE;
-
-  id[0][particle_index][0] = current_particle.p.identity;
-  if (write_species)
-    typ[0][particle_index][0] = current_particle.p.type;
-  if (write_mass)
-    mass[0][particle_index][0] = current_particle.p.mass;
-  /* store folded particle positions. */
-  if (write_pos) {
-    Utils::Vector3d p = current_particle.r.p;
-    Utils::Vector3i i = current_particle.l.i;
-    fold_position(p, i);
-
-    pos[0][particle_index][0] = p[0];
-    pos[0][particle_index][1] = p[1];
-    pos[0][particle_index][2] = p[2];
-    image[0][particle_index][0] = i[0];
-    image[0][particle_index][1] = i[1];
-    image[0][particle_index][2] = i[2];
-  }
-
-  if (write_vel) {
-    vel[0][particle_index][0] = current_particle.m.v[0];
-    vel[0][particle_index][1] = current_particle.m.v[1];
-    vel[0][particle_index][2] = current_particle.m.v[2];
-  }
-  if (write_force) {
-    f[0][particle_index][0] = current_particle.f.f[0];
-    f[0][particle_index][1] = current_particle.f.f[1];
-    f[0][particle_index][2] = current_particle.f.f[2];
-  }
-  if (write_charge) {
-#ifdef ELECTROSTATICS
-    charge[0][particle_index][0] = current_particle.p.q;
-#endif
-  }
-
-  if (!m_already_wrote_bonds) {
-    int nbonds_local = bond.shape()[1];
-    for (auto it = current_particle.bl.begin();
-         it != current_particle.bl.end();) {
-
-      auto const n_partners = bonded_ia_params[*it++].num;
-
-      if (1 == n_partners) {
-        bond.resize(boost::extents[1][nbonds_local + 1][2]);
-        bond[0][nbonds_local][0] = current_particle.p.identity;
-        bond[0][nbonds_local][1] = *it++;
-        nbonds_local++;
-      } else {
-        it += n_partners;
+  m_records.clear();
+  m_bonds.clear();
+
+  for (auto const &p : local_cells.particles()) {
+    ParticleRecord r;
+    r.id = p.p.identity;
+    r.type = p.p.type;
+    r.mass = p.p.mass;
+    r.charge = p.p.q;
+    /* store folded particle positions. */
+    r.pos = p.r.p;
+    r.image = p.l.i;
+    fold_position(r.pos, r.image);
+    r.vel = p.m.v;
+    r.f = p.f.f;
+    m_records.push_back(r);
+
+    if (!m_already_wrote_bonds) {
+      for (auto it = p.bl.begin(); it != p.bl.end();) {
+        auto const n_partners = bonded_ia_params[*it++].num;
+
+        if (1 == n_partners) {
+          m_bonds.push_back({{p.p.identity, *it++}});
+        } else {
+          it += n_partners;
+        }
       }
     }
   }
 }
 
-void File::Write(int write_dat, PartCfg &partCfg) {
+template <typename T, typename Getter>
+void File::WriteProperty(const std::string &path, int n_values,
+                         const std::vector<int> &change_extent,
+                         hsize_t *offset, Getter get) {
+  m_write_buffer.resize(m_records.size() * n_values * sizeof(T));
+  auto out = reinterpret_cast<T *>(m_write_buffer.data());
+  for (auto const &r : m_records)
+    out = get(r, out);
+
+  hsize_t count[3] = {1, m_records.size(), static_cast<hsize_t>(n_values)};
+  WriteDataset(reinterpret_cast<T const *>(m_write_buffer.data()), path,
+               change_extent, offset, count);
+}
+
+void File::Write(int write_dat) {
 #ifdef H5MD_DEBUG
   std::cout << "Called " << __func__ << " on node " << this_node << std::endl;
 #endif
-  int num_particles_to_be_written = 0;
-  if (m_write_ordered && this_node == 0)
-    num_particles_to_be_written = n_part;
-  else if (m_write_ordered && this_node != 0)
-    return;
-  else if (!m_write_ordered)
-    num_particles_to_be_written = cells_get_n_particles();
-
   bool write_species = write_dat & W_TYPE;
   bool write_pos = write_dat & W_POS;
   bool write_vel = write_dat & W_V;
@@ -408,49 +458,29 @@ void File::Write(int write_dat, PartCfg &partCfg) {
   bool write_mass = write_dat & W_MASS;
   bool write_charge = write_dat & W_CHARGE;
 
-  double_array_3d pos(boost::extents[1][num_particles_to_be_written][3]);
-  double_array_3d vel(boost::extents[1][num_particles_to_be_written][3]);
-  double_array_3d f(boost::extents[1][num_particles_to_be_written][3]);
-  int_array_3d image(boost::extents[1][num_particles_to_be_written][3]);
-  int_array_3d id(boost::extents[1][num_particles_to_be_written][1]);
-  int_array_3d typ(boost::extents[1][num_particles_to_be_written][1]);
-  double_array_3d mass(boost::extents[1][num_particles_to_be_written][1]);
-  double_array_3d charge(boost::extents[1][num_particles_to_be_written][1]);
-  double_array_3d time(boost::extents[1][1][1]);
-  time[0][0][0] = sim_time;
-  int_array_3d step(boost::extents[1][1][1]);
-  step[0][0][0] = (int)std::round(sim_time / time_step);
-  int_array_3d bond(boost::extents[0][0][0]);
+  collect_local_records();
 
   if (m_write_ordered) {
-    if (this_node == 0) {
-      /* Fetch bond info */
-      partCfg.update_bonds();
-      // loop over all particles
-      int particle_index = 0;
-      for (auto const &current_particle : partCfg) {
-        fill_arrays_for_h5md_write_with_particle_property(
-            particle_index++, id, typ, mass, pos, image, vel, f, charge,
-            current_particle, write_dat, bond);
-      }
-    }
-  } else {
-    /* loop over all local cells. */
-    int particle_index = 0;
-
-    for (auto &current_particle : local_cells.particles()) {
-      fill_arrays_for_h5md_write_with_particle_property(
-          particle_index, id, typ, mass, pos, image, vel, f, charge,
-          current_particle, write_dat, bond);
-      particle_index++;
+    auto const id = [](ParticleRecord const &r) { return r.id; };
+    redistribute_by_id(m_records, m_records_recv, id, m_hdf5_comm);
+    std::swap(m_records, m_records_recv);
+
+    if (!m_already_wrote_bonds) {
+      auto const first = [](std::array<int, 2> const &b) { return b[0]; };
+      redistribute_by_id(m_bonds, m_bonds_recv, first, m_hdf5_comm);
+      std::swap(m_bonds, m_bonds_recv);
     }
   }
 
   // calculate count and offset
+  int num_particles_to_be_written = m_records.size();
   int prefix = 0;
+  int n_part_total = 0;
   // calculate prefix for write of the current process
   MPI_Exscan(&num_particles_to_be_written, &prefix, 1, MPI_INT, MPI_SUM,
              m_hdf5_comm);
+  MPI_Allreduce(&num_particles_to_be_written, &n_part_total, 1, MPI_INT,
+                MPI_SUM, m_hdf5_comm);
   hid_t ds = H5Dget_space(datasets["particles/atoms/id/value"].hid());
   hsize_t dims_id[2], maxdims_id[2];
   H5Sget_simple_extent_dims(ds, dims_id, maxdims_id);
@@ -460,9 +490,8 @@ void File::Write(int write_dat, PartCfg &partCfg) {
   hsize_t offset_2d[2] = {dims_id[0], (hsize_t)prefix};
   hsize_t offset_3d[3] = {dims_id[0], (hsize_t)prefix, 0};
 
-  hsize_t count_1d[1] = {1};
-  hsize_t count_2d[2] = {1, (hsize_t)num_particles_to_be_written};
-  hsize_t count_3d[3] = {1, (hsize_t)num_particles_to_be_written, 3};
+  /* The time and the step are written by the head node only. */
+  hsize_t count_1d[1] = {(this_node == 0) ? 1u : 0u};
 
   // calculate the change of the extent for fluctuating particle numbers
   int old_max_n_part =
@@ -471,8 +500,8 @@ void File::Write(int write_dat, PartCfg &partCfg) {
                                                // previous dimension, if we
                                                // append to an already existing
                                                // dataset
-  if (n_part > old_max_n_part) {
-    m_max_n_part = n_part;
+  if (n_part_total > old_max_n_part) {
+    m_max_n_part = n_part_total;
   } else {
     m_max_n_part = old_max_n_part;
   }
@@ -485,56 +514,85 @@ void File::Write(int write_dat, PartCfg &partCfg) {
   if (!m_already_wrote_bonds) {
     // communicate the total number of bonds to all processes since extending is
     // a collective hdf5 function
-    int nbonds_local = bond.shape()[1];
-    int nbonds_total = nbonds_local;
+    int nbonds_local = m_bonds.size();
+    int nbonds_total = 0;
     int prefix_bonds = 0;
-    if (!m_write_ordered) {
-      MPI_Exscan(&nbonds_local, &prefix_bonds, 1, MPI_INT, MPI_SUM,
-                 m_hdf5_comm);
-      MPI_Allreduce(&nbonds_local, &nbonds_total, 1, MPI_INT, MPI_SUM,
-                    m_hdf5_comm);
-    }
+    MPI_Exscan(&nbonds_local, &prefix_bonds, 1, MPI_INT, MPI_SUM, m_hdf5_comm);
+    MPI_Allreduce(&nbonds_local, &nbonds_total, 1, MPI_INT, MPI_SUM,
+                  m_hdf5_comm);
     hsize_t offset_bonds[2] = {(hsize_t)prefix_bonds, 0};
     hsize_t count_bonds[2] = {(hsize_t)nbonds_local, 2};
     std::vector<int> change_extent_bonds = {nbonds_total, 2};
-    WriteDataset(bond, "connectivity/atoms", change_extent_bonds, offset_bonds,
+    WriteDataset(m_bonds.empty() ? nullptr : m_bonds.front().data(),
+                 "connectivity/atoms", change_extent_bonds, offset_bonds,
                  count_bonds);
     m_already_wrote_bonds = true;
   }
 
-  WriteDataset(id, "particles/atoms/id/value", change_extent_2d, offset_2d,
-               count_2d);
-  WriteDataset(time, "particles/atoms/id/time", change_extent_1d, offset_1d,
+  double const time = sim_time;
+  int const step = (int)std::round(sim_time / time_step);
+
+  WriteProperty<int>("particles/atoms/id/value", 1, change_extent_2d,
+                     offset_2d, [](ParticleRecord const &r, int *out) {
+                       *out++ = r.id;
+                       return out;
+                     });
+  WriteDataset(&time, "particles/atoms/id/time", change_extent_1d, offset_1d,
                count_1d);
-  WriteDataset(step, "particles/atoms/id/step", change_extent_1d, offset_1d,
+  WriteDataset(&step, "particles/atoms/id/step", change_extent_1d, offset_1d,
                count_1d);
 
+  auto const vector = [](Utils::Vector3d const &v, double *out) {
+    return std::copy(v.begin(), v.end(), out);
+  };
+
   if (write_species) {
-    WriteDataset(typ, "particles/atoms/species/value", change_extent_2d,
-                 offset_2d, count_2d);
+    WriteProperty<int>("particles/atoms/species/value", 1, change_extent_2d,
+                       offset_2d, [](ParticleRecord const &r, int *out) {
+                         *out++ = r.type;
+                         return out;
+                       });
   }
   if (write_mass) {
-    WriteDataset(mass, "particles/atoms/mass/value", change_extent_2d,
-                 offset_2d, count_2d);
+    WriteProperty<double>("particles/atoms/mass/value", 1, change_extent_2d,
+                          offset_2d, [](ParticleRecord const &r, double *out) {
+                            *out++ = r.mass;
+                            return out;
+                          });
   }
   if (write_pos) {
-    WriteDataset(pos, "particles/atoms/position/value", change_extent_3d,
-                 offset_3d, count_3d);
-    WriteDataset(image, "particles/atoms/image/value", change_extent_3d,
-                 offset_3d, count_3d);
+    WriteProperty<double>("particles/atoms/position/value", 3,
+                          change_extent_3d, offset_3d,
+                          [&vector](ParticleRecord const &r, double *out) {
+                            return vector(r.pos, out);
+                          });
+    WriteProperty<int>("particles/atoms/image/value", 3, change_extent_3d,
+                       offset_3d, [](ParticleRecord const &r, int *out) {
+                         return std::copy(r.image.begin(), r.image.end(),
+                                          out);
+                       });
   }
   if (write_vel) {
-    WriteDataset(vel, "particles/atoms/velocity/value", change_extent_3d,
-                 offset_3d, count_3d);
+    WriteProperty<double>("particles/atoms/velocity/value", 3,
+                          change_extent_3d, offset_3d,
+                          [&vector](ParticleRecord const &r, double *out) {
+                            return vector(r.vel, out);
+                          });
   }
   if (write_force) {
-    WriteDataset(f, "particles/atoms/force/value", change_extent_3d, offset_3d,
-                 count_3d);
+    WriteProperty<double>("particles/atoms/force/value", 3, change_extent_3d,
+                          offset_3d,
+                          [&vector](ParticleRecord const &r, double *out) {
+                            return vector(r.f, out);
+                          });
   }
   if (write_charge) {
 #ifdef ELECTROSTATICS
-    WriteDataset(charge, "particles/atoms/charge/value", change_extent_2d,
-                 offset_2d, count_2d);
+    WriteProperty<double>("particles/atoms/charge/value", 1, change_extent_2d,
+                          offset_2d, [](ParticleRecord const &r, double *out) {
+                            *out++ = r.charge;
+                            return out;
+                          });
 #endif
   }
 }
@@ -557,9 +615,9 @@ void File::ExtendDataset(const std::string &path,
   H5Dset_extent(dataset.hid(), dims.data()); // extend all dims is collective
 }
 
-/* data is assumed to be three dimensional */
+/* data is a flat array of the extent given by count */
 template <typename T>
-void File::WriteDataset(T &data, const std::string &path,
+void File::WriteDataset(T const *data, const std::string &path,
                         const std::vector<int> &change_extent, hsize_t *offset,
                         hsize_t *count) {
 #ifdef H5MD_DEBUG
@@ -576,12 +634,19 @@ void File::WriteDataset(T &data, const std::string &path,
   for (int i = 0; i < rank; i++) {
     maxdims[i] = H5S_UNLIMITED;
   }
-  H5Sselect_hyperslab(ds, H5S_SELECT_SET, offset, nullptr, count, nullptr);
   /* Create a temporary dataspace. */
   hid_t ds_new = H5Screate_simple(rank, count, maxdims.data());
+  if (std::any_of(count, count + rank, [](hsize_t c) { return c == 0; })) {
+    /* Nodes without data still take part in the collective write. */
+    H5Sselect_none(ds);
+    H5Sselect_none(ds_new);
+  } else {
+    H5Sselect_hyperslab(ds, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+  }
   /* Finally write the data to the dataset. */
-  H5Dwrite(dataset.hid(), dataset.get_type(), ds_new, ds, H5P_DEFAULT,
-           data.origin());
+  static T const dummy{};
+  H5Dwrite(dataset.hid(), dataset.get_type(), ds_new, ds, m_dxpl,
+           data ? data : &dummy);
   H5Sclose(ds_new);
   H5Sclose(ds);
 }
@@ -626,13 +691,7 @@ void File::WriteScript(std::string const &filename) {
   H5Fclose(file_id);
 }
 
-void File::Flush() {
-  if (m_write_ordered) {
-    if (this_node == 0)
-      H5Fflush(m_h5md_file.hid(), H5F_SCOPE_GLOBAL);
-  } else
-    H5Fflush(m_h5md_file.hid(), H5F_SCOPE_GLOBAL);
-}
+void File::Flush() { H5Fflush(m_h5md_file.hid(), H5F_SCOPE_GLOBAL); }
 
 bool File::check_for_H5MD_structure(std::string const &filename) {
 #ifdef H5MD_DEBUG
@@ -23,11 +23,13 @@
 #define ESPRESSO_H5MD_CORE_HPP
 
 #include "MpiCallbacks.hpp"
-#include "PartCfg.hpp"
 #include "cells.hpp"
 #include "global.hpp"
 
+#include <utils/Vector.hpp>
+
 #include <algorithm>
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <mpi.h>
@@ -42,9 +44,6 @@
 namespace Writer {
 namespace H5md {
 
-typedef boost::multi_array<double, 3> double_array_3d;
-typedef boost::multi_array<int, 3> int_array_3d;
-
 /**
  * @brief Class for writing H5MD files.
  **/
@@ -55,7 +54,7 @@ public:
    * @brief Constructor of the File class.
    */
   File() = default;
-  ~File() = default;
+  ~File();
   /**
    * @brief Initialize the File object.
    */
@@ -78,8 +77,10 @@ public:
    * @brief General method to write to the datasets which calls more specific
    * write methods.
    * Boolean values for position, velocity, force and mass.
+   * All nodes write their part of the data collectively, in ordered
+   * mode after the particles have been redistributed by id.
    */
-  void Write(int write_dat, PartCfg &partCfg);
+  void Write(int write_dat);
 
   std::string &filename() { return m_filename; };
   std::string &scriptname() { return m_scriptname; };
@@ -89,6 +90,9 @@ public:
   // the dataset in the order of ids (possibly slower on output for many
   // particles).
   bool &write_ordered() { return m_write_ordered; };
+  // Returns the deflate level of the particle datasets, 0 disables
+  // compression.
+  int &compression() { return m_compression; };
   /**
    * @brief Method to force flush to h5md file.
    */
@@ -96,8 +100,23 @@ public:
 
 private:
   MPI_Comm m_hdf5_comm;
+  /** Dataset transfer property list for collective writes. */
+  hid_t m_dxpl = -1;
   bool m_already_wrote_bonds = false;
 
+  /** Data of one particle in one frame. */
+  struct ParticleRecord {
+    int id;
+    int type;
+    Utils::Vector3i image;
+    double mass;
+    double charge;
+    /** Folded position */
+    Utils::Vector3d pos;
+    Utils::Vector3d vel;
+    Utils::Vector3d f;
+  };
+
   /**
    * @brief Method to check if the H5MD structure is present in the file.
    * Only call this on valid HDF5 files.
@@ -111,10 +130,21 @@ private:
    * positions to the dataset.
    */
   template <typename T>
-  void WriteDataset(T &data, const std::string &path,
+  void WriteDataset(T const *data, const std::string &path,
                     const std::vector<int> &change_extent, hsize_t *offset,
                     hsize_t *count);
 
+  /**
+   * @brief Write one particle property of the local records.
+   * @param path Dataset to write to.
+   * @param n_values Number of values per particle.
+   * @param get Puts the values of a record into the output iterator.
+   */
+  template <typename T, typename Getter>
+  void WriteProperty(const std::string &path, int n_values,
+                     const std::vector<int> &change_extent, hsize_t *offset,
+                     Getter get);
+
   /**
    * @brief Method that extends datasets by the given extent.
    */
@@ -127,15 +157,11 @@ private:
   std::vector<hsize_t> create_chunk_dims(hsize_t dim, hsize_t size,
                                          hsize_t chunk_size);
 
-  /*
-   * @brief Method to fill the arrays that are used by WriteDataset particle by
-   * particle.
-   */
-  void fill_arrays_for_h5md_write_with_particle_property(
-      int particle_index, int_array_3d &id, int_array_3d &typ,
-      double_array_3d &mass, double_array_3d &pos, int_array_3d &image,
-      double_array_3d &vel, double_array_3d &f, double_array_3d &charge,
-      Particle const &current_particle, int write_dat, int_array_3d &bond);
+  /**
+   * @brief Collect the data of the local particles into @ref m_records,
+   * and their bonds into @ref m_bonds if they still have to be written.
+   */
+  void collect_local_records();
   /*
    * @brief Method to write the simulation script to the dataset.
    */
@@ -183,8 +209,17 @@ private:
   bool m_write_ordered;
   std::string m_backup_filename;
   boost::filesystem::path m_absolute_script_path = "nullptr";
+  int m_compression = 0;
   h5xx::file m_h5md_file;
 
+  /* Buffers are kept between the calls to Write() to avoid
+   * reallocations for every frame. */
+  std::vector<ParticleRecord> m_records;
+  std::vector<ParticleRecord> m_records_recv;
+  std::vector<std::array<int, 2>> m_bonds;
+  std::vector<std::array<int, 2>> m_bonds_recv;
+  std::vector<char> m_write_buffer;
+
   struct DatasetDescriptor {
     std::string path;
     hsize_t dim;
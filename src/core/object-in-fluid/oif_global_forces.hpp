@@ -28,8 +28,19 @@
  */
 int oif_global_forces_set_params(int bond_type, double A0_g, double ka_g,
                                  double V0, double kv);
-void calc_oif_global(double *area_volume, int molType);
-void add_oif_global_forces(double const *area_volume, int molType);
+
+/** Calculate the global area and volume of the objects and add the
+ *  resulting forces to the particles of their triangles.
+ *
+ *  The triangles of the objects with ids below @ref max_oif_objects are
+ *  collected from the local bond topology and cached until they are
+ *  invalidated. The area and volume of each object are only summed
+ *  over the nodes holding triangles of the object.
+ */
+void add_oif_global_forces();
+
+/** Mark the cached triangles as outdated. */
+void invalidate_oif_global_triangles();
 
 /************************************************************/
 
@@ -28,14 +28,10 @@ namespace Observables {
 class ComForce : public PidObservable {
 public:
   int n_values() const override { return 3; }
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    for (int i : ids()) {
-      res[0] += partCfg[i].f.f[0] * partCfg[i].p.mass;
-      res[1] += partCfg[i].f.f[1] * partCfg[i].p.mass;
-      res[2] += partCfg[i].f.f[2] * partCfg[i].p.mass;
-    }
-    return res;
+  std::vector<double> operator()(PartCfg &) const override {
+    return ParticleReduction::weighted_sum(
+        ids(), {ParticleReduction::Field::force},
+        ParticleReduction::Field::mass);
   };
 };
 
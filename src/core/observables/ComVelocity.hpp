@@ -28,19 +28,14 @@ namespace Observables {
 class ComVelocity : public PidObservable {
 public:
   int n_values() const override { return 3; }
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    double total_mass = 0;
-    for (int i : ids()) {
-      double mass = partCfg[i].p.mass;
-      res[0] += mass * partCfg[i].m.v[0];
-      res[1] += mass * partCfg[i].m.v[1];
-      res[2] += mass * partCfg[i].m.v[2];
-      total_mass += mass;
-    }
-    res[0] /= total_mass;
-    res[1] /= total_mass;
-    res[2] /= total_mass;
+  std::vector<double> operator()(PartCfg &) const override {
+    using ParticleReduction::Field;
+    auto res = ParticleReduction::weighted_sum(
+        ids(), {Field::velocity, Field::one}, Field::mass);
+    auto const total_mass = res[3];
+    res.resize(n_values());
+    for (auto &x : res)
+      x /= total_mass;
     return res;
   };
 };
@@ -28,17 +28,10 @@ namespace Observables {
 class Current : public PidObservable {
 public:
   int n_values() const override { return 3; };
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    for (int i : ids()) {
-#ifdef ELECTROSTATICS
-      double charge = partCfg[i].p.q;
-      res[0] += charge * partCfg[i].m.v[0];
-      res[1] += charge * partCfg[i].m.v[1];
-      res[2] += charge * partCfg[i].m.v[2];
-#endif
-    };
-    return res;
+  std::vector<double> operator()(PartCfg &) const override {
+    return ParticleReduction::weighted_sum(
+        ids(), {ParticleReduction::Field::velocity},
+        ParticleReduction::Field::charge);
   };
 };
 
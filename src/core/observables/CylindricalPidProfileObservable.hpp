@@ -27,7 +27,25 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 namespace Observables {
 
 class CylindricalPidProfileObservable : public PidObservable,
-                                        public CylindricalProfileObservable {};
+                                        public CylindricalProfileObservable {
+protected:
+  /** Binning of the profile, with the given quantity as weight. */
+  ParticleReduction::HistogramSpec
+  histogram_spec(ParticleReduction::Field weight) const {
+    ParticleReduction::HistogramSpec spec;
+    spec.cylindrical = true;
+    spec.center = center;
+    spec.axis = axis;
+    spec.n_bins = {{static_cast<size_t>(n_r_bins),
+                    static_cast<size_t>(n_phi_bins),
+                    static_cast<size_t>(n_z_bins)}};
+    spec.limits = {{std::make_pair(min_r, max_r),
+                    std::make_pair(min_phi, max_phi),
+                    std::make_pair(min_z, max_z)}};
+    spec.weight = weight;
+    return spec;
+  }
+};
 
 } // Namespace Observables
 #endif
@@ -27,19 +27,11 @@ namespace Observables {
 
 class DensityProfile : public PidProfileObservable {
 public:
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::array<size_t, 3> n_bins{{static_cast<size_t>(n_x_bins),
-                                  static_cast<size_t>(n_y_bins),
-                                  static_cast<size_t>(n_z_bins)}};
-    std::array<std::pair<double, double>, 3> limits{
-        {std::make_pair(min_x, max_x), std::make_pair(min_y, max_y),
-         std::make_pair(min_z, max_z)}};
-    Utils::Histogram<double, 3> histogram(n_bins, 1, limits);
-    for (auto const &id : ids()) {
-      histogram.update(folded_position(partCfg[id]));
-    }
-    histogram.normalize();
-    return histogram.get_histogram();
+  std::vector<double> operator()(PartCfg &) const override {
+    auto histogram = ParticleReduction::histogram(
+        ids(), histogram_spec(ParticleReduction::Field::one));
+    histogram->normalize();
+    return histogram->get_histogram();
   }
 };
 } // Namespace Observables
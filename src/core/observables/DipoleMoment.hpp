@@ -28,18 +28,10 @@ namespace Observables {
 class DipoleMoment : public PidObservable {
 public:
   int n_values() const override { return 3; };
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values(), 0.0);
-    for (int i : ids()) {
-#ifdef ELECTROSTATICS
-      double charge = partCfg[i].p.q;
-
-      res[0] += charge * partCfg[i].r.p[0];
-      res[1] += charge * partCfg[i].r.p[1];
-      res[2] += charge * partCfg[i].r.p[2];
-#endif // ELECTROSTATICS
-    }
-    return res;
+  std::vector<double> operator()(PartCfg &) const override {
+    return ParticleReduction::weighted_sum(
+        ids(), {ParticleReduction::Field::position},
+        ParticleReduction::Field::charge);
   }
 };
 
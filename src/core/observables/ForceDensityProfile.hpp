@@ -28,20 +28,11 @@ namespace Observables {
 class ForceDensityProfile : public PidProfileObservable {
 public:
   int n_values() const override { return 3 * n_x_bins * n_y_bins * n_z_bins; }
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::array<size_t, 3> n_bins{{static_cast<size_t>(n_x_bins),
-                                  static_cast<size_t>(n_y_bins),
-                                  static_cast<size_t>(n_z_bins)}};
-    std::array<std::pair<double, double>, 3> limits{
-        {std::make_pair(min_x, max_x), std::make_pair(min_y, max_y),
-         std::make_pair(min_z, max_z)}};
-    Utils::Histogram<double, 3> histogram(n_bins, 3, limits);
-    for (auto const &id : ids()) {
-      auto const ppos = ::Utils::Vector3d(folded_position(partCfg[id]));
-      histogram.update(ppos, partCfg[id].f.f);
-    }
-    histogram.normalize();
-    return histogram.get_histogram();
+  std::vector<double> operator()(PartCfg &) const override {
+    auto histogram = ParticleReduction::histogram(
+        ids(), histogram_spec(ParticleReduction::Field::force));
+    histogram->normalize();
+    return histogram->get_histogram();
   }
 };
 
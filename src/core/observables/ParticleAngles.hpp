@@ -33,13 +33,13 @@ namespace Observables {
  */
 class ParticleAngles : public PidObservable {
 public:
-  std::vector<double> operator()(PartCfg &partCfg) const override {
+  std::vector<double> operator()(PartCfg &) const override {
+    auto const pos = positions();
     std::vector<double> res(n_values());
-    auto v1 = get_mi_vector(partCfg[ids()[1]].r.p, partCfg[ids()[0]].r.p);
+    auto v1 = get_mi_vector(pos[1], pos[0]);
     auto n1 = v1.norm();
     for (int i = 0, end = n_values(); i < end; i++) {
-      auto v2 =
-          get_mi_vector(partCfg[ids()[i + 2]].r.p, partCfg[ids()[i + 1]].r.p);
+      auto v2 = get_mi_vector(pos[i + 2], pos[i + 1]);
       auto n2 = v2.norm();
       auto cosine = (v1 * v2) / (n1 * n2);
       // sanitize cosine value
@@ -29,18 +29,9 @@ namespace Observables {
 
 class ParticleAngularVelocities : public PidObservable {
 public:
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    for (int i = 0; i < ids().size(); i++) {
-#ifdef ROTATION
-      const Utils::Vector3d omega =
-          convert_vector_body_to_space(partCfg[i], partCfg[i].m.omega);
-      res[3 * i + 0] = omega[0];
-      res[3 * i + 1] = omega[1];
-      res[3 * i + 2] = omega[2];
-#endif
-    }
-    return res;
+  std::vector<double> operator()(PartCfg &) const override {
+    return ParticleReduction::gather(ids(),
+                                     {ParticleReduction::Field::omega_lab});
   }
   int n_values() const override { return 3 * ids().size(); }
 };
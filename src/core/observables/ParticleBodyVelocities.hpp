@@ -29,22 +29,9 @@ namespace Observables {
 
 class ParticleBodyVelocities : public PidObservable {
 public:
-  std::vector<double> operator()(PartCfg &partCfg) const override {
-    std::vector<double> res(n_values());
-    for (int i = 0; i < ids().size(); i++) {
-#ifdef ROTATION
-
-      double RMat[9];
-      const Utils::Vector3d vel_body =
-          convert_vector_space_to_body(partCfg[i], partCfg[i].m.v);
-
-      res[3 * i + 0] = vel_body[0];
-      res[3 * i + 1] = vel_body[1];
-      res[3 * i + 2] = vel_body[2];
-
-#endif
-    }
-    return res;
+  std::vector<double> operator()(PartCfg &) const override {
+    return ParticleReduction::gather(ids(),
+                                     {ParticleReduction::Field::velocity_body});
   }
   int n_values() const override { return 3 * ids().size(); }
 };
@@ -40,14 +40,14 @@ namespace Observables {
  */
 class ParticleDihedrals : public PidObservable {
 public:
-  std::vector<double> operator()(PartCfg &partCfg) const override {
+  std::vector<double> operator()(PartCfg &) const override {
+    auto const pos = positions();
     std::vector<double> res(n_values());
-    auto v1 = get_mi_vector(partCfg[ids()[1]].r.p, partCfg[ids()[0]].r.p);
-    auto v2 = get_mi_vector(partCfg[ids()[2]].r.p, partCfg[ids()[1]].r.p);
+    auto v1 = get_mi_vector(pos[1], pos[0]);
+    auto v2 = get_mi_vector(pos[2], pos[1]);
     auto c1 = vector_product(v1, v2);
     for (int i = 0, end = n_values(); i < end; i++) {
-      auto v3 =
-          get_mi_vector(partCfg[ids()[i + 3]].r.p, partCfg[ids()[i + 2]].r.p);
+      auto v3 = get_mi_vector(pos[i + 3], pos[i + 2]);
       auto c2 = vector_product(v2, v3);
       /* the 2-argument arctangent returns an angle in the range [-pi, pi] that
        * allows for an unambiguous determination of the 4th particle position */
@@ -32,10 +32,11 @@ namespace Observables {
  */
 class ParticleDistances : public PidObservable {
 public:
-  std::vector<double> operator()(PartCfg &partCfg) const override {
+  std::vector<double> operator()(PartCfg &) const override {
+    auto const pos = positions();
     std::vector<double> res(n_values());
     for (int i = 0, end = n_values(); i < end; i++) {
-      auto v = get_mi_vector(partCfg[ids()[i]].r.p, partCfg[ids()[i + 1]].r.p);
+      auto v = get_mi_vector(pos[i], pos[i + 1]);
       res[i] = v.norm();
     }
     return res;
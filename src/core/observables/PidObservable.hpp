@@ -22,6 +22,10 @@
 #define OBSERVABLES_PIDOBSERVABLE_HPP
 
 #include "Observable.hpp"
+#include "particle_reduction.hpp"
+
+#include <utils/Vector.hpp>
+
 #include <vector>
 
 namespace Observables {
@@ -38,6 +42,17 @@ class PidObservable : virtual public Observable {
 public:
   std::vector<int> &ids() { return m_ids; }
   std::vector<int> const &ids() const { return m_ids; }
+
+protected:
+  /** Unfolded positions of the particles, in the order of the ids. */
+  std::vector<Utils::Vector3d> positions() const {
+    auto const flat = ParticleReduction::gather(
+        ids(), {ParticleReduction::Field::position});
+    std::vector<Utils::Vector3d> res(ids().size());
+    for (int i = 0; i < res.size(); i++)
+      res[i] = Utils::Vector3d(flat.begin() + 3 * i, flat.begin() + 3 * i + 3);
+    return res;
+  }
 };
 
 } // Namespace Observables
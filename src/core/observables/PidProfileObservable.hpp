@@ -34,6 +34,20 @@ public:
   double min_z, max_z;
   int n_x_bins, n_y_bins, n_z_bins;
   int n_values() const override { return n_x_bins * n_y_bins * n_z_bins; };
+
+protected:
+  /** Binning of the profile, with the given quantity as weight. */
+  ParticleReduction::HistogramSpec
+  histogram_spec(ParticleReduction::Field weight) const {
+    ParticleReduction::HistogramSpec spec;
+    spec.n_bins = {{static_cast<size_t>(n_x_bins),
+                    static_cast<size_t>(n_y_bins),
+                    static_cast<size_t>(n_z_bins)}};
+    spec.limits = {{std::make_pair(min_x, max_x), std::make_pair(min_y, max_y),
+                    std::make_pair(min_z, max_z)}};
+    spec.weight = weight;
+    return spec;
+  }
 };
 
 } // Namespace Observables
@@ -0,0 +1,349 @@
+/*
+Copyright (C) 2019 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "particle_reduction.hpp"
+
+#include "communication.hpp"
+#include "grid.hpp"
+#include "particle_data.hpp"
+#include "rotation.hpp"
+
+#include <utils/coordinate_transformation.hpp>
+#include <utils/mpi/gatherv.hpp>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace Observables {
+namespace ParticleReduction {
+
+int field_size(Field field) {
+  switch (field) {
+  case Field::one:
+  case Field::mass:
+  case Field::charge:
+    return 1;
+  default:
+    return 3;
+  }
+}
+
+namespace {
+/** The particle with the given id if it is owned by this node. */
+Particle const *local_particle(int id) {
+  if (id < 0 or id > max_seen_particle)
+    return nullptr;
+
+  auto const p = local_particles[id];
+  return (p and not p->l.ghost) ? p : nullptr;
+}
+
+/** Number of entries in ids that refer to particles owned by this node. */
+int count_local(std::vector<int> const &ids) {
+  return static_cast<int>(std::count_if(ids.begin(), ids.end(), [](int id) {
+    return local_particle(id) != nullptr;
+  }));
+}
+
+/** Report the first entry of ids that does not refer to a particle. To be
+ *  called on the head node only, after all nodes left the reduction.
+ */
+void throw_missing_particle(std::vector<int> const &ids) {
+  auto const missing = std::find_if(ids.begin(), ids.end(), [](int id) {
+    return not particle_exists(id);
+  });
+  throw std::runtime_error(
+      "Particle with id " +
+      std::to_string(missing != ids.end() ? *missing : -1) +
+      " does not exist.");
+}
+
+Utils::Vector3d vector_field(Particle const &p, Field field) {
+  switch (field) {
+  case Field::position:
+    return unfolded_position(p);
+  case Field::folded_position:
+    return folded_position(p);
+  case Field::velocity:
+    return p.m.v;
+  case Field::force:
+    return p.f.f;
+#ifdef DIPOLES
+  case Field::dipole:
+    return p.calc_dip();
+#endif
+#ifdef ROTATION
+  case Field::omega_lab:
+    return convert_vector_body_to_space(p, p.m.omega);
+  case Field::omega_body:
+    return p.m.omega;
+  case Field::velocity_body:
+    return convert_vector_space_to_body(p, p.m.v);
+#endif
+  default:
+    return {};
+  }
+}
+
+double scalar_field(Particle const &p, Field field) {
+  switch (field) {
+  case Field::mass:
+    return p.p.mass;
+  case Field::charge:
+    return p.p.q;
+  default:
+    return 1.;
+  }
+}
+
+template <class OutputIt>
+OutputIt append_field(Particle const &p, Field field, double weight,
+                      OutputIt out) {
+  if (field_size(field) == 1) {
+    *out++ = weight * scalar_field(p, field);
+  } else {
+    for (auto const v : vector_field(p, field))
+      *out++ = weight * v;
+  }
+
+  return out;
+}
+
+int values_per_particle(std::vector<Field> const &fields) {
+  int n = 0;
+  for (auto const f : fields)
+    n += field_size(f);
+
+  return n;
+}
+
+/** Positions in ids and values of the local particles. */
+std::pair<std::vector<int>, std::vector<double>>
+local_gather(std::vector<int> const &ids, std::vector<Field> const &fields) {
+  std::vector<int> indices;
+  std::vector<double> values;
+
+  for (int i = 0; i < ids.size(); i++) {
+    if (auto const p = local_particle(ids[i])) {
+      indices.push_back(i);
+      auto out = std::back_inserter(values);
+      for (auto const f : fields)
+        out = append_field(*p, f, 1., out);
+    }
+  }
+
+  return {std::move(indices), std::move(values)};
+}
+
+std::vector<double> local_weighted_sum(std::vector<int> const &ids,
+                                       std::vector<Field> const &fields,
+                                       Field weight) {
+  std::vector<double> res(values_per_particle(fields));
+
+  for (auto const id : ids) {
+    if (auto const p = local_particle(id)) {
+      auto const w = scalar_field(*p, weight);
+      auto out = res.begin();
+      for (auto const f : fields) {
+        std::vector<double> tmp(field_size(f));
+        append_field(*p, f, w, tmp.begin());
+        out = std::transform(tmp.begin(), tmp.end(), out, out,
+                             std::plus<double>());
+      }
+    }
+  }
+
+  return res;
+}
+
+std::unique_ptr<Utils::Histogram<double, 3>>
+make_histogram(HistogramSpec const &spec) {
+  auto const n_dims_data = static_cast<size_t>(field_size(spec.weight));
+  if (spec.cylindrical)
+    return std::make_unique<Utils::CylindricalHistogram<double, 3>>(
+        spec.n_bins, n_dims_data, spec.limits);
+  return std::make_unique<Utils::Histogram<double, 3>>(
+      spec.n_bins, n_dims_data, spec.limits);
+}
+
+std::unique_ptr<Utils::Histogram<double, 3>>
+local_histogram(std::vector<int> const &ids, HistogramSpec const &spec) {
+  auto hist = make_histogram(spec);
+
+  for (auto const id : ids) {
+    if (auto const p = local_particle(id)) {
+      auto const pos = folded_position(*p);
+      if (field_size(spec.weight) == 1) {
+        auto const w = scalar_field(*p, spec.weight);
+        if (spec.cylindrical) {
+          hist->update(Utils::transform_pos_to_cylinder_coordinates(
+                           pos - spec.center, spec.axis),
+                       Utils::Span<const double>(&w, 1));
+        } else {
+          hist->update(pos, Utils::Span<const double>(&w, 1));
+        }
+      } else {
+        auto const w = vector_field(*p, spec.weight);
+        if (spec.cylindrical) {
+          auto const rel_pos = pos - spec.center;
+          hist->update(
+              Utils::transform_pos_to_cylinder_coordinates(rel_pos, spec.axis),
+              Utils::transform_vel_to_cylinder_coordinates(w, spec.axis,
+                                                           rel_pos));
+        } else {
+          hist->update(pos, w);
+        }
+      }
+    }
+  }
+
+  return hist;
+}
+
+void mpi_gather_fields_slave(std::vector<int> const &ids,
+                             std::vector<Field> const &fields) {
+  auto const local = local_gather(ids, fields);
+
+  boost::mpi::gather(comm_cart, static_cast<int>(local.first.size()), 0);
+  Utils::Mpi::gatherv(comm_cart, local.first.data(), local.first.size(), 0);
+  Utils::Mpi::gatherv(comm_cart, local.second.data(), local.second.size(), 0);
+}
+
+void mpi_weighted_sum_slave(std::vector<int> const &ids,
+                            std::vector<Field> const &fields, Field weight) {
+  auto const local = local_weighted_sum(ids, fields, weight);
+
+  boost::mpi::reduce(comm_cart, local.data(), local.size(),
+                     std::plus<double>(), 0);
+  boost::mpi::reduce(comm_cart, count_local(ids), std::plus<int>(), 0);
+}
+
+void mpi_histogram_slave(std::vector<int> const &ids,
+                         HistogramSpec const &spec) {
+  auto const local = local_histogram(ids, spec);
+  auto const hist = local->get_histogram();
+  auto const tot_count = local->get_tot_count();
+
+  boost::mpi::reduce(comm_cart, hist.data(), hist.size(), std::plus<double>(),
+                     0);
+  boost::mpi::reduce(comm_cart, tot_count.data(), tot_count.size(),
+                     std::plus<size_t>(), 0);
+  boost::mpi::reduce(comm_cart, count_local(ids), std::plus<int>(), 0);
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_gather_fields_slave)
+REGISTER_CALLBACK(mpi_weighted_sum_slave)
+REGISTER_CALLBACK(mpi_histogram_slave)
+
+std::vector<double> gather(std::vector<int> const &ids,
+                           std::vector<Field> const &fields) {
+  mpi_call(mpi_gather_fields_slave, ids, fields);
+
+  auto const local = local_gather(ids, fields);
+  auto const n_values = values_per_particle(fields);
+
+  std::vector<int> node_sizes(comm_cart.size());
+  boost::mpi::gather(comm_cart, static_cast<int>(local.first.size()),
+                     node_sizes, 0);
+
+  auto const n_found = std::accumulate(node_sizes.begin(), node_sizes.end(), 0);
+  std::vector<int> indices(n_found);
+  Utils::Mpi::gatherv(comm_cart, local.first.data(), local.first.size(),
+                      indices.data(), node_sizes.data(), 0);
+
+  for (auto &s : node_sizes)
+    s *= n_values;
+  std::vector<double> values(n_found * n_values);
+  Utils::Mpi::gatherv(comm_cart, local.second.data(), local.second.size(),
+                      values.data(), node_sizes.data(), 0);
+
+  if (static_cast<size_t>(n_found) != ids.size()) {
+    std::vector<bool> found(ids.size(), false);
+    for (auto const &i : indices)
+      found[i] = true;
+    auto const missing = std::find(found.begin(), found.end(), false);
+    throw std::runtime_error("Particle with id " +
+                             std::to_string(ids[missing - found.begin()]) +
+                             " does not exist.");
+  }
+
+  /* Sort the values into the order of the ids */
+  std::vector<double> res(ids.size() * n_values);
+  for (int i = 0; i < n_found; i++) {
+    std::copy_n(values.begin() + i * n_values, n_values,
+                res.begin() + indices[i] * n_values);
+  }
+
+  return res;
+}
+
+std::vector<double> weighted_sum(std::vector<int> const &ids,
+                                 std::vector<Field> const &fields,
+                                 Field weight) {
+  mpi_call(mpi_weighted_sum_slave, ids, fields, weight);
+
+  auto const local = local_weighted_sum(ids, fields, weight);
+  std::vector<double> res(local.size());
+  boost::mpi::reduce(comm_cart, local.data(), local.size(), res.data(),
+                     std::plus<double>(), 0);
+
+  int n_found = 0;
+  boost::mpi::reduce(comm_cart, count_local(ids), n_found, std::plus<int>(),
+                     0);
+  if (static_cast<size_t>(n_found) != ids.size())
+    throw_missing_particle(ids);
+
+  return res;
+}
+
+std::unique_ptr<Utils::Histogram<double, 3>>
+histogram(std::vector<int> const &ids, HistogramSpec const &spec) {
+  mpi_call(mpi_histogram_slave, ids, spec);
+
+  auto const local = local_histogram(ids, spec);
+  auto const local_hist = local->get_histogram();
+  auto const local_tot_count = local->get_tot_count();
+
+  std::vector<double> hist(local_hist.size());
+  std::vector<size_t> tot_count(local_tot_count.size());
+  boost::mpi::reduce(comm_cart, local_hist.data(), local_hist.size(),
+                     hist.data(), std::plus<double>(), 0);
+  boost::mpi::reduce(comm_cart, local_tot_count.data(), local_tot_count.size(),
+                     tot_count.data(), std::plus<size_t>(), 0);
+
+  int n_found = 0;
+  boost::mpi::reduce(comm_cart, count_local(ids), n_found, std::plus<int>(),
+                     0);
+  if (static_cast<size_t>(n_found) != ids.size())
+    throw_missing_particle(ids);
+
+  auto res = make_histogram(spec);
+  res->merge(hist, tot_count);
+
+  return res;
+}
+
+} // namespace ParticleReduction
+} // namespace Observables
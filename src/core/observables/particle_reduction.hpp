@@ -0,0 +1,127 @@
+/*
+Copyright (C) 2019 The ESPResSo project
+
+This file is part of ESPResSo.
+
+ESPResSo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ESPResSo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OBSERVABLES_PARTICLE_REDUCTION_HPP
+#define OBSERVABLES_PARTICLE_REDUCTION_HPP
+
+/** @file
+ *  Distributed evaluation of particle observables.
+ *
+ *  Instead of collecting the complete particle configuration on the
+ *  head node, every node evaluates the requested quantities on the
+ *  particles it owns. Only the partial results are sent to the head
+ *  node: the selected per-particle values for @ref gather, one vector
+ *  for @ref weighted_sum and the bins of a histogram for @ref histogram.
+ *
+ *  All functions have to be called on the head node only, the other
+ *  nodes are driven by MPI callbacks.
+ */
+
+#include <utils/Histogram.hpp>
+#include <utils/Vector.hpp>
+
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Observables {
+namespace ParticleReduction {
+
+/** Per-particle quantities that can be evaluated on the owning node. */
+enum class Field : int {
+  one,
+  mass,
+  charge,
+  /** Unfolded position. */
+  position,
+  folded_position,
+  velocity,
+  force,
+  dipole,
+  /** Angular velocity in the lab frame. */
+  omega_lab,
+  /** Angular velocity in the body frame. */
+  omega_body,
+  /** Velocity in the body frame. */
+  velocity_body
+};
+
+/** Number of values a @ref Field contributes per particle. */
+int field_size(Field field);
+
+/** Binning of a histogram over particle positions. */
+struct HistogramSpec {
+  /** Bin in cylindrical instead of Cartesian coordinates. */
+  bool cylindrical = false;
+  /** Origin of the cylindrical coordinate system. */
+  Utils::Vector3d center = {};
+  /** Longitudinal axis of the cylindrical coordinate system. */
+  std::string axis = "z";
+  std::array<size_t, 3> n_bins = {};
+  std::array<std::pair<double, double>, 3> limits = {};
+  /** Quantity added to the bins, vectors are converted to cylindrical
+   *  coordinates for cylindrical histograms. */
+  Field weight = Field::one;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar &cylindrical &center &axis &n_bins &limits &weight;
+  }
+};
+
+/** @brief Values of the fields for each particle.
+ *
+ *  @param ids Particle ids, duplicates are allowed.
+ *  @param fields Quantities to evaluate.
+ *  @return For each id in order, the concatenated values of the fields.
+ *  @throws std::runtime_error if one of the particles does not exist.
+ */
+std::vector<double> gather(std::vector<int> const &ids,
+                           std::vector<Field> const &fields);
+
+/** @brief Sum of weight times field over the particles.
+ *
+ *  @param ids Particle ids.
+ *  @param fields Quantities to sum up.
+ *  @param weight Scalar weight of each particle.
+ *  @return The concatenated sums of the fields.
+ *  @throws std::runtime_error if one of the particles does not exist.
+ */
+std::vector<double> weighted_sum(std::vector<int> const &ids,
+                                 std::vector<Field> const &fields,
+                                 Field weight = Field::one);
+
+/** @brief Histogram of the folded particle positions.
+ *
+ *  @param ids Particle ids.
+ *  @param spec Binning and weight.
+ *  @return The summed up, not yet normalized histogram.
+ *  @throws std::runtime_error if one of the particles does not exist.
+ */
+std::unique_ptr<Utils::Histogram<double, 3>>
+histogram(std::vector<int> const &ids, HistogramSpec const &spec);
+
+} // namespace ParticleReduction
+} // namespace Observables
+
+#endif
@@ -49,7 +49,7 @@ public:
   bool decide(const Particle &p1, const Particle &p2) const override {
     return get_mi_vector(p1.r.p, p2.r.p).norm() <= m_cut_off;
   };
-  double get_cut_off() { return m_cut_off; }
+  double get_cut_off() const { return m_cut_off; }
   void set_cut_off(double c) { m_cut_off = c; }
 
 private:
@@ -71,7 +71,7 @@ public:
                &p1, &p2, ia_params, vec21.data(), dist_betw_part,
                dist_betw_part * dist_betw_part)) >= m_cut_off;
   };
-  double get_cut_off() { return m_cut_off; }
+  double get_cut_off() const { return m_cut_off; }
   void set_cut_off(double c) { m_cut_off = c; }
 
 private:
@@ -85,7 +85,7 @@ public:
     return pair_bond_exists_on(&p1, &p2, m_bond_type) ||
            pair_bond_exists_on(&p2, &p1, m_bond_type);
   };
-  int get_bond_type() { return m_bond_type; };
+  int get_bond_type() const { return m_bond_type; };
   void set_bond_type(int t) { m_bond_type = t; }
 
 private:
@@ -27,6 +27,7 @@
 #include "particle_data.hpp"
 
 #include "PartCfg.hpp"
+#include "bonded_interactions/bond_topology.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
@@ -1001,9 +1002,17 @@ void set_particle_mol_id(int part, int mid) {
 
 #ifdef ROTATION
 void set_particle_quat(int part, double *quat) {
+  /* The integrator keeps the quaternions normalized, so only the ones set
+     from the outside have to be normalized here. */
+  Utils::Vector4d q(quat, quat + 4);
+  auto const norm = q.norm();
+  if (norm == 0.)
+    q = Utils::Vector4d{1., 0., 0., 0.};
+  else
+    q /= norm;
+
   mpi_update_particle<ParticlePosition, &Particle::r, Utils::Vector4d,
-                      &ParticlePosition::quat>(part,
-                                               Utils::Vector4d(quat, quat + 4));
+                      &ParticlePosition::quat>(part, q);
 }
 
 void set_particle_omega_lab(int part, const Utils::Vector3d &omega_lab) {
@@ -1259,6 +1268,9 @@ void added_particle(int part) {
 
 void local_add_particle_bond(Particle &p, Utils::Span<const int> bond) {
   boost::copy(bond, std::back_inserter(p.bl));
+  /* Bonds added during the integration, e.g. by the collision
+     detection, do not trigger a particle change event. */
+  invalidate_bond_topology();
 }
 
 int try_delete_bond(Particle *part, const int *bond) {
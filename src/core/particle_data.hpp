@@ -897,6 +897,7 @@ void local_rescale_particles(int dir, double scale);
  *  @param p     identity of principal atom of the bond.
  *  @param bond  field containing the bond type number and the identity
  *               of all bond partners (secondary atoms of the bond).
+ *  The compiled bond topology of this node is invalidated.
  */
 void local_add_particle_bond(Particle &p, Utils::Span<const int> bond);
 
@@ -98,8 +98,6 @@ void init_p_tensor_non_bonded(Observable_stat_non_bonded *stat_nb);
 /*********************************/
 inline void add_single_particle_virials(int v_comp, Particle &p) {
   add_kinetic_virials(&p, v_comp);
-  add_bonded_virials(&p);
-  add_three_body_bonded_stress(&p);
 }
 
 void pressure_calc(double *result, double *result_t, double *result_nb,
@@ -119,6 +117,9 @@ void pressure_calc(double *result, double *result_t, double *result_nb,
   init_p_tensor_non_bonded(&p_tensor_non_bonded);
 
   on_observable_calc();
+  add_bonded_virials();
+  add_three_body_bonded_stress();
+
   // Run short-range loop if max cut >0
   if (max_cut > 0) {
     short_range_loop(
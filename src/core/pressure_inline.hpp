@@ -155,55 +155,33 @@ inline void calc_three_body_bonded_forces(
   }
 }
 
-/** Calculate bonded virials for one particle.
+/** Calculate the bonded virials of the local particles.
  *  For performance reasons the force routines add their values directly to the
  *  particles. So here we do some tricks to get the value out without changing
  *  the forces.
- *  @param p1 particle for which to calculate virials
  */
-inline void add_bonded_virials(Particle *p1) {
-  double force[3] = {0, 0, 0};
-  // char *errtxt;
-  Particle *p2;
-  Bonded_ia_parameters *iaparams;
-
-  int i, k, l;
-  int type_num;
-
-  i = 0;
-  while (i < p1->bl.n) {
-    type_num = p1->bl.e[i++];
-    iaparams = &bonded_ia_params[type_num];
-    if (iaparams->num != 1) {
-      i += iaparams->num;
+inline void add_bonded_virials() {
+  for (auto const &group : local_bond_topology()) {
+    if (group.n_partners != 1)
       continue;
-    }
 
-    /* fetch particle 2 */
-    p2 = local_particles[p1->bl.e[i++]];
-    if (!p2) {
-      // for harmonic spring:
-      // if cutoff was defined and p2 is not there it is anyway outside the
-      // cutoff, see calc_maximal_cutoff()
-      if ((type_num == BONDED_IA_HARMONIC) && (iaparams->p.harmonic.r_cut > 0))
-        return;
-      runtimeErrorMsg() << "bond broken between particles " << p1->p.identity
-                        << " and " << p1->bl.e[i - 1]
-                        << " (particles not stored on the same node)";
-      return;
-    }
+    auto const type_num = group.type_num;
+    auto const iaparams = &bonded_ia_params[type_num];
+    for (std::size_t i = 0; i < group.size(); i++) {
+      auto const p1 = group[i][0];
+      auto const p2 = group[i][1];
 
-    double a[3] = {p1->r.p[0], p1->r.p[1], p1->r.p[2]};
-    double b[3] = {p2->r.p[0], p2->r.p[1], p2->r.p[2]};
-    auto dx = get_mi_vector(a, b);
-    calc_bond_pair_force(p1, p2, iaparams, dx.data(), force);
-    *obsstat_bonded(&virials, type_num) +=
-        dx[0] * force[0] + dx[1] * force[1] + dx[2] * force[2];
+      double force[3] = {0, 0, 0};
+      auto dx = get_mi_vector(p1->r.p, p2->r.p);
+      calc_bond_pair_force(p1, p2, iaparams, dx.data(), force);
+      *obsstat_bonded(&virials, type_num) +=
+          dx[0] * force[0] + dx[1] * force[1] + dx[2] * force[2];
 
-    /* stress tensor part */
-    for (k = 0; k < 3; k++)
-      for (l = 0; l < 3; l++)
-        obsstat_bonded(&p_tensor, type_num)[k * 3 + l] += force[k] * dx[l];
+      /* stress tensor part */
+      for (int k = 0; k < 3; k++)
+        for (int l = 0; l < 3; l++)
+          obsstat_bonded(&p_tensor, type_num)[k * 3 + l] += force[k] * dx[l];
+    }
   }
 }
 
@@ -212,36 +190,33 @@ inline void add_bonded_virials(Particle *p1) {
  *  for the contribution of the entire interaction - this is the coding
  *  not the physics.
  */
-inline void add_three_body_bonded_stress(Particle *p1) {
-  int i = 0;
-  while (i < p1->bl.n) {
-    /* scan bond list for angular interactions */
-    auto type_num = p1->bl.e[i];
-    auto iaparams = &bonded_ia_params[type_num];
-
-    // Skip non-three-particle-bonds
-    if (iaparams->num != 2) // number of partners
-    {
-      i += 1 + iaparams->num;
+inline void add_three_body_bonded_stress() {
+  for (auto const &group : local_bond_topology()) {
+    if (group.n_partners != 2)
       continue;
-    }
-    auto p2 = local_particles[p1->bl.e[i + 1]];
-    auto p3 = local_particles[p1->bl.e[i + 2]];
 
-    auto const dx21 = -get_mi_vector(p1->r.p, p2->r.p);
-    auto const dx31 = get_mi_vector(p3->r.p, p1->r.p);
+    auto const type_num = group.type_num;
+    auto const iaparams = &bonded_ia_params[type_num];
+    for (std::size_t i = 0; i < group.size(); i++) {
+      auto const p1 = group[i][0];
+      auto const p2 = group[i][1];
+      auto const p3 = group[i][2];
+
+      auto const dx21 = -get_mi_vector(p1->r.p, p2->r.p);
+      auto const dx31 = get_mi_vector(p3->r.p, p1->r.p);
 
-    Utils::Vector3d force1, force2, force3;
-    calc_three_body_bonded_forces(p1, p2, p3, iaparams, force1, force2, force3);
-    /* three-body bonded interactions contribute to the stress but not the
-     * scalar pressure */
-    for (int k = 0; k < 3; k++) {
-      for (int l = 0; l < 3; l++) {
-        obsstat_bonded(&p_tensor, type_num)[3 * k + l] +=
-            force2[k] * dx21[l] + force3[k] * dx31[l];
+      Utils::Vector3d force1, force2, force3;
+      calc_three_body_bonded_forces(p1, p2, p3, iaparams, force1, force2,
+                                    force3);
+      /* three-body bonded interactions contribute to the stress but not the
+       * scalar pressure */
+      for (int k = 0; k < 3; k++) {
+        for (int l = 0; l < 3; l++) {
+          obsstat_bonded(&p_tensor, type_num)[3 * k + l] +=
+              force2[k] * dx21[l] + force3[k] * dx31[l];
+        }
       }
     }
-    i += 3; // bond type and 2 partners
   }
 }
 
@@ -29,6 +29,11 @@
 
 #include "errorhandling.hpp"
 
+#include <Random123/philox.h>
+#include <utils/Vector.hpp>
+#include <utils/uniform.hpp>
+
+#include <cstdint>
 #include <random>
 #include <stdexcept>
 #include <string>
@@ -41,9 +46,64 @@
  * noise on the particle coupling and the fluid
  * thermalization.
  */
-enum class RNGSalt { FLUID, PARTICLES, LANGEVIN };
+enum class RNGSalt {
+  FLUID,
+  PARTICLES,
+  LANGEVIN,
+  SALT_DPD,
+  THERMALIZED_BOND_COM,
+  THERMALIZED_BOND_DIST,
+  NPTISO0_HALF_STEP1,
+  NPTISO0_HALF_STEP2,
+  NPTISOV_HALF_STEP1,
+  NPTISOV_HALF_STEP2
+};
 
 namespace Random {
+/**
+ * @brief Four uniform random numbers in [0, 1) from the Philox generator.
+ *
+ * The result only depends on the arguments, so noise evaluated with
+ * it does not depend on the order in which it is drawn or on the
+ * node that draws it.
+ *
+ * @tparam salt Decorrelates the different users of the generator.
+ * @param counter Counter of the user, usually incremented every time step.
+ * @param key1 E.g. a particle id.
+ * @param key2 E.g. the id of the second particle of a pair.
+ * @param key3 E.g. the type of a bond between the pair.
+ */
+template <RNGSalt salt>
+Utils::Vector4d philox_4_uniforms(uint64_t counter, int key1, int key2 = 0,
+                                  int key3 = 0) {
+  using rng_type = r123::Philox4x64;
+  using ctr_type = rng_type::ctr_type;
+  using key_type = rng_type::key_type;
+
+  ctr_type c{{counter, static_cast<uint64_t>(salt)}};
+  key_type k{{static_cast<uint32_t>(key1),
+              (static_cast<uint64_t>(static_cast<uint32_t>(key3)) << 32u) |
+                  static_cast<uint32_t>(key2)}};
+
+  auto const noise = rng_type{}(c, k);
+
+  using Utils::uniform;
+  return {uniform(noise[0]), uniform(noise[1]), uniform(noise[2]),
+          uniform(noise[3])};
+}
+
+/**
+ * @brief Random 3d vector with components uniform in [-0.5, 0.5),
+ *        see @ref philox_4_uniforms.
+ */
+template <RNGSalt salt>
+Utils::Vector3d v_noise(uint64_t counter, int key1, int key2 = 0,
+                        int key3 = 0) {
+  auto const u = philox_4_uniforms<salt>(counter, key1, key2, key3);
+
+  return Utils::Vector3d{u[0], u[1], u[2]} - Utils::Vector3d::broadcast(0.5);
+}
+
 extern std::mt19937 generator;
 extern std::normal_distribution<double> normal_distribution;
 extern std::uniform_real_distribution<double> uniform_real_distribution;
@@ -22,9 +22,11 @@
 #include "rattle.hpp"
 
 int n_rigidbonds = 0;
+int rattle_iterations = 0;
 
 #ifdef BOND_CONSTRAINT
 
+#include "bonded_interactions/bond_topology.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
@@ -37,11 +39,151 @@ int n_rigidbonds = 0;
 
 #include <utils/constants.hpp>
 
+#include <boost/mpi/collectives.hpp>
+
 #include <cmath>
-#include <cstdio>
-#include <cstdlib>
-#include <cstring>
-#include <mpi.h>
+#include <functional>
+#include <vector>
+
+namespace {
+/** A rigid bond between two particles. */
+struct RigidBond {
+  Particle *p1;
+  Particle *p2;
+  Rigid_bond_parameters const *params;
+};
+
+/** Rigid bonds between two real particles. They are solved on this node
+ *  without communication. */
+std::vector<RigidBond> local_bonds;
+/** Rigid bonds with a ghost partner. Their corrections are accumulated
+ *  in the forces and sent to the owners of the ghosts. */
+std::vector<RigidBond> ghost_bonds;
+
+/** Split the rigid bonds of the local bond topology into
+ *  @ref local_bonds and @ref ghost_bonds. */
+void compile_rigid_bonds() {
+  local_bonds.clear();
+  ghost_bonds.clear();
+
+  for (auto const &group : local_bond_topology()) {
+    auto const &ia_params = bonded_ia_params[group.type_num];
+    if (ia_params.type != BONDED_IA_RIGID_BOND)
+      continue;
+
+    for (std::size_t i = 0; i < group.size(); i++) {
+      RigidBond const bond{group[i][0], group[i][1], &ia_params.p.rigid_bond};
+      if (bond.p1->l.ghost or bond.p2->l.ghost)
+        ghost_bonds.push_back(bond);
+      else
+        local_bonds.push_back(bond);
+    }
+  }
+}
+
+/** @brief Positional correction of a rigid bond according to SHAKE.
+ *
+ *  The first particle has to be moved by @p corr times the mass of the
+ *  second one, the second particle by -@p corr times the mass of the
+ *  first one.
+ *
+ *  @return Whether the bond length is outside of the tolerance.
+ */
+bool pos_correction(RigidBond const &b, Utils::Vector3d &corr) {
+  auto const r_ij = get_mi_vector(b.p1->r.p, b.p2->r.p);
+  auto const r_ij2 = r_ij.norm2();
+
+  if (std::abs(1.0 - r_ij2 / b.params->d2) <= b.params->p_tol)
+    return false;
+
+  auto const r_ij_t = get_mi_vector(b.p1->r.p_old, b.p2->r.p_old);
+  corr = 0.5 * (b.params->d2 - r_ij2) / (r_ij_t * r_ij) /
+         (b.p1->p.mass + b.p2->p.mass) * r_ij_t;
+  return true;
+}
+
+/** @brief Velocity correction of a rigid bond according to RATTLE.
+ *
+ *  The velocity of the first particle has to be changed by -@p corr
+ *  times the mass of the second one, the velocity of the second particle
+ *  by @p corr times the mass of the first one.
+ *
+ *  @return Whether the relative velocity along the bond is outside of
+ *          the tolerance.
+ */
+bool vel_correction(RigidBond const &b, Utils::Vector3d &corr) {
+  auto const v_ij = b.p1->m.v - b.p2->m.v;
+  auto const r_ij = get_mi_vector(b.p1->r.p, b.p2->r.p);
+
+  auto const v_proj = v_ij * r_ij;
+  if (std::abs(v_proj) <= b.params->v_tol)
+    return false;
+
+  corr = v_proj / b.params->d2 / (b.p1->p.mass + b.p2->p.mass) * r_ij;
+  return true;
+}
+
+/** @brief Solve the bonds in @ref local_bonds.
+ *
+ *  The corrections are applied directly to the particles (Gauss-Seidel),
+ *  so coupled bonds converge in fewer sweeps than with the accumulated
+ *  corrections needed for the bonds across nodes.
+ *
+ *  @param sweep Corrects all local bonds once and returns the number of
+ *               bonds that were outside of the tolerance.
+ */
+template <class Sweep> void solve_local_bonds(Sweep sweep, const char *what) {
+  int cnt = 0;
+  while (sweep() != 0) {
+    if (++cnt >= SHAKE_MAX_ITERATIONS) {
+      runtimeErrorMsg() << what << " in RATTLE failed to converge after "
+                        << cnt << " iterations";
+      return;
+    }
+  }
+}
+
+/** Correct the positions of the bonds in @ref local_bonds once. */
+int sweep_local_pos() {
+  int n_violated = 0;
+  for (auto const &b : local_bonds) {
+    Utils::Vector3d corr;
+    if (pos_correction(b, corr)) {
+      auto const corr1 = corr * b.p2->p.mass;
+      auto const corr2 = corr * b.p1->p.mass;
+      b.p1->r.p += corr1;
+      b.p1->m.v += corr1;
+      b.p2->r.p -= corr2;
+      b.p2->m.v -= corr2;
+      n_violated++;
+    }
+  }
+  return n_violated;
+}
+
+/** Correct the velocities of the bonds in @ref local_bonds once. */
+int sweep_local_vel() {
+  int n_violated = 0;
+  for (auto const &b : local_bonds) {
+    Utils::Vector3d corr;
+    if (vel_correction(b, corr)) {
+      b.p1->m.v -= corr * b.p2->p.mass;
+      b.p2->m.v += corr * b.p1->p.mass;
+      n_violated++;
+    }
+  }
+  return n_violated;
+}
+
+/** Whether another sweep over the bonds across nodes is needed.
+ *  With a fixed number of iterations no reduction is done. */
+bool repeat_sweep(int cnt, int n_violated) {
+  if (rattle_iterations > 0)
+    return cnt < rattle_iterations;
+
+  return boost::mpi::all_reduce(comm_cart, n_violated, std::plus<int>()) != 0;
+}
+} // namespace
 
 /** \name Private functions */
 /************************************************************/
@@ -49,7 +191,7 @@ int n_rigidbonds = 0;
 
 /** Calculates the corrections required for each of the particle coordinates
     according to the RATTLE algorithm. Invoked from \ref correct_pos_shake()*/
-void compute_pos_corr_vec(int *repeat_);
+int compute_pos_corr_vec();
 
 /** Positional Corrections are added to the current particle positions. Invoked
  * from \ref correct_pos_shake() */
@@ -63,7 +205,7 @@ void transfer_force_init_vel();
 /** Calculates corrections of the  current particle velocities according to
    RATTLE
     algorithm. Invoked from \ref correct_vel_shake()*/
-void compute_vel_corr_vec(int *repeat_);
+int compute_vel_corr_vec();
 
 /** Velocity corrections are added to the current particle velocities. Invoked
    from
@@ -74,10 +216,6 @@ void apply_vel_corr();
  * f.f*/
 void revert_force();
 
-/**For debugging purpose--prints the bond lengths between particles that have
-rigid_bonds*/
-void print_bond_len();
-
 /*@}*/
 
 /*Initialize old positions (particle positions at previous time step)
@@ -110,49 +248,18 @@ void init_correction_vector() {
     reset_force(p);
 }
 
-/**Compute positional corrections*/
-void compute_pos_corr_vec(int *repeat_) {
-  Bonded_ia_parameters *ia_params;
-  int j, k, cnt = -1;
-  Particle *p1, *p2;
-
-  for (auto &p : local_cells.particles()) {
-    p1 = &p;
-    k = 0;
-    while (k < p1->bl.n) {
-      ia_params = &bonded_ia_params[p1->bl.e[k++]];
-      if (ia_params->type == BONDED_IA_RIGID_BOND) {
-        cnt++;
-        p2 = local_particles[p1->bl.e[k++]];
-        if (!p2) {
-          runtimeErrorMsg() << "rigid bond broken between particles "
-                            << p1->p.identity << " and " << p1->bl.e[k - 1]
-                            << " (particles not stored on the same node)";
-          return;
-        }
-
-        auto const r_ij = get_mi_vector(p1->r.p, p2->r.p);
-        auto const r_ij2 = r_ij.norm2();
-
-        if (fabs(1.0 - r_ij2 / ia_params->p.rigid_bond.d2) >
-            ia_params->p.rigid_bond.p_tol) {
-          auto const r_ij_t = get_mi_vector(p1->r.p_old, p2->r.p_old);
-          auto const r_ij_dot = r_ij_t * r_ij;
-          auto const G = 0.50 * (ia_params->p.rigid_bond.d2 - r_ij2) /
-                         r_ij_dot / (p1->p.mass + p2->p.mass);
-
-          auto const pos_corr = G * r_ij_t;
-          p1->f.f += pos_corr * p2->p.mass;
-          p2->f.f -= pos_corr * p1->p.mass;
-
-          /*Increase the 'repeat' flag by one */
-          *repeat_ = *repeat_ + 1;
-        }
-      } else
-        /* skip bond partners of nonrigid bond */
-        k += ia_params->num;
-    } // while loop
-  }   // for i loop
+/**Compute positional corrections of the bonds across nodes*/
+int compute_pos_corr_vec() {
+  int n_violated = 0;
+  for (auto const &b : ghost_bonds) {
+    Utils::Vector3d corr;
+    if (pos_correction(b, corr)) {
+      b.p1->f.f += corr * b.p2->p.mass;
+      b.p2->f.f -= corr * b.p1->p.mass;
+      n_violated++;
+    }
+  }
+  return n_violated;
 }
 
 /**Apply corrections to each particle**/
@@ -168,26 +275,29 @@ void app_pos_correction() {
 }
 
 void correct_pos_shake() {
-  int repeat_, cnt = 0;
-  int repeat = 1;
+  compile_rigid_bonds();
 
-  while (repeat != 0 && cnt < SHAKE_MAX_ITERATIONS) {
-    init_correction_vector();
-    repeat_ = 0;
-    compute_pos_corr_vec(&repeat_);
+  int cnt = 0;
+  bool repeat = true;
+
+  init_correction_vector();
+  compute_pos_corr_vec();
+  while (repeat && cnt < SHAKE_MAX_ITERATIONS) {
     ghost_communicator(&cell_structure.collect_ghost_force_comm);
     app_pos_correction();
+    solve_local_bonds(sweep_local_pos, "POS CORRECTIONS");
     /**Ghost Positions Update*/
     ghost_communicator(&cell_structure.update_ghost_pos_comm);
-    if (this_node == 0)
-      MPI_Reduce(&repeat_, &repeat, 1, MPI_INT, MPI_SUM, 0, comm_cart);
-    else
-      MPI_Reduce(&repeat_, nullptr, 1, MPI_INT, MPI_SUM, 0, comm_cart);
-    MPI_Bcast(&repeat, 1, MPI_INT, 0, comm_cart);
+
+    /* The local bonds are solved, so only the bonds across nodes
+     * have to be checked for the next sweep. */
+    init_correction_vector();
+    auto const n_violated = compute_pos_corr_vec();
 
     cnt++;
+    repeat = repeat_sweep(cnt, n_violated);
   } // while(repeat) loop
-  if (cnt >= SHAKE_MAX_ITERATIONS) {
+  if (repeat) {
     runtimeErrorMsg() << "RATTLE failed to converge after " << cnt
                       << " iterations";
   }
@@ -215,45 +325,18 @@ void transfer_force_init_vel() {
     copy_reset(p);
 }
 
-/** Velocity correction vectors are computed*/
-void compute_vel_corr_vec(int *repeat_) {
-  Bonded_ia_parameters *ia_params;
-  int j, k;
-  Particle *p1, *p2;
-
-  for (auto &p : local_cells.particles()) {
-    p1 = &p;
-    k = 0;
-    while (k < p1->bl.n) {
-      ia_params = &bonded_ia_params[p1->bl.e[k++]];
-      if (ia_params->type == BONDED_IA_RIGID_BOND) {
-        p2 = local_particles[p1->bl.e[k++]];
-        if (!p2) {
-          runtimeErrorMsg() << "rigid bond broken between particles "
-                            << p1->p.identity << " and " << p1->bl.e[k - 1]
-                            << " (particles not stored on the same node)";
-          return;
-        }
-
-        auto const v_ij = p1->m.v - p2->m.v;
-        auto const r_ij = get_mi_vector(p1->r.p, p2->r.p);
-
-        auto const v_proj = v_ij * r_ij;
-        if (std::abs(v_proj) > ia_params->p.rigid_bond.v_tol) {
-          auto const K =
-              v_proj / ia_params->p.rigid_bond.d2 / (p1->p.mass + p2->p.mass);
-
-          auto const vel_corr = K * r_ij;
-
-          p1->f.f -= vel_corr * p2->p.mass;
-          p2->f.f += vel_corr * p1->p.mass;
-
-          *repeat_ = *repeat_ + 1;
-        }
-      } else
-        k += ia_params->num;
-    } // while loop
-  }   // for i loop
+/** Velocity correction vectors of the bonds across nodes are computed*/
+int compute_vel_corr_vec() {
+  int n_violated = 0;
+  for (auto const &b : ghost_bonds) {
+    Utils::Vector3d corr;
+    if (vel_correction(b, corr)) {
+      b.p1->f.f -= corr * b.p2->p.mass;
+      b.p2->f.f += corr * b.p1->p.mass;
+      n_violated++;
+    }
+  }
+  return n_violated;
 }
 
 /**Apply velocity corrections*/
@@ -282,33 +365,31 @@ void revert_force() {
 }
 
 void correct_vel_shake() {
-  int repeat_, repeat = 1, cnt = 0;
+  compile_rigid_bonds();
+
+  int cnt = 0;
+  bool repeat = true;
   /**transfer the current forces to r.p_old of the particle structure so that
   velocity corrections can be stored temporarily at the f.f[3] of the particle
   structure  */
   transfer_force_init_vel();
-  while (repeat != 0 && cnt < SHAKE_MAX_ITERATIONS) {
-    init_correction_vector();
-    repeat_ = 0;
-    compute_vel_corr_vec(&repeat_);
+  compute_vel_corr_vec();
+  while (repeat && cnt < SHAKE_MAX_ITERATIONS) {
     ghost_communicator(&cell_structure.collect_ghost_force_comm);
     apply_vel_corr();
+    solve_local_bonds(sweep_local_vel, "VEL CORRECTIONS");
     ghost_communicator(&cell_structure.update_ghost_pos_comm);
-    if (this_node == 0)
-      MPI_Reduce(&repeat_, &repeat, 1, MPI_INT, MPI_SUM, 0, comm_cart);
-    else
-      MPI_Reduce(&repeat_, nullptr, 1, MPI_INT, MPI_SUM, 0, comm_cart);
 
-    MPI_Bcast(&repeat, 1, MPI_INT, 0, comm_cart);
+    init_correction_vector();
+    auto const n_violated = compute_vel_corr_vec();
+
     cnt++;
+    repeat = repeat_sweep(cnt, n_violated);
   }
 
-  if (cnt >= SHAKE_MAX_ITERATIONS) {
-    fprintf(stderr,
-            "%d: VEL CORRECTIONS IN RATTLE failed to converge after %d "
-            "iterations !!\n",
-            this_node, cnt);
-    errexit();
+  if (repeat) {
+    runtimeErrorMsg() << "VEL CORRECTIONS IN RATTLE failed to converge after "
+                      << cnt << " iterations";
   }
   /**Puts back the forces from r.p_old to f.f[3]*/
   revert_force();
@@ -335,4 +416,16 @@ int rigid_bond_set_params(int bond_type, double d, double p_tol, double v_tol) {
   return ES_OK;
 }
 
+int rattle_set_iterations(int iterations) {
+  /* The sweeps stop after SHAKE_MAX_ITERATIONS in any case, a larger
+   * fixed number would be reported as not converged. */
+  if (iterations < 0 || iterations > SHAKE_MAX_ITERATIONS)
+    return ES_ERROR;
+
+  rattle_iterations = iterations;
+  mpi_bcast_parameter(FIELD_RATTLE_ITERATIONS);
+
+  return ES_OK;
+}
+
 #endif
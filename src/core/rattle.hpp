@@ -32,6 +32,15 @@
 /** number of rigid bonds */
 extern int n_rigidbonds;
 
+/** Number of sweeps over the rigid bonds across nodes. If zero, the sweeps
+ *  are repeated until all bonds are within their tolerances, which needs a
+ *  global reduction per sweep. The rigid bonds between particles on the
+ *  same node are always solved to their tolerances. A fixed number of
+ *  sweeps can leave the bonds to ghost particles outside of their
+ *  tolerances, which is not reported. At most @ref SHAKE_MAX_ITERATIONS.
+ */
+extern int rattle_iterations;
+
 #include "config.hpp"
 
 #ifdef BOND_CONSTRAINT
@@ -50,5 +59,11 @@ void correct_vel_shake();
 /** set the parameter for a rigid, aka RATTLE bond */
 int rigid_bond_set_params(int bond_type, double d, double p_tol, double v_tol);
 
+/** Set @ref rattle_iterations.
+ *  @retval ES_ERROR if @p iterations is negative or larger than
+ *                   @ref SHAKE_MAX_ITERATIONS.
+ */
+int rattle_set_iterations(int iterations);
+
 #endif
 #endif
@@ -54,22 +54,14 @@
 
 #include <utils/constants.hpp>
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <mpi.h>
-
-/** \name Private Functions */
-/************************************************************/
-/*@{*/
-
-/** define first and second time derivatives of a quaternion, as well
-    as the angular acceleration. */
-static void define_Qdd(Particle *p, double Qd[4], double Qdd[4], double S[3],
-                       double Wd[3]);
-
-/*@}*/
+#include <vector>
 
 /** convert quaternions to the director */
 /** Convert director to quaternions */
@@ -145,147 +137,283 @@ void define_rotation_matrix(Particle const &p, double A[9]) {
   A[2 + 3 * 1] = 2 * (p.r.quat[2] * p.r.quat[3] - p.r.quat[0] * p.r.quat[1]);
 }
 
-/** calculate the second derivative of the quaternion of a given particle
-    as well as Wd vector which is the angular acceleration of this particle */
-void define_Qdd(Particle *p, double Qd[4], double Qdd[4], double S[3],
-                double Wd[3]) {
-  /* calculate the first derivative of the quaternion */
-  /* Taken from "An improved algorithm for molecular dynamics simulation of
-   * rigid molecules", Sonnenschein, Roland (1985), Eq. 4.*/
-  Qd[0] = 0.5 * (-p->r.quat[1] * p->m.omega[0] - p->r.quat[2] * p->m.omega[1] -
-                 p->r.quat[3] * p->m.omega[2]);
-
-  Qd[1] = 0.5 * (p->r.quat[0] * p->m.omega[0] - p->r.quat[3] * p->m.omega[1] +
-                 p->r.quat[2] * p->m.omega[2]);
-
-  Qd[2] = 0.5 * (p->r.quat[3] * p->m.omega[0] + p->r.quat[0] * p->m.omega[1] -
-                 p->r.quat[1] * p->m.omega[2]);
-
-  Qd[3] = 0.5 * (-p->r.quat[2] * p->m.omega[0] + p->r.quat[1] * p->m.omega[1] +
-                 p->r.quat[0] * p->m.omega[2]);
-
-  /* Calculate the angular acceleration. */
-  /* Taken from "An improved algorithm for molecular dynamics simulation of
-   * rigid molecules", Sonnenschein, Roland (1985), Eq. 5.*/
-  if (p->p.rotation & ROTATION_X)
-    Wd[0] = (p->f.torque[0] + p->m.omega[1] * p->m.omega[2] *
-                                  (p->p.rinertia[1] - p->p.rinertia[2])) /
-            p->p.rinertia[0];
-  else
-    Wd[0] = 0.0;
-  if (p->p.rotation & ROTATION_Y)
-    Wd[1] = (p->f.torque[1] + p->m.omega[2] * p->m.omega[0] *
-                                  (p->p.rinertia[2] - p->p.rinertia[0])) /
-            p->p.rinertia[1];
-  else
-    Wd[1] = 0.0;
-  if (p->p.rotation & ROTATION_Z)
-    Wd[2] = (p->f.torque[2] + p->m.omega[0] * p->m.omega[1] *
-                                  (p->p.rinertia[0] - p->p.rinertia[1])) /
-            p->p.rinertia[2];
-  else
-    Wd[2] = 0.0;
-
-  auto const S1 = Qd[0] * Qd[0] + Qd[1] * Qd[1] + Qd[2] * Qd[2] + Qd[3] * Qd[3];
-
-  /* Calculate the second derivative of the quaternion. */
-  /* Taken from "An improved algorithm for molecular dynamics simulation of
-   * rigid molecules", Sonnenschein, Roland (1985), Eq. 8.*/
-  Qdd[0] = 0.5 * (-p->r.quat[1] * Wd[0] - p->r.quat[2] * Wd[1] -
-                  p->r.quat[3] * Wd[2]) -
-           p->r.quat[0] * S1;
-
-  Qdd[1] = 0.5 * (p->r.quat[0] * Wd[0] - p->r.quat[3] * Wd[1] +
-                  p->r.quat[2] * Wd[2]) -
-           p->r.quat[1] * S1;
-
-  Qdd[2] = 0.5 * (p->r.quat[3] * Wd[0] + p->r.quat[0] * Wd[1] -
-                  p->r.quat[1] * Wd[2]) -
-           p->r.quat[2] * S1;
-
-  Qdd[3] = 0.5 * (-p->r.quat[2] * Wd[0] + p->r.quat[1] * Wd[1] +
-                  p->r.quat[0] * Wd[2]) -
-           p->r.quat[3] * S1;
-
-  S[0] = S1;
-  S[1] = Qd[0] * Qdd[0] + Qd[1] * Qdd[1] + Qd[2] * Qdd[2] + Qd[3] * Qdd[3];
-  S[2] = Qdd[0] * Qdd[0] + Qdd[1] * Qdd[1] + Qdd[2] * Qdd[2] + Qdd[3] * Qdd[3];
-}
+namespace {
+/** @brief Rotational degrees of freedom of the rotating local particles.
+ *
+ *  The quaternions, angular velocities, torques and moments of inertia
+ *  are stored in contiguous arrays, one per component, so that the
+ *  propagation loops have no branches and can be vectorized by the
+ *  compiler. Blocked rotation axes are handled by multiplying with
+ *  @ref free_axis.
+ */
+struct RotationBatch {
+  std::vector<Particle *> particles;
+  std::array<std::vector<double>, 4> quat;
+  std::array<std::vector<double>, 3> omega;
+  std::array<std::vector<double>, 3> torque;
+  std::array<std::vector<double>, 3> rinertia;
+  /** 1 for the free, 0 for the blocked rotation axes. */
+  std::array<std::vector<double>, 3> free_axis;
+
+  std::size_t size() const { return particles.size(); }
+
+  /** Copy the state of the local particles with rotation into the batch. */
+  void gather() {
+    particles.clear();
+    for (auto &p : local_cells.particles()) {
+      if (p.p.rotation)
+        particles.push_back(&p);
+    }
 
-/** propagate angular velocities and quaternions \todo implement for
-       fixed_coord_flag */
-void propagate_omega_quat_particle(Particle *p) {
-  double lambda;
+    auto const n = size();
+    for (int k = 0; k < 4; k++)
+      quat[k].resize(n);
+    for (int k = 0; k < 3; k++) {
+      omega[k].resize(n);
+      torque[k].resize(n);
+      rinertia[k].resize(n);
+      free_axis[k].resize(n);
+    }
 
-  double Qd[4], Qdd[4], S[3], Wd[3];
-  // If rotation for the particle is disabled entirely, return early.
-  if (!p->p.rotation)
-    return;
+    for (std::size_t i = 0; i < n; i++) {
+      auto const &p = *particles[i];
+      for (int k = 0; k < 4; k++)
+        quat[k][i] = p.r.quat[k];
+      for (int k = 0; k < 3; k++) {
+        omega[k][i] = p.m.omega[k];
+        torque[k][i] = p.f.torque[k];
+        rinertia[k][i] = p.p.rinertia[k];
+        free_axis[k][i] = (p.p.rotation & (ROTATION_X << k)) ? 1. : 0.;
+      }
+    }
+  }
+
+  void scatter_quat() const {
+    for (std::size_t i = 0; i < size(); i++)
+      for (int k = 0; k < 4; k++)
+        particles[i]->r.quat[k] = quat[k][i];
+  }
+
+  void scatter_omega() const {
+    for (std::size_t i = 0; i < size(); i++)
+      for (int k = 0; k < 3; k++)
+        particles[i]->m.omega[k] = omega[k][i];
+  }
+
+  void scatter_torque() const {
+    for (std::size_t i = 0; i < size(); i++)
+      for (int k = 0; k < 3; k++)
+        particles[i]->f.torque[k] = torque[k][i];
+  }
+};
+
+/** The batch is kept between the calls to reuse its memory. */
+RotationBatch &rotation_batch() {
+  static RotationBatch batch;
+  return batch;
+}
 
-  // Clear rotational velocity for blocked rotation axes.
-  if (!(p->p.rotation & ROTATION_X))
-    p->m.omega[0] = 0;
-  if (!(p->p.rotation & ROTATION_Y))
-    p->m.omega[1] = 0;
-  if (!(p->p.rotation & ROTATION_Z))
-    p->m.omega[2] = 0;
-
-  define_Qdd(p, Qd, Qdd, S, Wd);
-
-  /* Taken from "On the numerical integration of motion for rigid polyatomics:
-   * The modified quaternion approach", Omeylan, Igor (1998), Eq. 12.*/
-  lambda = 1 - S[0] * time_step_squared_half -
-           sqrt(1 - time_step_squared *
-                        (S[0] + time_step * (S[1] + time_step_half / 2. *
-                                                        (S[2] - S[0] * S[0]))));
-
-  for (int j = 0; j < 3; j++) {
-    p->m.omega[j] += time_step_half * Wd[j];
+/** Propagate angular velocities and quaternions of a batch.
+ *
+ *  The quaternions are renormalized after the update, this is the only
+ *  place where this is needed, because the propagation is the only
+ *  operation that does not preserve their norm.
+ */
+void propagate_omega_quat(RotationBatch &b) {
+  auto const n = b.size();
+  double *const q0 = b.quat[0].data(), *const q1 = b.quat[1].data(),
+                *const q2 = b.quat[2].data(), *const q3 = b.quat[3].data();
+  double *const w0 = b.omega[0].data(), *const w1 = b.omega[1].data(),
+                *const w2 = b.omega[2].data();
+  double const *const t0 = b.torque[0].data(), *const t1 = b.torque[1].data(),
+                      *const t2 = b.torque[2].data();
+  double const *const I0 = b.rinertia[0].data(),
+                      *const I1 = b.rinertia[1].data(),
+                      *const I2 = b.rinertia[2].data();
+  double const *const f0 = b.free_axis[0].data(),
+                      *const f1 = b.free_axis[1].data(),
+                      *const f2 = b.free_axis[2].data();
+
+  for (std::size_t i = 0; i < n; i++) {
+    // Clear rotational velocity for blocked rotation axes.
+    auto const o0 = f0[i] * w0[i];
+    auto const o1 = f1[i] * w1[i];
+    auto const o2 = f2[i] * w2[i];
+
+    /* first derivative of the quaternion, taken from "An improved
+     * algorithm for molecular dynamics simulation of rigid molecules",
+     * Sonnenschein, Roland (1985), Eq. 4.*/
+    auto const Qd0 = 0.5 * (-q1[i] * o0 - q2[i] * o1 - q3[i] * o2);
+    auto const Qd1 = 0.5 * (q0[i] * o0 - q3[i] * o1 + q2[i] * o2);
+    auto const Qd2 = 0.5 * (q3[i] * o0 + q0[i] * o1 - q1[i] * o2);
+    auto const Qd3 = 0.5 * (-q2[i] * o0 + q1[i] * o1 + q0[i] * o2);
+
+    /* angular acceleration, ibid. Eq. 5.*/
+    auto const Wd0 = f0[i] * (t0[i] + o1 * o2 * (I1[i] - I2[i])) / I0[i];
+    auto const Wd1 = f1[i] * (t1[i] + o2 * o0 * (I2[i] - I0[i])) / I1[i];
+    auto const Wd2 = f2[i] * (t2[i] + o0 * o1 * (I0[i] - I1[i])) / I2[i];
+
+    auto const S1 = Qd0 * Qd0 + Qd1 * Qd1 + Qd2 * Qd2 + Qd3 * Qd3;
+
+    /* second derivative of the quaternion, ibid. Eq. 8.*/
+    auto const Qdd0 =
+        0.5 * (-q1[i] * Wd0 - q2[i] * Wd1 - q3[i] * Wd2) - q0[i] * S1;
+    auto const Qdd1 =
+        0.5 * (q0[i] * Wd0 - q3[i] * Wd1 + q2[i] * Wd2) - q1[i] * S1;
+    auto const Qdd2 =
+        0.5 * (q3[i] * Wd0 + q0[i] * Wd1 - q1[i] * Wd2) - q2[i] * S1;
+    auto const Qdd3 =
+        0.5 * (-q2[i] * Wd0 + q1[i] * Wd1 + q0[i] * Wd2) - q3[i] * S1;
+
+    auto const S2 = Qd0 * Qdd0 + Qd1 * Qdd1 + Qd2 * Qdd2 + Qd3 * Qdd3;
+    auto const S3 = Qdd0 * Qdd0 + Qdd1 * Qdd1 + Qdd2 * Qdd2 + Qdd3 * Qdd3;
+
+    /* Taken from "On the numerical integration of motion for rigid
+     * polyatomics: The modified quaternion approach", Omeylan, Igor (1998),
+     * Eq. 12.*/
+    auto const lambda =
+        1 - S1 * time_step_squared_half -
+        sqrt(1 - time_step_squared *
+                     (S1 + time_step *
+                               (S2 + time_step_half / 2. * (S3 - S1 * S1))));
+
+    w0[i] = o0 + time_step_half * Wd0;
+    w1[i] = o1 + time_step_half * Wd1;
+    w2[i] = o2 + time_step_half * Wd2;
+
+    auto const p0 =
+        q0[i] + time_step * (Qd0 + time_step_half * Qdd0) - lambda * q0[i];
+    auto const p1 =
+        q1[i] + time_step * (Qd1 + time_step_half * Qdd1) - lambda * q1[i];
+    auto const p2 =
+        q2[i] + time_step * (Qd2 + time_step_half * Qdd2) - lambda * q2[i];
+    auto const p3 =
+        q3[i] + time_step * (Qd3 + time_step_half * Qdd3) - lambda * q3[i];
+
+    auto const inv_norm = 1. / sqrt(p0 * p0 + p1 * p1 + p2 * p2 + p3 * p3);
+    q0[i] = p0 * inv_norm;
+    q1[i] = p1 * inv_norm;
+    q2[i] = p2 * inv_norm;
+    q3[i] = p3 * inv_norm;
   }
-  ONEPART_TRACE(if (p->p.identity == check_id)
-                    fprintf(stderr, "%d: OPT: PV_1 v_new = (%.3e,%.3e,%.3e)\n",
-                            this_node, p->m.v[0], p->m.v[1], p->m.v[2]));
-
-  p->r.quat[0] +=
-      time_step * (Qd[0] + time_step_half * Qdd[0]) - lambda * p->r.quat[0];
-  p->r.quat[1] +=
-      time_step * (Qd[1] + time_step_half * Qdd[1]) - lambda * p->r.quat[1];
-  p->r.quat[2] +=
-      time_step * (Qd[2] + time_step_half * Qdd[2]) - lambda * p->r.quat[2];
-  p->r.quat[3] +=
-      time_step * (Qd[3] + time_step_half * Qdd[3]) - lambda * p->r.quat[3];
-  // Update the director
-
-  ONEPART_TRACE(if (p->p.identity == check_id)
-                    fprintf(stderr, "%d: OPT: PPOS p = (%.3f,%.3f,%.3f)\n",
-                            this_node, p->r.p[0], p->r.p[1], p->r.p[2]));
 }
 
-inline void convert_torque_to_body_frame_apply_fix_and_thermostat(Particle &p) {
-  auto const t = convert_vector_space_to_body(p, p.f.torque);
-  p.f.torque = Utils::Vector3d{{0, 0, 0}};
+/** Transform the torques of a batch from the space-fixed to the body-fixed
+ *  frame, see @ref define_rotation_matrix. */
+void torques_to_body_frame(RotationBatch &b) {
+  auto const n = b.size();
+  double const *const q0 = b.quat[0].data(), *const q1 = b.quat[1].data(),
+                      *const q2 = b.quat[2].data(),
+                      *const q3 = b.quat[3].data();
+  double *const t0 = b.torque[0].data(), *const t1 = b.torque[1].data(),
+                *const t2 = b.torque[2].data();
+
+  for (std::size_t i = 0; i < n; i++) {
+    auto const q0q0 = q0[i] * q0[i];
+    auto const q1q1 = q1[i] * q1[i];
+    auto const q2q2 = q2[i] * q2[i];
+    auto const q3q3 = q3[i] * q3[i];
+
+    auto const v0 = t0[i], v1 = t1[i], v2 = t2[i];
+
+    t0[i] = (q0q0 + q1q1 - q2q2 - q3q3) * v0 +
+            2 * (q1[i] * q2[i] + q0[i] * q3[i]) * v1 +
+            2 * (q1[i] * q3[i] - q0[i] * q2[i]) * v2;
+    t1[i] = 2 * (q1[i] * q2[i] - q0[i] * q3[i]) * v0 +
+            (q0q0 - q1q1 + q2q2 - q3q3) * v1 +
+            2 * (q2[i] * q3[i] + q0[i] * q1[i]) * v2;
+    t2[i] = 2 * (q1[i] * q3[i] + q0[i] * q2[i]) * v0 +
+            2 * (q2[i] * q3[i] - q0[i] * q1[i]) * v1 +
+            (q0q0 - q1q1 - q2q2 + q3q3) * v2;
+  }
+}
 
-  if (thermo_switch & THERMO_LANGEVIN) {
+/** Add the rotational Langevin torques to the body-frame torques of a
+ *  batch. The random numbers are drawn per particle. */
+void add_langevin_torques(RotationBatch &b) {
+  for (std::size_t i = 0; i < b.size(); i++) {
+    auto p = b.particles[i];
 #if defined(VIRTUAL_SITES) && defined(THERMOSTAT_IGNORE_NON_VIRTUAL)
-    if (!p.p.is_virtual)
+    if (p->p.is_virtual) {
+      for (int k = 0; k < 3; k++)
+        b.torque[k][i] = 0.;
+      continue;
+    }
 #endif
-    {
-      friction_thermo_langevin_rotation(&p);
+    friction_thermo_langevin_rotation(p);
+    for (int k = 0; k < 3; k++)
+      b.torque[k][i] += p->f.torque[k];
+  }
+}
+
+/** Convert the torques of a batch to the body-fixed frame, add the
+ *  thermostat and clear them for the blocked rotation axes. */
+void convert_torques_apply_fix_and_thermostat(RotationBatch &b) {
+  torques_to_body_frame(b);
+
+  if (thermo_switch & THERMO_LANGEVIN)
+    add_langevin_torques(b);
+
+  for (int k = 0; k < 3; k++) {
+    double *const t = b.torque[k].data();
+    double const *const f = b.free_axis[k].data();
+    for (std::size_t i = 0; i < b.size(); i++)
+      t[i] *= f[i];
+  }
+}
+
+/** Half step of the angular velocities of a batch, including the
+ *  iterative solution for the gyroscopic term. */
+void propagate_omega(RotationBatch &b) {
+  auto const n = b.size();
+  double *const w0 = b.omega[0].data(), *const w1 = b.omega[1].data(),
+                *const w2 = b.omega[2].data();
+  double const *const t0 = b.torque[0].data(), *const t1 = b.torque[1].data(),
+                      *const t2 = b.torque[2].data();
+  double const *const I0 = b.rinertia[0].data(),
+                      *const I1 = b.rinertia[1].data(),
+                      *const I2 = b.rinertia[2].data();
+
+  for (std::size_t i = 0; i < n; i++) {
+    // zeroth estimate of omega
+    auto const o0 = w0[i] + time_step_half * t0[i] / I0[i];
+    auto const o1 = w1[i] + time_step_half * t1[i] / I1[i];
+    auto const o2 = w2[i] + time_step_half * t2[i] / I2[i];
 
-      p.f.torque += t;
+    /* if the tensor of inertia is isotropic, the following refinement is not
+       needed.
+       Otherwise repeat this loop 2-3 times depending on the required accuracy
+       */
+    auto const rinertia_diff_01 = I0[i] - I1[i];
+    auto const rinertia_diff_12 = I1[i] - I2[i];
+    auto const rinertia_diff_20 = I2[i] - I0[i];
+
+    auto x0 = o0, x1 = o1, x2 = o2;
+    for (int times = 0; times <= 5; times++) {
+      auto const Wd0 = x1 * x2 * rinertia_diff_12 / I0[i];
+      auto const Wd1 = x2 * x0 * rinertia_diff_20 / I1[i];
+      auto const Wd2 = x0 * x1 * rinertia_diff_01 / I2[i];
+
+      x0 = o0 + time_step_half * Wd0;
+      x1 = o1 + time_step_half * Wd1;
+      x2 = o2 + time_step_half * Wd2;
     }
-  } else {
-    p.f.torque = t;
+
+    w0[i] = x0;
+    w1[i] = x1;
+    w2[i] = x2;
   }
+}
+} // namespace
 
-  if (!(p.p.rotation & ROTATION_X))
-    p.f.torque[0] = 0;
+void propagate_omega_quat() {
+  auto &batch = rotation_batch();
+  batch.gather();
 
-  if (!(p.p.rotation & ROTATION_Y))
-    p.f.torque[1] = 0;
+  propagate_omega_quat(batch);
 
-  if (!(p.p.rotation & ROTATION_Z))
-    p.f.torque[2] = 0;
+  batch.scatter_quat();
+  batch.scatter_omega();
 }
 
 /** convert the torques to the body-fixed frames and propagate angular
@@ -301,15 +429,17 @@ void convert_torques_propagate_omega() {
   }
 #endif
 
-  for (auto &p : local_cells.particles()) {
-    // Skip particle if rotation is turned off entirely for it.
-    if (!p.p.rotation)
-      continue;
+  auto &batch = rotation_batch();
+  batch.gather();
 
-    convert_torque_to_body_frame_apply_fix_and_thermostat(p);
+  convert_torques_apply_fix_and_thermostat(batch);
 
 #if defined(ENGINE) && (defined(LB) || defined(LB_GPU))
-    if (p.swim.swimming && lb_lbfluid_get_lattice_switch() != ActiveLB::NONE) {
+  if (lb_lbfluid_get_lattice_switch() != ActiveLB::NONE) {
+    for (std::size_t i = 0; i < batch.size(); i++) {
+      auto const &p = *batch.particles[i];
+      if (!p.swim.swimming)
+        continue;
 
       auto const dip = p.swim.dipole_length * p.r.calc_director();
 
@@ -325,56 +455,33 @@ void convert_torques_propagate_omega() {
 
         auto const omega_swim_body =
             convert_vector_space_to_body(p, omega_swim);
-        p.f.torque +=
+        auto const torque_swim =
             p.swim.rotational_friction * (omega_swim_body - p.m.omega);
+        for (int k = 0; k < 3; k++)
+          batch.torque[k][i] += torque_swim[k];
       }
     }
+  }
 #endif
 
-    ONEPART_TRACE(if (p.p.identity == check_id) fprintf(
-        stderr, "%d: OPT: SCAL f = (%.3e,%.3e,%.3e) v_old = (%.3e,%.3e,%.3e)\n",
-        this_node, p.f.f[0], p.f.f[1], p.f.f[2], p.m.v[0], p.m.v[1], p.m.v[2]));
-
-    // Propagation of angular velocities
-    p.m.omega[0] += time_step_half * p.f.torque[0] / p.p.rinertia[0];
-    p.m.omega[1] += time_step_half * p.f.torque[1] / p.p.rinertia[1];
-    p.m.omega[2] += time_step_half * p.f.torque[2] / p.p.rinertia[2];
+  // Propagation of angular velocities
+  propagate_omega(batch);
 
-    // zeroth estimate of omega
-    Utils::Vector3d omega_0 = p.m.omega;
-
-    /* if the tensor of inertia is isotropic, the following refinement is not
-       needed.
-       Otherwise repeat this loop 2-3 times depending on the required accuracy
-       */
-
-    const double rinertia_diff_01 = p.p.rinertia[0] - p.p.rinertia[1];
-    const double rinertia_diff_12 = p.p.rinertia[1] - p.p.rinertia[2];
-    const double rinertia_diff_20 = p.p.rinertia[2] - p.p.rinertia[0];
-    for (int times = 0; times <= 5; times++) {
-      Utils::Vector3d Wd;
-
-      Wd[0] = p.m.omega[1] * p.m.omega[2] * rinertia_diff_12 / p.p.rinertia[0];
-      Wd[1] = p.m.omega[2] * p.m.omega[0] * rinertia_diff_20 / p.p.rinertia[1];
-      Wd[2] = p.m.omega[0] * p.m.omega[1] * rinertia_diff_01 / p.p.rinertia[2];
-
-      p.m.omega = omega_0 + time_step_half * Wd;
-    }
-    ONEPART_TRACE(if (p.p.identity == check_id) fprintf(
-        stderr, "%d: OPT: PV_2 v_new = (%.3e,%.3e,%.3e)\n", this_node, p.m.v[0],
-        p.m.v[1], p.m.v[2]));
-  }
+  batch.scatter_torque();
+  batch.scatter_omega();
 }
 
 /** convert the torques to the body-fixed frames before the integration loop */
 void convert_initial_torques() {
 
   INTEG_TRACE(fprintf(stderr, "%d: convert_initial_torques:\n", this_node));
-  for (auto &p : local_cells.particles()) {
-    if (!p.p.rotation)
-      continue;
-    convert_torque_to_body_frame_apply_fix_and_thermostat(p);
-  }
+
+  auto &batch = rotation_batch();
+  batch.gather();
+
+  convert_torques_apply_fix_and_thermostat(batch);
+
+  batch.scatter_torque();
 }
 // Frame conversion routines
 
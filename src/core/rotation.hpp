@@ -41,8 +41,9 @@ constexpr const int ROTATION_Z = 8;
  * ---------                                                 *
  *************************************************************/
 
-/** Propagate angular velocities and update quaternions on a particle */
-void propagate_omega_quat_particle(Particle *p);
+/** Propagate angular velocities and update quaternions of the local
+    particles */
+void propagate_omega_quat();
 
 /** Convert torques to the body-fixed frame and propagate
     angular velocities */
@@ -52,6 +53,12 @@ void convert_torques_propagate_omega();
     the integration loop */
 void convert_initial_torques();
 
+/** Matrix for the transformation from the space-fixed to the body-fixed
+ *  frame of the particle, scaled by the squared norm of its quaternion.
+ *  The transposed matrix transforms from the body-fixed to the space-fixed
+ *  frame. */
+void define_rotation_matrix(Particle const &p, double A[9]);
+
 Utils::Vector3d convert_vector_body_to_space(const Particle &p,
                                              const Utils::Vector3d &v);
 Utils::Vector3d convert_vector_space_to_body(const Particle &p,
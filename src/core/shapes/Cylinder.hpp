@@ -101,6 +101,7 @@ public:
 
   void calculate_dist(const Utils::Vector3d &pos, double *dist,
                       double *vec) const override;
+  bool has_exact_distance() const override { return true; }
 };
 } // namespace Shapes
 #endif
@@ -0,0 +1,122 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SdfCache.hpp"
+
+#include <utils/interpolation/bspline_3d.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Shapes {
+SdfCache::SdfCache(std::shared_ptr<Shape const> shape,
+                   Utils::Vector3d const &origin,
+                   Utils::Vector3d const &extent, double resolution)
+    : m_shape(std::move(shape)), m_origin(origin), m_max_error(0.) {
+  if (not m_shape)
+    throw std::invalid_argument("SdfCache needs a shape.");
+  if (resolution <= 0.)
+    throw std::domain_error("The resolution has to be positive.");
+
+  /* Counted in floating point, so that absurd resolutions can not
+   * overflow before they are rejected. */
+  Utils::Vector3d n_points_exact;
+  for (int i = 0; i < 3; i++) {
+    if (extent[i] <= 0.)
+      throw std::domain_error("The extent has to be positive.");
+
+    n_points_exact[i] = std::max(2., std::ceil(extent[i] / resolution) + 1.);
+  }
+
+  auto const n_points_total =
+      n_points_exact[0] * n_points_exact[1] * n_points_exact[2];
+  if (n_points_total > max_n_points)
+    throw std::domain_error(
+        "The grid would have more than " + std::to_string(max_n_points) +
+        " points, use a coarser resolution or a smaller extent.");
+
+  std::array<int, 3> n_points;
+  for (int i = 0; i < 3; i++) {
+    n_points[i] = static_cast<int>(n_points_exact[i]);
+    m_grid_spacing[i] = extent[i] / (n_points[i] - 1);
+  }
+
+  m_values.resize(boost::extents[n_points[0]][n_points[1]][n_points[2]]);
+
+  auto sample = [this](Utils::Vector3d const &pos) {
+    Utils::Vector4d value;
+    m_shape->calculate_dist(pos, &value[0], &value[1]);
+    return value;
+  };
+
+  for (int i = 0; i < n_points[0]; i++)
+    for (int j = 0; j < n_points[1]; j++)
+      for (int k = 0; k < n_points[2]; k++) {
+        m_values[i][j][k] = sample(
+            m_origin + Utils::Vector3d{i * m_grid_spacing[0],
+                                       j * m_grid_spacing[1],
+                                       k * m_grid_spacing[2]});
+      }
+
+  for (int i = 0; i < n_points[0] - 1; i++)
+    for (int j = 0; j < n_points[1] - 1; j++)
+      for (int k = 0; k < n_points[2] - 1; k++) {
+        auto const pos =
+            m_origin + Utils::Vector3d{(i + 0.5) * m_grid_spacing[0],
+                                       (j + 0.5) * m_grid_spacing[1],
+                                       (k + 0.5) * m_grid_spacing[2]};
+        m_max_error = std::max(
+            m_max_error, std::abs(interpolate(pos)[0] - sample(pos)[0]));
+      }
+}
+
+bool SdfCache::contains(Utils::Vector3d const &pos) const {
+  for (int i = 0; i < 3; i++) {
+    auto const fractional_index = (pos[i] - m_origin[i]) / m_grid_spacing[i];
+    if (not(fractional_index >= 0. and
+            fractional_index < static_cast<double>(m_values.shape()[i] - 1)))
+      return false;
+  }
+
+  return true;
+}
+
+Utils::Vector4d SdfCache::interpolate(Utils::Vector3d const &pos) const {
+  using Utils::Interpolation::bspline_3d_accumulate;
+  return bspline_3d_accumulate<2>(
+      pos, [this](std::array<int, 3> const &ind) { return m_values(ind); },
+      m_grid_spacing, m_origin, Utils::Vector4d{});
+}
+
+void SdfCache::calculate_dist(const Utils::Vector3d &pos, double *dist,
+                              double *vec) const {
+  if (not contains(pos)) {
+    m_shape->calculate_dist(pos, dist, vec);
+    return;
+  }
+
+  auto const value = interpolate(pos);
+  *dist = value[0];
+  std::copy_n(value.begin() + 1, 3, vec);
+}
+} // namespace Shapes
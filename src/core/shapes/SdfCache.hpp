@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHAPES_SDF_CACHE_HPP
+#define SHAPES_SDF_CACHE_HPP
+
+#include "Shape.hpp"
+
+#include <utils/Vector.hpp>
+
+/* Turn off range checks if release build. */
+#if defined(NDEBUG) && !defined(BOOST_DISABLE_ASSERTS)
+#define BOOST_DISABLE_ASSERTS
+#endif
+#include <boost/multi_array.hpp>
+
+#include <memory>
+
+namespace Shapes {
+
+/**
+ * @brief Signed distance field of another shape, sampled on a grid.
+ *
+ * The distance and the distance vector of the wrapped shape are
+ * evaluated once on a regular grid. Inside of the grid they are
+ * interpolated trilinearly from the samples, outside of it the
+ * wrapped shape is evaluated directly. The wrapped shape is sampled
+ * on construction, later changes to it are not picked up.
+ *
+ * Every node holds the complete grid, with 32 bytes per grid point.
+ */
+class SdfCache : public Shape {
+public:
+  /** Largest number of grid points, i.e. 512 MiB per node. */
+  static constexpr long max_n_points = 1l << 24;
+
+  /**
+   * @param shape The shape to sample.
+   * @param origin Lower corner of the sampled region.
+   * @param extent Size of the sampled region.
+   * @param resolution Largest allowed distance of the grid points.
+   * @throws std::domain_error if the grid would have more than
+   *         @ref max_n_points points.
+   */
+  SdfCache(std::shared_ptr<Shape const> shape, Utils::Vector3d const &origin,
+           Utils::Vector3d const &extent, double resolution);
+
+  void calculate_dist(const Utils::Vector3d &pos, double *dist,
+                      double *vec) const override;
+
+  Utils::Vector3d const &origin() const { return m_origin; }
+  Utils::Vector3d const &grid_spacing() const { return m_grid_spacing; }
+  Utils::Vector3i shape() const {
+    return {m_values.shape(), m_values.shape() + 3};
+  }
+
+  /**
+   * @brief Largest deviation of the interpolated from the exact distance.
+   *
+   * This is estimated at the centers of the grid cells, where the
+   * interpolation error of smooth shapes is largest. Where the distance
+   * is smooth, the error of the distance vector is of the same order.
+   * Where the distance vector jumps, e.g. at the center of a sphere, it
+   * is not bounded by this estimate.
+   */
+  double max_error() const { return m_max_error; }
+
+private:
+  bool contains(Utils::Vector3d const &pos) const;
+  Utils::Vector4d interpolate(Utils::Vector3d const &pos) const;
+
+  std::shared_ptr<Shape const> m_shape;
+  Utils::Vector3d m_origin;
+  Utils::Vector3d m_grid_spacing;
+  /** Distance and distance vector at the grid points. */
+  boost::multi_array<Utils::Vector4d, 3> m_values;
+  double m_max_error;
+};
+
+} /* namespace Shapes */
+
+#endif
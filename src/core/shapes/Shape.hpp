@@ -30,6 +30,11 @@ class Shape {
 public:
   virtual void calculate_dist(const Utils::Vector3d &pos, double *dist,
                               double *vec) const = 0;
+  /** Whether @ref calculate_dist returns the exact distance to the
+   *  surface. Approximate distances may overestimate the distance of some
+   *  points, so they cannot be used to rule out the shape for a region.
+   */
+  virtual bool has_exact_distance() const { return false; }
   virtual ~Shape() = default;
 };
 
@@ -32,6 +32,7 @@ public:
 
   void calculate_dist(const Utils::Vector3d &pos, double *dist,
                       double *vec) const override;
+  bool has_exact_distance() const override { return true; }
 
   Utils::Vector3d &pos() { return m_pos; }
   double &rad() { return m_rad; }
@@ -38,6 +38,7 @@
 #include "pressure.hpp"
 #include "short_range_loop.hpp"
 #include "statistics_chain.hpp"
+#include "statistics_parallel.hpp"
 #include "virtual_sites.hpp"
 
 #include <utils/NoOp.hpp>
@@ -64,26 +65,45 @@ int n_part_conf = 0;
 double mindist(PartCfg &partCfg, IntList const &set1, IntList const &set2) {
   int in_set;
 
+  /* Try the pairs in the cell system first, the minimal distance is
+   * usually smaller than the interaction range. */
+  auto const range = cell_system_pair_range();
+  if (range > 0.) {
+    auto const d = min_pair_distance(std::vector<int>(set1.begin(), set1.end()),
+                                     std::vector<int>(set2.begin(), set2.end()),
+                                     range);
+    if (d < range)
+      return d;
+  }
+
   auto mindist2 = std::numeric_limits<double>::infinity();
 
-  for (auto jt = partCfg.begin(); jt != (--partCfg.end()); ++jt) {
+  /* Only positions and types are needed */
+  auto const &parts =
+      partCfg.projection(PartCfgField::position | PartCfgField::type);
+  auto pos = [&parts](size_t i) {
+    return Utils::Vector3d(parts[i].begin(), parts[i].begin() + 3);
+  };
+  auto type = [&parts](size_t i) { return static_cast<int>(parts[i][3]); };
+
+  for (size_t j = 0; j + 1 < parts.size(); ++j) {
     /* check which sets particle j belongs to
        bit 0: set1, bit1: set2
     */
     in_set = 0;
-    if (set1.empty() || contains(set1, jt->p.type))
+    if (set1.empty() || contains(set1, type(j)))
       in_set = 1;
-    if (set2.empty() || contains(set2, jt->p.type))
+    if (set2.empty() || contains(set2, type(j)))
       in_set |= 2;
     if (in_set == 0)
       continue;
 
-    for (auto it = std::next(jt); it != partCfg.end(); ++it)
+    for (size_t i = j + 1; i < parts.size(); ++i)
       /* accept a pair if particle j is in set1 and particle i in set2 or vice
        * versa. */
-      if (((in_set & 1) && (set2.empty() || contains(set2, it->p.type))) ||
-          ((in_set & 2) && (set1.empty() || contains(set1, it->p.type))))
-        mindist2 = std::min(mindist2, min_distance2(jt->r.p, it->r.p));
+      if (((in_set & 1) && (set2.empty() || contains(set2, type(i)))) ||
+          ((in_set & 2) && (set1.empty() || contains(set1, type(i)))))
+        mindist2 = std::min(mindist2, min_distance2(pos(j), pos(i)));
   }
 
   return std::sqrt(mindist2);
@@ -179,37 +199,24 @@ void momentofinertiamatrix(PartCfg &partCfg, int type, double *MofImatrix) {
   MofImatrix[7] = MofImatrix[5];
 }
 
-IntList nbhood(PartCfg &partCfg, double pt[3], double r,
-               int const planedims[3]) {
-  IntList ids;
-  Utils::Vector3d d;
-
-  auto const r2 = r * r;
-
-  for (auto const &p : partCfg) {
-    if ((planedims[0] + planedims[1] + planedims[2]) == 3) {
-      d = get_mi_vector(pt, p.r.p);
-    } else {
-      /* Calculate the in plane distance */
-      for (int j = 0; j < 3; j++) {
-        d[j] = planedims[j] * (p.r.p[j] - pt[j]);
-      }
-    }
-
-    if (d.norm2() < r2) {
-      ids.push_back(p.p.identity);
-    }
-  }
+IntList nbhood(PartCfg &, double pt[3], double r, int const planedims[3]) {
+  auto const ids =
+      nbhood_ids(Utils::Vector3d{pt[0], pt[1], pt[2]}, r,
+                 Utils::Vector3i{planedims[0], planedims[1], planedims[2]});
 
-  return ids;
+  IntList res(ids.size());
+  std::copy(ids.begin(), ids.end(), res.begin());
+  return res;
 }
 
 double distto(PartCfg &partCfg, double p[3], int pid) {
   auto mindist = std::numeric_limits<double>::infinity();
 
-  for (auto const &part : partCfg) {
-    if (pid != part.p.identity) {
-      auto const d = get_mi_vector(p, part.r.p);
+  auto const &parts = partCfg.projection(PartCfgField::position);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    if (pid != parts.ids[i]) {
+      auto const d = get_mi_vector(
+          p, Utils::Vector3d(parts[i].begin(), parts[i].end()));
       mindist = std::min(mindist, d.norm2());
     }
   }
@@ -303,6 +310,23 @@ void calc_rdf(PartCfg &partCfg, int const *p1_types, int n_p1,
 
   bin_width = (r_max - r_min) / (double)r_bins;
   inv_bin_width = 1.0 / bin_width;
+  volume = box_l[0] * box_l[1] * box_l[2];
+
+  /* Pairs closer than the interaction range are in the cell system */
+  if (cell_system_has_pairs(r_max)) {
+    auto const res = rdf_histogram(std::vector<int>(p1_types, p1_types + n_p1),
+                                   std::vector<int>(p2_types, p2_types + n_p2),
+                                   r_min, r_max, r_bins);
+    for (i = 0; i < r_bins; i++) {
+      r_in = i * bin_width + r_min;
+      r_out = r_in + bin_width;
+      bin_volume = (4.0 / 3.0) * Utils::pi() *
+                   ((r_out * r_out * r_out) - (r_in * r_in * r_in));
+      rdf[i] = res.first[i] * volume / (bin_volume * res.second);
+    }
+    return;
+  }
+
   for (i = 0; i < r_bins; i++)
     rdf[i] = 0.0;
   /* particle loop: p1_types*/
@@ -330,7 +354,6 @@ void calc_rdf(PartCfg &partCfg, int const *p1_types, int n_p1,
   }
 
   /* normalization */
-  volume = box_l[0] * box_l[1] * box_l[2];
   for (i = 0; i < r_bins; i++) {
     r_in = i * bin_width + r_min;
     r_out = r_in + bin_width;
@@ -427,15 +450,13 @@ void calc_rdf_av(PartCfg &partCfg, int const *p1_types, int n_p1,
   free(rdf_tmp);
 }
 
-void calc_structurefactor(PartCfg &partCfg, int const *p_types, int n_types,
+void calc_structurefactor(PartCfg &, int const *p_types, int n_types,
                           int order, double **_ff) {
-  int i, j, k, n, qi, t, order2;
-  double qr, twoPI_L, C_sum, S_sum, *ff = nullptr;
+  int qi, order2;
+  double *ff = nullptr;
 
   order2 = order * order;
   *_ff = ff = Utils::realloc(ff, 2 * order2 * sizeof(double));
-  ff[2 * order2] = 0;
-  twoPI_L = 2 * Utils::pi() / box_l[0];
 
   if ((n_types < 0) || (n_types > max_seen_particle_type)) {
     fprintf(stderr, "WARNING: Wrong number of particle types!");
@@ -447,37 +468,10 @@ void calc_structurefactor(PartCfg &partCfg, int const *p_types, int n_types,
     fflush(nullptr);
     errexit();
   } else {
-    for (qi = 0; qi < 2 * order2; qi++) {
-      ff[qi] = 0.0;
-    }
-    for (i = 0; i <= order; i++) {
-      for (j = -order; j <= order; j++) {
-        for (k = -order; k <= order; k++) {
-          n = i * i + j * j + k * k;
-          if ((n <= order2) && (n >= 1)) {
-            C_sum = S_sum = 0.0;
-            for (auto const &p : partCfg) {
-              for (t = 0; t < n_types; t++) {
-                if (p.p.type == p_types[t]) {
-                  qr = twoPI_L * (i * p.r.p[0] + j * p.r.p[1] + k * p.r.p[2]);
-                  C_sum += cos(qr);
-                  S_sum += sin(qr);
-                }
-              }
-            }
-            ff[2 * n - 2] += C_sum * C_sum + S_sum * S_sum;
-            ff[2 * n - 1]++;
-          }
-        }
-      }
-    }
-    n = 0;
-    for (auto const &p : partCfg) {
-      for (t = 0; t < n_types; t++) {
-        if (p.p.type == p_types[t])
-          n++;
-      }
-    }
+    auto const res = structure_factor_sums(
+        std::vector<int>(p_types, p_types + n_types), order);
+    std::copy(res.first.begin(), res.first.end(), ff);
+    auto const n = res.second;
     for (qi = 0; qi < order2; qi++)
       if (ff[2 * qi + 1] != 0)
         ff[2 * qi] /= n * ff[2 * qi + 1];
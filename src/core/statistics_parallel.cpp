@@ -0,0 +1,338 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "statistics_parallel.hpp"
+
+#include "cells.hpp"
+#include "communication.hpp"
+#include "grid.hpp"
+#include "integrate.hpp"
+#include "particle_data.hpp"
+
+#include <utils/constants.hpp>
+#include <utils/math/sqr.hpp>
+#include <utils/mpi/gather_buffer.hpp>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <limits>
+
+double cell_system_pair_range() {
+  /* Pairs beyond half the box length are not minimum image pairs. */
+  auto const half_box_l =
+      0.5 * *std::min_element(box_l.begin(), box_l.end());
+
+  switch (cell_structure.type) {
+  case CELL_STRUCTURE_NSQUARE:
+    return half_box_l;
+  case CELL_STRUCTURE_DOMDEC:
+    /* Particles may have moved by skin / 2 since the last resort. */
+    return std::min(max_range - skin, half_box_l);
+  default:
+    return 0.;
+  }
+}
+
+bool cell_system_has_pairs(double r) { return r <= cell_system_pair_range(); }
+
+namespace {
+/** How often each type occurs in types, indexed by type. */
+std::vector<double> multiplicities(std::vector<int> const &types) {
+  std::vector<double> m;
+  for (auto const t : types) {
+    if (t < 0)
+      continue;
+    if (static_cast<size_t>(t) >= m.size())
+      m.resize(t + 1);
+    m[t] += 1.;
+  }
+  return m;
+}
+
+double multiplicity(std::vector<double> const &m, Particle const &p) {
+  return (static_cast<size_t>(p.p.type) < m.size()) ? m[p.p.type] : 0.;
+}
+
+/** Histogram of the local pairs, followed by the local partial sums
+ *  needed for the pair count. */
+std::vector<double> local_rdf_histogram(std::vector<int> const &p1_types,
+                                        std::vector<int> const &p2_types,
+                                        double r_min, double r_max,
+                                        int r_bins) {
+  auto const m1 = multiplicities(p1_types);
+  auto const m2 = multiplicities(p2_types);
+  auto const mixed = (p1_types != p2_types);
+  auto const inv_bin_width = r_bins / (r_max - r_min);
+
+  std::vector<double> hist(r_bins);
+  double n1 = 0., n2 = 0., n11 = 0.;
+  for (auto const &p : local_cells.particles()) {
+    auto const w1 = multiplicity(m1, p);
+    n1 += w1;
+    n2 += multiplicity(m2, p);
+    n11 += w1 * w1;
+  }
+
+  for_each_local_pair([&](Particle const &p1, Particle const &p2,
+                          double dist2) {
+    auto const w = mixed ? multiplicity(m1, p1) * multiplicity(m2, p2) +
+                               multiplicity(m1, p2) * multiplicity(m2, p1)
+                         : multiplicity(m1, p1) * multiplicity(m2, p2);
+    if (w == 0.)
+      return;
+
+    auto const dist = std::sqrt(dist2);
+    if (dist > r_min && dist < r_max) {
+      auto const ind = static_cast<int>((dist - r_min) * inv_bin_width);
+      hist[std::min(ind, r_bins - 1)] += w;
+    }
+  });
+
+  /* The pair count needs the global particle counts, so the partial
+   * sums are returned and combined on the head node. */
+  hist.push_back(n1);
+  hist.push_back(n2);
+  hist.push_back(n11);
+
+  return hist;
+}
+
+double local_min_pair_distance(std::vector<int> const &set1,
+                               std::vector<int> const &set2, double r) {
+  auto in = [](std::vector<int> const &set, Particle const &p) {
+    return set.empty() or
+           std::find(set.begin(), set.end(), p.p.type) != set.end();
+  };
+
+  auto mindist2 = r * r;
+  auto found = false;
+  for_each_local_pair([&](Particle const &p1, Particle const &p2,
+                          double dist2) {
+    if (dist2 < mindist2 and ((in(set1, p1) and in(set2, p2)) or
+                              (in(set1, p2) and in(set2, p1)))) {
+      mindist2 = dist2;
+      found = true;
+    }
+  });
+
+  return found ? std::sqrt(mindist2) : std::numeric_limits<double>::infinity();
+}
+
+std::vector<int> local_nbhood_ids(Utils::Vector3d const &pos, double r,
+                                  Utils::Vector3i const &planedims) {
+  std::vector<int> ids;
+  auto const r2 = r * r;
+  auto const full = (planedims[0] + planedims[1] + planedims[2]) == 3;
+
+  for (auto const &p : local_cells.particles()) {
+    Utils::Vector3d d;
+    if (full) {
+      d = get_mi_vector(pos, p.r.p);
+    } else {
+      /* Calculate the in plane distance */
+      auto const p_pos = unfolded_position(p);
+      for (int j = 0; j < 3; j++)
+        d[j] = planedims[j] * (p_pos[j] - pos[j]);
+    }
+
+    if (d.norm2() < r2)
+      ids.push_back(p.p.identity);
+  }
+
+  return ids;
+}
+
+/** For all wave vectors (i, j, k) with 1 <= i^2 + j^2 + k^2 <= order^2,
+ *  in the order of the loops in @ref calc_structurefactor, the real and
+ *  imaginary part of the sum over the local particles, followed by the
+ *  number of local particles.
+ */
+std::vector<double> local_structure_factor_sums(std::vector<int> const &p_types,
+                                                int order) {
+  using complex = std::complex<double>;
+  auto const m = multiplicities(p_types);
+  auto const order2 = order * order;
+  auto const twoPI_L = 2 * Utils::pi() / box_l[0];
+
+  std::vector<int> wave_vectors;
+  for (int i = 0; i <= order; i++)
+    for (int j = -order; j <= order; j++)
+      for (int k = -order; k <= order; k++) {
+        auto const n = i * i + j * j + k * k;
+        if ((n <= order2) && (n >= 1)) {
+          wave_vectors.push_back(i);
+          wave_vectors.push_back(j + order);
+          wave_vectors.push_back(k + order);
+        }
+      }
+
+  auto const n_q = wave_vectors.size() / 3;
+  std::vector<complex> sums(n_q);
+  /* exp(i q_d x_d) for all multiples -order .. order of the base vector */
+  std::vector<complex> phase_x(2 * order + 1), phase_y(2 * order + 1),
+      phase_z(2 * order + 1);
+  double n_part = 0.;
+
+  auto fill_phases = [order](std::vector<complex> &phases, double qr) {
+    auto const e = std::polar(1., qr);
+    phases[order] = 1.;
+    for (int l = 1; l <= order; l++) {
+      phases[order + l] = phases[order + l - 1] * e;
+      phases[order - l] = std::conj(phases[order + l]);
+    }
+  };
+
+  for (auto const &p : local_cells.particles()) {
+    auto const w = multiplicity(m, p);
+    if (w == 0.)
+      continue;
+    n_part += w;
+
+    auto const pos = unfolded_position(p);
+    fill_phases(phase_x, twoPI_L * pos[0]);
+    fill_phases(phase_y, twoPI_L * pos[1]);
+    fill_phases(phase_z, twoPI_L * pos[2]);
+
+    for (size_t q = 0; q < n_q; q++) {
+      sums[q] += w * phase_x[order + wave_vectors[3 * q]] *
+                 phase_y[wave_vectors[3 * q + 1]] *
+                 phase_z[wave_vectors[3 * q + 2]];
+    }
+  }
+
+  std::vector<double> res(2 * n_q + 1);
+  for (size_t q = 0; q < n_q; q++) {
+    res[2 * q] = sums[q].real();
+    res[2 * q + 1] = sums[q].imag();
+  }
+  res.back() = n_part;
+
+  return res;
+}
+
+void mpi_rdf_histogram_slave(std::vector<int> const &p1_types,
+                             std::vector<int> const &p2_types, double r_min,
+                             double r_max, int r_bins) {
+  auto const local =
+      local_rdf_histogram(p1_types, p2_types, r_min, r_max, r_bins);
+  boost::mpi::reduce(comm_cart, local.data(), local.size(),
+                     std::plus<double>(), 0);
+}
+
+void mpi_min_pair_distance_slave(std::vector<int> const &set1,
+                                 std::vector<int> const &set2, double r) {
+  boost::mpi::reduce(comm_cart, local_min_pair_distance(set1, set2, r),
+                     boost::mpi::minimum<double>(), 0);
+}
+
+void mpi_nbhood_ids_slave(Utils::Vector3d const &pos, double r,
+                          Utils::Vector3i const &planedims) {
+  auto ids = local_nbhood_ids(pos, r, planedims);
+  Utils::Mpi::gather_buffer(ids, comm_cart);
+}
+
+void mpi_structure_factor_sums_slave(std::vector<int> const &p_types,
+                                     int order) {
+  auto const local = local_structure_factor_sums(p_types, order);
+  boost::mpi::reduce(comm_cart, local.data(), local.size(),
+                     std::plus<double>(), 0);
+}
+} // namespace
+
+REGISTER_CALLBACK(mpi_rdf_histogram_slave)
+REGISTER_CALLBACK(mpi_min_pair_distance_slave)
+REGISTER_CALLBACK(mpi_nbhood_ids_slave)
+REGISTER_CALLBACK(mpi_structure_factor_sums_slave)
+
+std::pair<std::vector<double>, double>
+rdf_histogram(std::vector<int> const &p1_types,
+              std::vector<int> const &p2_types, double r_min, double r_max,
+              int r_bins) {
+  mpi_call(mpi_rdf_histogram_slave, p1_types, p2_types, r_min, r_max, r_bins);
+
+  auto const local =
+      local_rdf_histogram(p1_types, p2_types, r_min, r_max, r_bins);
+  std::vector<double> hist(local.size());
+  boost::mpi::reduce(comm_cart, local.data(), local.size(), hist.data(),
+                     std::plus<double>(), 0);
+
+  auto const n11 = hist.back();
+  hist.pop_back();
+  auto const n2 = hist.back();
+  hist.pop_back();
+  auto const n1 = hist.back();
+  hist.pop_back();
+
+  /* Identical rdf: unordered pairs, mixed rdf: ordered pairs including
+   * a particle with itself, like in the O(N^2) implementation. */
+  auto const cnt = (p1_types != p2_types) ? n1 * n2 : 0.5 * (n1 * n1 - n11);
+
+  return {std::move(hist), cnt};
+}
+
+double min_pair_distance(std::vector<int> const &set1,
+                         std::vector<int> const &set2, double r) {
+  mpi_call(mpi_min_pair_distance_slave, set1, set2, r);
+
+  double res;
+  boost::mpi::reduce(comm_cart, local_min_pair_distance(set1, set2, r), res,
+                     boost::mpi::minimum<double>(), 0);
+  return res;
+}
+
+std::vector<int> nbhood_ids(Utils::Vector3d const &pos, double r,
+                            Utils::Vector3i const &planedims) {
+  mpi_call(mpi_nbhood_ids_slave, pos, r, planedims);
+
+  auto ids = local_nbhood_ids(pos, r, planedims);
+  Utils::Mpi::gather_buffer(ids, comm_cart);
+  std::sort(ids.begin(), ids.end());
+
+  return ids;
+}
+
+std::pair<std::vector<double>, int>
+structure_factor_sums(std::vector<int> const &p_types, int order) {
+  mpi_call(mpi_structure_factor_sums_slave, p_types, order);
+
+  auto const local = local_structure_factor_sums(p_types, order);
+  std::vector<double> sums(local.size());
+  boost::mpi::reduce(comm_cart, local.data(), local.size(), sums.data(),
+                     std::plus<double>(), 0);
+
+  auto const order2 = order * order;
+  std::vector<double> ff(2 * order2);
+  size_t q = 0;
+  for (int i = 0; i <= order; i++)
+    for (int j = -order; j <= order; j++)
+      for (int k = -order; k <= order; k++) {
+        auto const n = i * i + j * j + k * k;
+        if ((n <= order2) && (n >= 1)) {
+          ff[2 * n - 2] +=
+              Utils::sqr(sums[2 * q]) + Utils::sqr(sums[2 * q + 1]);
+          ff[2 * n - 1]++;
+          q++;
+        }
+      }
+
+  return {std::move(ff), static_cast<int>(sums.back())};
+}
@@ -0,0 +1,119 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _STATISTICS_PARALLEL_HPP
+#define _STATISTICS_PARALLEL_HPP
+/** \file
+ *  Distributed kernels for the analysis functions in statistics.cpp.
+ *
+ *  Every node evaluates its local particles, pair quantities are
+ *  computed from the pairs in the cell system like the short range
+ *  forces. Only the reduced results are sent to the head node. All
+ *  functions have to be called on the head node only.
+ *
+ *  Implementation in statistics_parallel.cpp.
+ */
+
+#include "algorithm/link_cell.hpp"
+#include "cells.hpp"
+#include "grid.hpp"
+
+#include <utils/NoOp.hpp>
+#include <utils/Vector.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <utility>
+#include <vector>
+
+/** Distance up to which all pairs are found in the cell system. */
+double cell_system_pair_range();
+
+/** Whether all pairs closer than r are found in the cell system. */
+bool cell_system_has_pairs(double r);
+
+/** @brief Calls kernel(p1, p2, dist2) for all pairs in the local cells.
+ *
+ *  Has to be called on all nodes, pairs closer than
+ *  @ref cell_system_pair_range are visited exactly once.
+ */
+template <class Kernel> void for_each_local_pair(Kernel &&kernel) {
+  cells_update_ghosts();
+
+  switch (cell_structure.type) {
+  case CELL_STRUCTURE_DOMDEC:
+    Algorithm::link_cell(boost::make_indirect_iterator(local_cells.begin()),
+                         boost::make_indirect_iterator(local_cells.end()),
+                         Utils::NoOp{}, kernel,
+                         [](Particle const &p1, Particle const &p2) {
+                           return (p1.r.p - p2.r.p).norm2();
+                         });
+    break;
+  case CELL_STRUCTURE_NSQUARE:
+    Algorithm::link_cell(boost::make_indirect_iterator(local_cells.begin()),
+                         boost::make_indirect_iterator(local_cells.end()),
+                         Utils::NoOp{}, kernel,
+                         [](Particle const &p1, Particle const &p2) {
+                           return get_mi_vector(p1.r.p, p2.r.p).norm2();
+                         });
+    break;
+  }
+}
+
+/** @brief Unnormalized radial distribution function.
+ *
+ *  Only valid if @ref cell_system_has_pairs(r_max).
+ *  Pairs and counts are weighted like in @ref calc_rdf.
+ *
+ *  @return The histogram and the number of pairs.
+ */
+std::pair<std::vector<double>, double>
+rdf_histogram(std::vector<int> const &p1_types,
+              std::vector<int> const &p2_types, double r_min, double r_max,
+              int r_bins);
+
+/** @brief Minimal distance of a pair with one particle in set1 and the
+ *  other in set2, empty sets match all particles.
+ *
+ *  @return The minimal distance if it is smaller than r, infinity
+ *          otherwise. Only valid if @ref cell_system_has_pairs(r).
+ */
+double min_pair_distance(std::vector<int> const &set1,
+                         std::vector<int> const &set2, double r);
+
+/** @brief Ids of the particles within distance r of pos, see
+ *  @ref nbhood.
+ *
+ *  @return The ids in ascending order.
+ */
+std::vector<int> nbhood_ids(Utils::Vector3d const &pos, double r,
+                            Utils::Vector3i const &planedims);
+
+/** @brief Unnormalized structure factor, see @ref calc_structurefactor.
+ *
+ *  The phase factors are calculated by recurrence from one complex
+ *  exponential per dimension and particle.
+ *
+ *  @return For all squared wave vector lengths n = 1 .. order^2, the
+ *          sum of the squared amplitudes and the number of wave vectors,
+ *          and the number of particles.
+ */
+std::pair<std::vector<double>, int>
+structure_factor_sums(std::vector<int> const &p_types, int order);
+
+#endif
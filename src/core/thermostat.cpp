@@ -92,11 +92,6 @@ void mpi_bcast_langevin_rng_counter(const uint64_t counter) {
   mpi_call(mpi_bcast_langevin_rng_counter_slave, counter);
 }
 
-void langevin_rng_counter_increment() {
-  if (thermo_switch & THERMO_LANGEVIN)
-    langevin_rng_counter->increment();
-}
-
 bool langevin_is_seed_required() {
   /* Seed is required if rng is not initialized */
   return langevin_rng_counter == nullptr;
@@ -109,6 +104,40 @@ void langevin_set_rng_state(const uint64_t counter) {
 
 uint64_t langevin_get_rng_state() { return langevin_rng_counter->value(); }
 
+#ifdef NPT
+std::unique_ptr<Utils::Counter<uint64_t>> npt_iso_rng_counter;
+
+void mpi_bcast_npt_iso_rng_counter_slave(const uint64_t counter) {
+  npt_iso_rng_counter = std::make_unique<Utils::Counter<uint64_t>>(counter);
+}
+
+REGISTER_CALLBACK(mpi_bcast_npt_iso_rng_counter_slave)
+
+bool npt_iso_is_seed_required() { return npt_iso_rng_counter == nullptr; }
+
+void npt_iso_set_rng_state(const uint64_t counter) {
+  mpi_call(mpi_bcast_npt_iso_rng_counter_slave, counter);
+  npt_iso_rng_counter = std::make_unique<Utils::Counter<uint64_t>>(counter);
+}
+
+uint64_t npt_iso_get_rng_state() { return npt_iso_rng_counter->value(); }
+#endif
+
+void philox_counter_increment() {
+  if (thermo_switch & THERMO_LANGEVIN)
+    langevin_rng_counter->increment();
+#ifdef DPD
+  if (thermo_switch & THERMO_DPD)
+    dpd_rng_counter->increment();
+#endif
+#ifdef NPT
+  if (thermo_switch & THERMO_NPT_ISO)
+    npt_iso_rng_counter->increment();
+#endif
+  if (n_thermalized_bonds)
+    thermalized_bond_rng_counter->increment();
+}
+
 void thermo_init_langevin() {
   langevin_pref1 = -langevin_gamma;
   langevin_pref2 = sqrt(24.0 * temperature / time_step * langevin_gamma);
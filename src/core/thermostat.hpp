@@ -53,9 +53,6 @@
 /*@}*/
 
 namespace Thermostat {
-
-static auto noise = []() { return (d_random() - 0.5); };
-
 #ifdef PARTICLE_ANISOTROPY
 using GammaType = Utils::Vector3d;
 #else
@@ -93,6 +90,9 @@ extern double nptiso_gamma0;
 extern double nptiso_gammav;
 
 extern std::unique_ptr<Utils::Counter<uint64_t>> langevin_rng_counter;
+#ifdef NPT
+extern std::unique_ptr<Utils::Counter<uint64_t>> npt_iso_rng_counter;
+#endif
 
 /************************************************
  * functions
@@ -101,11 +101,20 @@ extern std::unique_ptr<Utils::Counter<uint64_t>> langevin_rng_counter;
 /** only require seed if rng is not initialized */
 bool langevin_is_seed_required();
 
-/** philox functiontality: increment, get/set */
-void langevin_rng_counter_increment();
+/** philox functiontality: get/set */
 void langevin_set_rng_state(uint64_t counter);
 uint64_t langevin_get_rng_state();
 
+#ifdef NPT
+bool npt_iso_is_seed_required();
+void npt_iso_set_rng_state(uint64_t counter);
+uint64_t npt_iso_get_rng_state();
+#endif
+
+/** Increment the philox counters of all active thermostats,
+ *  once per time step. */
+void philox_counter_increment();
+
 /** initialize constants of the thermostat on
     start of integration */
 void thermo_init();
@@ -127,27 +136,44 @@ void thermo_cool_down();
 #ifdef NPT
 /** add velocity-dependent noise and friction for NpT-sims to the particle's
    velocity
-    @param vj     j-component of the velocity
-    @return       j-component of the noise added to the velocity, also scaled by
+    @tparam step       Which of the two half steps of the velocity update
+    @param vel         velocity of the particle
+    @param p_identity  particle id, keys the noise
+    @return       noise added to the velocity, also scaled by
    dt (contained in prefactors) */
-inline double friction_therm0_nptiso(double vj) {
+template <int step>
+inline Utils::Vector3d friction_therm0_nptiso(Utils::Vector3d const &vel,
+                                              int p_identity) {
+  static_assert(step == 1 or step == 2, "NpT has two half steps");
+  constexpr auto salt =
+      (step == 1) ? RNGSalt::NPTISO0_HALF_STEP1 : RNGSalt::NPTISO0_HALF_STEP2;
   extern double nptiso_pref1, nptiso_pref2;
   if (thermo_switch & THERMO_NPT_ISO) {
     if (nptiso_pref2 > 0.0) {
-      return (nptiso_pref1 * vj + nptiso_pref2 * Thermostat::noise());
+      return nptiso_pref1 * vel +
+             nptiso_pref2 * Random::v_noise<salt>(npt_iso_rng_counter->value(),
+                                                  p_identity);
     }
-    return nptiso_pref1 * vj;
+    return nptiso_pref1 * vel;
   }
-  return 0.0;
+  return {};
 }
 
 /** add p_diff-dependent noise and friction for NpT-sims to \ref
- * nptiso_struct::p_diff */
-inline double friction_thermV_nptiso(double p_diff) {
+ * nptiso_struct::p_diff
+ *  @tparam step Which of the two half steps of a time step the piston
+ *               is propagated in, each half step draws its own noise.
+ */
+template <int step> inline double friction_thermV_nptiso(double p_diff) {
+  static_assert(step == 1 or step == 2, "NpT has two half steps");
+  constexpr auto salt =
+      (step == 1) ? RNGSalt::NPTISOV_HALF_STEP1 : RNGSalt::NPTISOV_HALF_STEP2;
   extern double nptiso_pref3, nptiso_pref4;
   if (thermo_switch & THERMO_NPT_ISO) {
     if (nptiso_pref4 > 0.0) {
-      return (nptiso_pref3 * p_diff + nptiso_pref4 * Thermostat::noise());
+      return (nptiso_pref3 * p_diff +
+              nptiso_pref4 *
+                  Random::v_noise<salt>(npt_iso_rng_counter->value(), 0)[0]);
     }
     return nptiso_pref3 * p_diff;
   }
@@ -163,22 +189,8 @@ inline double friction_thermV_nptiso(double p_diff) {
     3. Particle ID (decorrelates particles, gets rid of seed-per-node)
 */
 inline Utils::Vector3d v_noise(int particle_id) {
-
-  using rng_type = r123::Philox4x64;
-  using ctr_type = rng_type::ctr_type;
-  using key_type = rng_type::key_type;
-
-  ctr_type c{{langevin_rng_counter->value(),
-              static_cast<uint64_t>(RNGSalt::LANGEVIN)}};
-
-  key_type k{{static_cast<uint32_t>(particle_id)}};
-
-  auto const noise = rng_type{}(c, k);
-
-  using Utils::uniform;
-  return Utils::Vector3d{uniform(noise[0]), uniform(noise[1]),
-                         uniform(noise[2])} -
-         Utils::Vector3d::broadcast(0.5);
+  return Random::v_noise<RNGSalt::LANGEVIN>(langevin_rng_counter->value(),
+                                            particle_id);
 }
 
 /** Langevin thermostat core function.
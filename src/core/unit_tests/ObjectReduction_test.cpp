@@ -0,0 +1,120 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ * Unit tests for the ObjectReduction class.
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "ObjectReduction.hpp"
+
+#include <boost/mpi.hpp>
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE ObjectReduction test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace mpi = boost::mpi;
+
+/* Object o is held by the nodes r with r == o or r == o + shift,
+   where the objects 1000 + r are only held by node r and object 2000
+   by all nodes. */
+std::vector<int> objects_of(int rank, int shift) {
+  std::vector<int> objects = {rank, 1000 + rank, 2000};
+  if (rank >= shift)
+    objects.push_back(rank - shift);
+  std::sort(objects.begin(), objects.end());
+  objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+  return objects;
+}
+
+/* The node r contributes (r + 1) * o and r - o to object o. */
+std::vector<double> partial_values(int rank, std::vector<int> const &objects) {
+  std::vector<double> values;
+  for (auto const &o : objects) {
+    values.push_back((rank + 1.) * o);
+    values.push_back(rank - o);
+  }
+  return values;
+}
+
+void check_totals(mpi::communicator const &world, ObjectReduction const &red,
+                  int shift) {
+  auto const totals = red.reduce(partial_values(world.rank(), red.objects()));
+  BOOST_REQUIRE(totals.size() == 2 * red.objects().size());
+
+  for (std::size_t i = 0; i < red.objects().size(); i++) {
+    auto const o = red.objects()[i];
+    std::vector<double> expected(2, 0.);
+    for (int r = 0; r < world.size(); r++) {
+      auto const objects = objects_of(r, shift);
+      if (std::binary_search(objects.begin(), objects.end(), o)) {
+        expected[0] += (r + 1.) * o;
+        expected[1] += r - o;
+      }
+    }
+    BOOST_CHECK(totals[2 * i] == expected[0]);
+    BOOST_CHECK(totals[2 * i + 1] == expected[1]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(reduce) {
+  mpi::communicator world;
+  ObjectReduction red(2);
+
+  red.set_objects(world, objects_of(world.rank(), 1));
+  BOOST_CHECK(red.objects() == objects_of(world.rank(), 1));
+  check_totals(world, red, 1);
+
+  /* Setting the same objects keeps the pattern */
+  red.set_objects(world, objects_of(world.rank(), 1));
+  check_totals(world, red, 1);
+
+  /* Change of the objects on some nodes */
+  red.set_objects(world, objects_of(world.rank(), 2));
+  check_totals(world, red, 2);
+
+  /* No local objects */
+  red.set_objects(world, {});
+  BOOST_CHECK(red.reduce({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(identical_totals) {
+  mpi::communicator world;
+  ObjectReduction red(1);
+
+  /* All nodes get the bitwise same sum for the shared object */
+  red.set_objects(world, {7});
+  auto const total = red.reduce({0.1 * (world.rank() + 1) / 3.});
+  std::vector<double> all_totals;
+  mpi::all_gather(world, total.front(), all_totals);
+  for (auto const &t : all_totals)
+    BOOST_CHECK(t == all_totals.front());
+}
+
+int main(int argc, char **argv) {
+  mpi::environment mpi_env(argc, argv);
+
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
@@ -61,6 +61,13 @@ public:
   }
 };
 
+/* The only field of the mock particle is the id. */
+void project_fields(Particle const &p, unsigned fields,
+                    std::vector<double> &out) {
+  if (fields & 1u)
+    out.push_back(p.identity());
+}
+
 using Particles = std::vector<Particle>;
 
 void check_merge(unsigned size, unsigned split) {
@@ -213,6 +220,58 @@ BOOST_AUTO_TEST_CASE(iterators) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(projection) {
+  Particles local_parts;
+  mpi::communicator world;
+  MpiCallbacks cb(world);
+
+  auto const rank = cb.comm().rank();
+  auto const size = cb.comm().size();
+  auto const n_part = 1000;
+
+  local_parts.reserve(n_part);
+
+  for (int i = 0; i < n_part; i++) {
+    local_parts.emplace_back(rank * n_part + (n_part - i - 1));
+  }
+
+  auto get_parts = [&local_parts]() -> Particles const & {
+    return local_parts;
+  };
+
+  ParticleCache<decltype(get_parts)> part_cfg(cb, get_parts);
+
+  if (rank == 0) {
+    auto const version = part_cfg.version();
+    auto const &proj = part_cfg.projection(1u);
+
+    BOOST_CHECK(proj.size() == size * n_part);
+    BOOST_CHECK(proj.stride == 1);
+    BOOST_CHECK(proj.version == version);
+    /* Ids are sorted and the values belong to the ids. */
+    for (int i = 0; i < size * n_part; i++) {
+      BOOST_CHECK(proj.ids[i] == i);
+      BOOST_CHECK(proj[i][0] == i);
+    }
+
+    /* Repeated reads reuse the projection... */
+    BOOST_CHECK(&part_cfg.projection(1u) == &proj);
+
+    /* ...until the cache is invalidated. */
+    part_cfg.invalidate();
+    BOOST_CHECK(part_cfg.version() != version);
+
+    /* With the full cache, no fields are gathered. */
+    part_cfg.update();
+    auto const &cached = part_cfg.projection(0u);
+    BOOST_CHECK(cached.size() == size * n_part);
+    BOOST_CHECK(cached.stride == 0);
+    BOOST_CHECK(std::is_sorted(cached.ids.begin(), cached.ids.end()));
+  } else {
+    cb.loop();
+  }
+}
+
 int main(int argc, char **argv) {
   mpi::environment mpi_env(argc, argv);
 
@@ -0,0 +1,114 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE SdfCache test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "shapes/SdfCache.hpp"
+#include "shapes/Sphere.hpp"
+#include "shapes/Wall.hpp"
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_CASE(grid) {
+  auto wall = std::make_shared<Shapes::Wall>();
+  Shapes::SdfCache sdf(wall, {-1., 0., 1.}, {2., 3., 4.5}, 0.4);
+
+  BOOST_CHECK(sdf.origin() == Utils::Vector3d({-1., 0., 1.}));
+  BOOST_CHECK(sdf.shape() == Utils::Vector3i({6, 9, 13}));
+  BOOST_CHECK_CLOSE(sdf.grid_spacing()[0], 0.4, 1e-12);
+  BOOST_CHECK_CLOSE(sdf.grid_spacing()[1], 0.375, 1e-12);
+  BOOST_CHECK_CLOSE(sdf.grid_spacing()[2], 0.375, 1e-12);
+
+  BOOST_CHECK_THROW(Shapes::SdfCache(wall, {}, {1., 1., 1.}, 0.),
+                    std::domain_error);
+  BOOST_CHECK_THROW(Shapes::SdfCache(wall, {}, {1., 0., 1.}, 0.1),
+                    std::domain_error);
+  BOOST_CHECK_THROW(Shapes::SdfCache(nullptr, {}, {1., 1., 1.}, 0.1),
+                    std::invalid_argument);
+
+  /* 301^3 points would need 870 MB per node */
+  BOOST_CHECK_THROW(Shapes::SdfCache(wall, {}, {30., 30., 30.}, 0.1),
+                    std::domain_error);
+  BOOST_CHECK_THROW(Shapes::SdfCache(wall, {}, {1., 1., 1.}, 1e-300),
+                    std::domain_error);
+  Shapes::SdfCache(wall, {}, {30., 30., 30.}, 0.25);
+}
+
+/* The distance to a wall is linear, so the interpolation is exact. */
+BOOST_AUTO_TEST_CASE(wall) {
+  auto wall = std::make_shared<Shapes::Wall>();
+  wall->set_normal(Utils::Vector3d{1., 2., 3.});
+  wall->d() = 0.5;
+
+  Shapes::SdfCache sdf(wall, {0., 0., 0.}, {4., 4., 4.}, 0.3);
+  BOOST_CHECK_SMALL(sdf.max_error(), 1e-12);
+
+  for (double x = -1.05; x < 5.; x += 0.23) {
+    Utils::Vector3d const pos = {x, 0.5 * x + 1., 3.9 - 0.7 * x};
+    double d, d_ref;
+    double vec[3], vec_ref[3];
+    sdf.calculate_dist(pos, &d, vec);
+    wall->calculate_dist(pos, &d_ref, vec_ref);
+
+    BOOST_CHECK_SMALL(d - d_ref, 1e-12);
+    for (int i = 0; i < 3; i++)
+      BOOST_CHECK_SMALL(vec[i] - vec_ref[i], 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sphere) {
+  auto sphere = std::make_shared<Shapes::Sphere>();
+  sphere->pos() = {2., 2., 2.};
+  sphere->rad() = 1.;
+  sphere->direction() = 1.;
+
+  Shapes::SdfCache coarse(sphere, {0., 0., 0.}, {4., 4., 4.}, 0.2);
+  Shapes::SdfCache fine(sphere, {0., 0., 0.}, {4., 4., 4.}, 0.05);
+
+  BOOST_CHECK_GT(coarse.max_error(), 0.);
+  BOOST_CHECK_LT(fine.max_error(), coarse.max_error());
+
+  /* Close to the surface the distance is smooth, the error is
+   * bounded by the estimate. */
+  for (int i = 0; i < 50; i++) {
+    auto const phi = 0.37 * i;
+    auto const theta = 0.11 * i;
+    auto const r = 1.2 + 0.01 * i;
+    Utils::Vector3d const pos =
+        sphere->pos() + r * Utils::Vector3d{std::sin(theta) * std::cos(phi),
+                                            std::sin(theta) * std::sin(phi),
+                                            std::cos(theta)};
+    double d, d_ref;
+    Utils::Vector3d vec, vec_ref;
+    fine.calculate_dist(pos, &d, vec.data());
+    sphere->calculate_dist(pos, &d_ref, vec_ref.data());
+    BOOST_CHECK_SMALL(d - d_ref, 2. * fine.max_error());
+    BOOST_CHECK_SMALL((vec - vec_ref).norm(), 2. * fine.max_error());
+  }
+
+  /* Outside of the grid the sphere is evaluated directly. */
+  double d;
+  double vec[3];
+  fine.calculate_dist({6., 2., 2.}, &d, vec);
+  BOOST_CHECK_CLOSE(d, 3., 1e-12);
+}
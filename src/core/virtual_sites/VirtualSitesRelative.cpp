@@ -28,149 +28,207 @@
 #include "integrate.hpp"
 #include "rotation.hpp"
 
-void VirtualSitesRelative::update(bool recalc_positions) const {
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+/** The virtual sites of one real particle. */
+struct RigidBody {
+  Particle *p_real;
+  /** Range of the sites of the body in @ref sites and @ref offsets. */
+  std::size_t begin;
+  std::size_t end;
+};
+
+/** Local virtual sites, grouped by their real particle. */
+std::vector<RigidBody> bodies;
+std::vector<Particle *> sites;
+/** Positions of the sites relative to their real particle in its
+ *  body-fixed frame. */
+std::vector<Utils::Vector3d> offsets;
+/** Ghost virtual sites and their real particle, only used on a single
+ *  node, where all real particles are local. */
+std::vector<std::pair<Particle *, Particle *>> ghost_sites;
+bool bodies_valid = false;
+
+Utils::Vector3d body_frame_offset(Particle const &p) {
+  Utils::Vector3d director;
+  convert_quat_to_director(p.p.vs_relative.rel_orientation, director);
+  return p.p.vs_relative.distance / director.norm() * director;
+}
+
+void compile_rigid_bodies() {
+  bodies.clear();
+  sites.clear();
+  offsets.clear();
+  ghost_sites.clear();
 
+  std::vector<Particle *> local_sites;
   for (auto &p : local_cells.particles()) {
-    if (!p.p.is_virtual)
+    if (p.p.is_virtual)
+      local_sites.push_back(&p);
+  }
+  std::stable_sort(local_sites.begin(), local_sites.end(),
+                   [](Particle const *a, Particle const *b) {
+                     return a->p.vs_relative.to_particle_id <
+                            b->p.vs_relative.to_particle_id;
+                   });
+
+  for (auto p : local_sites) {
+    auto const p_real = local_particles[p->p.vs_relative.to_particle_id];
+    if (!p_real) {
+      runtimeErrorMsg() << "No real particle associated with virtual site "
+                        << p->p.identity << ".";
       continue;
+    }
 
-    if (recalc_positions)
-      update_pos(p);
+    if (bodies.empty() or bodies.back().p_real != p_real) {
+      bodies.push_back({p_real, sites.size(), sites.size()});
+    }
+    sites.push_back(p);
+    offsets.push_back(body_frame_offset(*p));
+    bodies.back().end++;
+  }
 
-    if (get_have_velocity())
-      update_vel(p);
+  if (n_nodes == 1) {
+    for (auto &p : ghost_cells.particles()) {
+      if (!p.p.is_virtual)
+        continue;
 
-    if (get_have_quaternion())
-      update_virtual_particle_quaternion(p);
+      auto const p_real = local_particles[p.p.vs_relative.to_particle_id];
+      if (p_real)
+        ghost_sites.emplace_back(&p, p_real);
+    }
   }
-}
 
-void VirtualSitesRelative::update_virtual_particle_quaternion(
-    Particle &p) const {
-  const Particle *p_real = local_particles[p.p.vs_relative.to_particle_id];
-  if (!p_real) {
-    throw std::runtime_error(
-        "virtual_sites_relative.cpp - update_mol_pos_particle(): No real "
-        "particle associated with virtual site.\n");
-  }
-  multiply_quaternions(p_real->r.quat, p.p.vs_relative.quat, p.r.quat);
-#ifdef DIPOLES
-  // When dipoles are enabled, update dipole moment
-#endif
+  bodies_valid = true;
 }
 
-// This is the "relative" implementation for virtual sites.
-// Virtual particles are placed relative to the position of a real particle
-
-// Obtain the real particle from which a virtual particle derives it's position
-// Note: for now, we use the mol_di property of Particle
-
-// Update the pos of the given virtual particle as defined by the real
-// particles in the same molecule
-void VirtualSitesRelative::update_pos(Particle &p) const {
-  // First obtain the real particle responsible for this virtual particle:
-  // Find the 1st real particle in the topology for the virtual particle's
-  // mol_id
-  const Particle *p_real = local_particles[p.p.vs_relative.to_particle_id];
-  // Check, if a real particle was found
-  if (!p_real) {
-    runtimeErrorMsg()
-        << "virtual_sites_relative.cpp - update_mol_pos_particle(): No real "
-           "particle associated with virtual site.\n";
-    return;
-  }
+std::vector<RigidBody> const &rigid_bodies() {
+  if (not bodies_valid)
+    compile_rigid_bodies();
+
+  return bodies;
+}
 
-  // Calculate the quaternion defining the orientation of the vector connecting
-  // the virtual site and the real particle
-  // This is obtained, by multiplying the quaternion representing the director
-  // of the real particle with the quaternion of the virtual particle, which
-  // specifies the relative orientation.
-  Utils::Vector4d q;
-  multiply_quaternions(p_real->r.quat, p.p.vs_relative.rel_orientation, q);
-  // Calculate the director resulting from the quaternions
-  Utils::Vector3d director = {0, 0, 0};
-  convert_quat_to_director(q, director);
-  // normalize
-  double l = director.norm();
-  // Division comes in the loop below
-
-  // Calculate the new position of the virtual sites from
-  // position of real particle + director
-  int i;
-  double new_pos[3];
-  double tmp;
-  for (i = 0; i < 3; i++) {
-    new_pos[i] = p_real->r.p[i] + director[i] / l * p.p.vs_relative.distance;
-    double old = p.r.p[i];
-    // Handle the case that one of the particles had gone over the periodic
-    // boundary and its coordinate has been folded
-    if (PERIODIC(i)) {
-      tmp = p.r.p[i] - new_pos[i];
-      if (tmp > box_l[i] / 2.) {
-        p.r.p[i] = new_pos[i] + box_l[i];
-      } else if (tmp < -box_l[i] / 2.) {
-        p.r.p[i] = new_pos[i] - box_l[i];
+/** Place the sites of a body at their offsets from the real particle,
+ *  rotated by its orientation. */
+void update_pos(RigidBody const &body) {
+  auto const &p_real = *body.p_real;
+
+  /* The rotation matrix is scaled by the squared norm of the quaternion */
+  double A[9];
+  define_rotation_matrix(p_real, A);
+  auto const scale = 1. / p_real.r.quat.norm2();
+
+  for (auto i = body.begin; i < body.end; i++) {
+    auto &p = *sites[i];
+    auto const &offset = offsets[i];
+
+    for (int j = 0; j < 3; j++) {
+      auto const new_pos =
+          p_real.r.p[j] + scale * (A[0 + 3 * j] * offset[0] +
+                                   A[1 + 3 * j] * offset[1] +
+                                   A[2 + 3 * j] * offset[2]);
+      auto const old = p.r.p[j];
+      // Handle the case that one of the particles had gone over the periodic
+      // boundary and its coordinate has been folded
+      if (PERIODIC(j)) {
+        auto const tmp = p.r.p[j] - new_pos;
+        if (tmp > box_l[j] / 2.) {
+          p.r.p[j] = new_pos + box_l[j];
+        } else if (tmp < -box_l[j] / 2.) {
+          p.r.p[j] = new_pos - box_l[j];
+        } else
+          p.r.p[j] = new_pos;
       } else
-        p.r.p[i] = new_pos[i];
-    } else
-      p.r.p[i] = new_pos[i];
-    // Has the vs moved by more than a skin
-    if (fabs(old - p.r.p[i]) > skin) {
-      runtimeErrorMsg() << "Virtual site " << p.p.identity
-                        << " has moved by more than the skin." << old << "->"
-                        << p.r.p[i];
+        p.r.p[j] = new_pos;
+      // Has the vs moved by more than a skin
+      if (fabs(old - p.r.p[j]) > skin) {
+        runtimeErrorMsg() << "Virtual site " << p.p.identity
+                          << " has moved by more than the skin." << old
+                          << "->" << p.r.p[j];
+      }
     }
   }
 }
 
-// Update the vel of the given virtual particle as defined by the real
-// particles in the same molecule
-void VirtualSitesRelative::update_vel(Particle &p) const {
-  // First obtain the real particle responsible for this virtual particle:
-  Particle *p_real = local_particles[p.p.vs_relative.to_particle_id];
-  // Check, if a real particle was found
-  if (!p_real) {
-    runtimeErrorMsg()
-        << "virtual_sites_relative.cpp - update_mol_pos_particle(): No real "
-           "particle associated with virtual site.\n";
-    return;
+/** Velocities of the sites from the velocity and the angular velocity
+ *  of the real particle. */
+void update_vel(RigidBody const &body) {
+  auto const &p_real = *body.p_real;
+
+  // Get omega of real particle in space-fixed frame
+  auto const omega_space_frame =
+      convert_vector_body_to_space(p_real, p_real.m.omega);
+
+  for (auto i = body.begin; i < body.end; i++) {
+    auto &p = *sites[i];
+    auto const d = get_mi_vector(p.r.p, p_real.r.p);
+    p.m.v = vector_product(omega_space_frame, d) + p_real.m.v;
   }
+}
 
-  auto const d = get_mi_vector(p.r.p, p_real->r.p);
+/** Orientations of the sites relative to the real particle. */
+void update_quat(RigidBody const &body) {
+  for (auto i = body.begin; i < body.end; i++) {
+    auto &p = *sites[i];
+    multiply_quaternions(body.p_real->r.quat, p.p.vs_relative.quat, p.r.quat);
+  }
+}
 
-  // Get omega of real particle in space-fixed frame
-  Utils::Vector3d omega_space_frame =
-      convert_vector_body_to_space(*p_real, p_real->m.omega);
-  // Obtain velocity from v=v_real particle + omega_real_particle \times
-  // director
-  p.m.v = vector_product(omega_space_frame, d) + p_real->m.v;
+/** Add the force and torque of a site to the accumulated force and torque
+ *  of its real particle. */
+void add_site_force(Particle const &p, Particle const &p_real,
+                    Utils::Vector3d &force, Utils::Vector3d &torque) {
+  // The rules for transferring forces are:
+  // F_realParticle +=F_virtualParticle
+  // T_realParticle +=f_realParticle \times
+  // (r_virtualParticle-r_realParticle)
+  torque += vector_product(get_mi_vector(p.r.p, p_real.r.p), p.f.f) +
+            p.f.torque;
+  force += p.f.f;
+}
+} // namespace
+
+void invalidate_vs_relative_bodies() { bodies_valid = false; }
+
+void VirtualSitesRelative::update(bool recalc_positions) const {
+  for (auto const &body : rigid_bodies()) {
+    if (recalc_positions)
+      update_pos(body);
+
+    if (get_have_velocity())
+      update_vel(body);
+
+    if (get_have_quaternion())
+      update_quat(body);
+  }
 }
 
 // Distribute forces that have accumulated on virtual particles to the
 // associated real particles
 void VirtualSitesRelative::back_transfer_forces_and_torques() const {
-  // Iterate over all the particles in the local cells
-  for (auto &p : local_cells.particles()) {
-    // We only care about virtual particles
-    if (p.p.is_virtual) {
-      // First obtain the real particle responsible for this virtual particle:
-      Particle *p_real = local_particles[p.p.vs_relative.to_particle_id];
-
-      // The rules for transferring forces are:
-      // F_realParticle +=F_virtualParticle
-      // T_realParticle +=f_realParticle \times
-      // (r_virtualParticle-r_realParticle)
-
-      // Add forces and torques
-      p_real->f.torque +=
-          vector_product(get_mi_vector(p.r.p, p_real->r.p), p.f.f) + p.f.torque;
-      p_real->f.f += p.f.f;
+  for (auto const &body : rigid_bodies()) {
+    Utils::Vector3d force{};
+    Utils::Vector3d torque{};
+    for (auto i = body.begin; i < body.end; i++) {
+      add_site_force(*sites[i], *body.p_real, force, torque);
     }
+
+    body.p_real->f.f += force;
+    body.p_real->f.torque += torque;
   }
-}
 
-// Setup the virtual_sites_relative properties of a particle so that the given
-// virtual particle will follow the given real particle
+  /* On a single node the forces on the ghost sites are transferred
+   * directly, instead of collecting them on the sites first. */
+  for (auto const &site : ghost_sites) {
+    add_site_force(*site.first, *site.second, site.second->f.f,
+                   site.second->f.torque);
+  }
+}
 
 // Rigid body contribution to scalar pressure and stress tensor
 void VirtualSitesRelative::pressure_and_stress_tensor_contribution(
@@ -178,29 +236,26 @@ void VirtualSitesRelative::pressure_and_stress_tensor_contribution(
   // Division by 3 volume is somewhere else. (pressure.cpp after all pressure
   // calculations) Iterate over all the particles in the local cells
 
-  for (auto &p : local_cells.particles()) {
-    if (!p.p.is_virtual)
-      continue;
+  for (auto const &body : rigid_bodies()) {
+    update_pos(body);
 
-    update_pos(p);
+    for (auto i = body.begin; i < body.end; i++) {
+      auto const &p = *sites[i];
 
-    // First obtain the real particle responsible for this virtual particle:
-    const Particle *p_real = local_particles[p.p.vs_relative.to_particle_id];
+      // Get distance vector pointing from real to virtual particle, respecting
+      // periodic boundary i
+      // conditions
+      auto const d = get_mi_vector(body.p_real->r.p, p.r.p);
 
-    // Get distance vector pointing from real to virtual particle, respecting
-    // periodic boundary i
-    // conditions
-    double d[3];
-    get_mi_vector(d, p_real->r.p, p.r.p);
+      // Stress tensor contribution
+      for (int k = 0; k < 3; k++)
+        for (int l = 0; l < 3; l++)
+          stress_tensor[k * 3 + l] += p.f.f[k] * d[l];
 
-    // Stress tensor contribution
-    for (int k = 0; k < 3; k++)
-      for (int l = 0; l < 3; l++)
-        stress_tensor[k * 3 + l] += p.f.f[k] * d[l];
-
-    // Pressure = 1/3 trace of stress tensor
-    // but the 1/3 is applied somewhere else.
-    *pressure += (p.f.f[0] * d[0] + p.f.f[1] * d[1] + p.f.f[2] * d[2]);
+      // Pressure = 1/3 trace of stress tensor
+      // but the 1/3 is applied somewhere else.
+      *pressure += p.f.f * d;
+    }
   }
 }
 
@@ -27,7 +27,15 @@
 #include "particle_data.hpp"
 #include "virtual_sites.hpp"
 
-/** @brief Virtual sites implementation for rigid bodies */
+/** @brief Virtual sites implementation for rigid bodies
+ *
+ *  The local virtual sites are grouped by their real particle, and their
+ *  positions relative to it are stored in its body-fixed frame. The sites
+ *  of a body are then placed with a single rotation matrix, and their
+ *  forces and torques are summed before they are added to the real
+ *  particle. The grouping is compiled on first use after it was
+ *  invalidated by @ref invalidate_vs_relative_bodies.
+ */
 class VirtualSitesRelative : public VirtualSites {
 public:
   VirtualSitesRelative() = default;
@@ -41,24 +49,25 @@ public:
   bool need_ghost_comm_before_vel_update() const override {
     return (n_nodes > 1) && get_have_velocity();
   };
-  /** @copydoc VirtualSites::need_ghost_comm_before_back_transfer */
-  bool need_ghost_comm_before_back_transfer() const override { return true; };
+  /** @copydoc VirtualSites::need_ghost_comm_before_back_transfer
+   *  On a single node, the forces on the ghost sites are transferred
+   *  to the real particles directly. */
+  bool need_ghost_comm_before_back_transfer() const override {
+    return n_nodes > 1;
+  };
   /** @copydoc VirtualSites::n_pressure_contribs */
   int n_pressure_contribs() const override { return 1; };
   /** @copydoc VirtualSites::pressure_and_stress_tensor_contribution */
   void
   pressure_and_stress_tensor_contribution(double *pressure,
                                           double *stress_tensor) const override;
-
-private:
-  void update_pos(Particle &p) const;
-  void update_vel(Particle &p) const;
-  /** @brief Update the orientation of the virtual particles with respect to the
-   * real particle.
-   */
-  void update_virtual_particle_quaternion(Particle &p) const;
 };
 
+/** @brief Mark the grouping of the virtual sites by their real particles
+ *  as outdated, e.g. after the particles were resorted.
+ */
+void invalidate_vs_relative_bodies();
+
 #endif
 
 #endif
@@ -59,6 +59,7 @@ IF ELECTROSTATICS and P3M:
             double relax
             int citeration
             int first_id
+            int anderson_depth
 
         # links intern C-struct with python object
         iccp3m_struct iccp3m_cfg
@@ -181,6 +181,11 @@ IF ELECTROSTATICS and P3M:
             check_range_or_except(
                 self._params, "max_iterations", 0, False, "inf", True)
 
+            check_type_or_throw_except(
+                self._params["anderson_depth"], 1, int, "")
+            check_range_or_except(
+                self._params, "anderson_depth", 0, True, "inf", True)
+
             check_type_or_throw_except(
                 self._params["first_id"], 1, int, "")
             check_range_or_except(
@@ -214,7 +219,7 @@ IF ELECTROSTATICS and P3M:
                 self._params["epsilons"] = np.zeros(self._params["n_icc"])
 
         def valid_keys(self):
-            return "n_icc", "convergence", "relaxation", "ext_field", "max_iterations", "first_id", "eps_out", "normals", "areas", "sigmas", "epsilons", "check_neutrality"
+            return "n_icc", "convergence", "relaxation", "ext_field", "max_iterations", "anderson_depth", "first_id", "eps_out", "normals", "areas", "sigmas", "epsilons", "check_neutrality"
 
         def required_keys(self):
             return ["n_icc", "normals", "areas"]
@@ -225,6 +230,7 @@ IF ELECTROSTATICS and P3M:
                     "relaxation": 0.7,
                     "ext_field": [0, 0, 0],
                     "max_iterations": 100,
+                    "anderson_depth": 0,
                     "first_id": 0,
                     "esp_out": 1,
                     "normals": [],
@@ -258,6 +264,7 @@ IF ELECTROSTATICS and P3M:
                                    iccp3m_cfg.ext_field[1], iccp3m_cfg.ext_field[2]]
             params["first_id"] = iccp3m_cfg.first_id
             params["max_iterations"] = iccp3m_cfg.num_iteration
+            params["anderson_depth"] = iccp3m_cfg.anderson_depth
             params["convergence"] = iccp3m_cfg.convergence
             params["relaxation"] = iccp3m_cfg.relax
             params["eps_out"] = iccp3m_cfg.eout
@@ -285,6 +292,7 @@ IF ELECTROSTATICS and P3M:
             iccp3m_cfg.ext_field[2] = self._params["ext_field"][2]
             iccp3m_cfg.first_id = self._params["first_id"]
             iccp3m_cfg.num_iteration = self._params["max_iterations"]
+            iccp3m_cfg.anderson_depth = self._params["anderson_depth"]
             iccp3m_cfg.convergence = self._params["convergence"]
             iccp3m_cfg.relax = self._params["relaxation"]
             iccp3m_cfg.eout = self._params["eps_out"]
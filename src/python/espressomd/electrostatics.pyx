@@ -233,6 +233,9 @@ IF P3M == 1:
             tune : :obj:`bool`, optional
                 Used to activate/deactivate the tuning method on activation.
                 Defaults to True.
+            tabulate : :obj:`bool`, optional
+                Use an interpolation table for the real space part.
+                Defaults to False.
 
             """
             super(type(self), self).__init__(*args, **kwargs)
@@ -279,7 +282,7 @@ IF P3M == 1:
                     "alpha should be positive")
 
         def valid_keys(self):
-            return "mesh", "cao", "accuracy", "epsilon", "alpha", "r_cut", "prefactor", "tune", "check_neutrality", "inter"
+            return "mesh", "cao", "accuracy", "epsilon", "alpha", "r_cut", "prefactor", "tune", "check_neutrality", "inter", "tabulate"
 
         def required_keys(self):
             return ["prefactor", "accuracy"]
@@ -294,7 +297,8 @@ IF P3M == 1:
                     "epsilon": 0.0,
                     "mesh_off": [-1, -1, -1],
                     "tune": True,
-                    "check_neutrality": True}
+                    "check_neutrality": True,
+                    "tabulate": False}
 
         def _get_params_from_es_core(self):
             params = {}
@@ -318,6 +322,8 @@ IF P3M == 1:
             #Sets ninterpol, bcast
             p3m_set_ninterpol(self._params["inter"])
             python_p3m_set_mesh_offset(self._params["mesh_off"])
+            #Sets tabulate, bcast
+            p3m_set_tabulate(self._params["tabulate"])
 
         def _tune(self):
             set_prefactor(self._params["prefactor"])
@@ -492,6 +498,9 @@ IF ELECTROSTATICS:
         bessel_cutoff : :obj:`int`, optional
         tune : :obj:`bool`, optional
             Specify whether to automatically tune ore not. The default is True.
+        tabulate : :obj:`bool`, optional
+            Replace the image sums of the near and far formula by tables
+            interpolated to ``maxPWerror``. The default is False.
         """
 
         def validate_params(self):
@@ -511,10 +520,11 @@ IF ELECTROSTATICS:
                     "far_switch_radius": -1,
                     "bessel_cutoff": -1,
                     "tune": True,
+                    "tabulate": False,
                     "check_neutrality": True}
 
         def valid_keys(self):
-            return "prefactor", "maxPWerror", "far_switch_radius", "bessel_cutoff", "tune", "check_neutrality"
+            return "prefactor", "maxPWerror", "far_switch_radius", "bessel_cutoff", "tune", "tabulate", "check_neutrality"
 
         def required_keys(self):
             return ["prefactor", "maxPWerror"]
@@ -532,7 +542,16 @@ IF ELECTROSTATICS:
         def _set_params_in_es_core(self):
             set_prefactor(self._params["prefactor"])
             MMM1D_set_params(
-                self._params["far_switch_radius"], self._params["maxPWerror"])
+                self._params["far_switch_radius"], self._params["maxPWerror"],
+                self._params["tabulate"])
+
+        def is_tabulated(self):
+            """Whether the image sums are interpolated from tables. This is
+            only the case if ``tabulate`` is set and the tables reached
+            ``maxPWerror`` when the method was last initialized.
+
+            """
+            return MMM1D_is_tabulated()
 
         def _tune(self):
             cdef int resp
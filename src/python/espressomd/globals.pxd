@@ -112,6 +112,9 @@ cdef extern from "layered.hpp":
 
 cdef extern from "rattle.hpp":
     extern int n_rigidbonds
+    extern int rattle_iterations
+    int SHAKE_MAX_ITERATIONS
+    int rattle_set_iterations(int iterations)
 
 
 cdef extern from "tuning.hpp":
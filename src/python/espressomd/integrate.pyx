@@ -34,25 +34,30 @@ cdef class Integrator(object):
     cdef str _method
     cdef object _steepest_descent_params
     cdef object _isotropic_npt_params
+    cdef int _respa_interval
 
     def __init__(self):
         self._method = "VV"
         self._steepest_descent_params = {}
         self._isotropic_npt_params = {}
+        self._respa_interval = 1
 
     def __getstate__(self):
         state = {}
         state['_method'] = self._method
         state['_steepest_descent_params'] = self._steepest_descent_params
         state['_isotropic_npt_params'] = self._isotropic_npt_params
+        state['_respa_interval'] = self._respa_interval
         return state
 
     def __setstate__(self, state):
         self._method = state['_method']
         if self._method == "STEEPEST_DESCENT":
             self.set_steepest_descent(state['_steepest_descent_params'])
+        elif self._method == "VV":
+            self.set_vv(respa_interval=state.get('_respa_interval', 1))
         elif self._method == "NVT":
-            self.set_nvt()
+            self.set_nvt(respa_interval=state.get('_respa_interval', 1))
         elif self._method == "NPT":
             npt_params = state['_isotropic_npt_params']
             self.set_isotropic_npt(npt_params['ext_pressure'], npt_params[
@@ -114,21 +119,44 @@ cdef class Integrator(object):
         self._steepest_descent_params.update(kwargs)
         self._method = "STEEPEST_DESCENT"
 
-    def set_vv(self):
+    def set_vv(self, respa_interval=1):
         """
         Set the integration method to Velocity Verlet.
 
+        Parameters
+        ----------
+        respa_interval : :obj:`int`, optional
+            Number of time steps between two evaluations of the long range
+            forces (multiple time stepping). Defaults to 1, i.e. every step.
+
         """
+        self._set_respa_interval(respa_interval)
         self._method = "VV"
 
-    def set_nvt(self):
+    def set_nvt(self, respa_interval=1):
         """
         Set the integration method to NVT.
 
+        Parameters
+        ----------
+        respa_interval : :obj:`int`, optional
+            Number of time steps between two evaluations of the long range
+            forces (multiple time stepping). Defaults to 1, i.e. every step.
+
         """
+        self._set_respa_interval(respa_interval)
         self._method = "NVT"
         integrate_set_nvt()
 
+    def _set_respa_interval(self, interval):
+        check_type_or_throw_except(
+            interval, 1, int, "respa_interval has to be an integer")
+        if interval < 1:
+            raise ValueError("respa_interval has to be a positive integer")
+        self._respa_interval = interval
+        integrate_set_respa_interval(interval)
+        handle_errors("Encountered errors setting the RESPA interval")
+
     def set_isotropic_npt(self, ext_pressure, piston, direction=[0, 0, 0],
                           cubic_box=False):
         """
@@ -146,6 +174,7 @@ cdef class Integrator(object):
             If this optional parameter is true, a cubic box is assumed.
 
         """
+        self._set_respa_interval(1)
         self._method = "NPT"
         self._isotropic_npt_params['ext_pressure'] = ext_pressure
         self._isotropic_npt_params['piston'] = piston
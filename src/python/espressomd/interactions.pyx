@@ -2254,7 +2254,22 @@ class ThermalizedBond(BondedInteraction):
                      Sets the friction coefficient of the Langevin thermostat for the distance vector of the particle pair.
         r_cut: :obj:`float`, optional
                 Specifies maximum distance beyond which the bond is considered broken.
-        """
+        seed: :obj:`int`
+                Initial counter value (or seed) of the philox RNG, which is
+                shared by all thermalized bonds. Required for the first
+                thermalized bond.
+        """
+        seed = kwargs.pop("seed", None)
+        if len(args) == 0:
+            # Seed is required if the rng is not initialized
+            if seed is None and thermalized_bond_is_seed_required():
+                raise ValueError(
+                    "A seed has to be given as keyword argument for the first thermalized bond")
+            if seed is not None:
+                utils.check_type_or_throw_except(
+                    seed, 1, int, "seed must be a positive integer")
+                thermalized_bond_set_rng_state(seed)
+
         super(ThermalizedBond, self).__init__(*args, **kwargs)
 
     def type_number(self):
@@ -3466,6 +3481,11 @@ class BondedInteractions(object):
             if hasattr(bonded_instance, 'params'):
                 params[i] = bonded_instance.params
                 params[i]['bond_type'] = bonded_instance.type_number()
+                # The RNG counter of the thermalized bonds is restored
+                # through the seed of the first one
+                if bonded_instance.type_number() == BONDED_IA_THERMALIZED_DIST \
+                        and not thermalized_bond_is_seed_required():
+                    params[i]['seed'] = int(thermalized_bond_get_rng_state())
             else:
                 params[i] = None
         return params
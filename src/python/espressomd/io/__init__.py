@@ -16,3 +16,4 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 from . import writer
 from . import mpiio
+from . import reader
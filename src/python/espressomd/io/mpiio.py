@@ -14,6 +14,7 @@
 #
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import atexit
 from ..script_interface import PScriptInterface
 
 
@@ -32,7 +33,7 @@ class Mpiio(object):
             "ScriptInterface::MPIIO::MPIIOScript")
 
     def write(self, prefix=None, positions=False, velocities=False,
-              types=False, bonds=False):
+              types=False, bonds=False, async_write=False, precision=None):
         """MPI-IO write.
 
         Outputs binary data using MPI-IO to several files starting with prefix.
@@ -62,6 +63,17 @@ class Mpiio(object):
             Indicates if types should be dumped.
         bonds : :obj:`bool`, optional
             Indicates if bonds should be dumped.
+        async_write : :obj:`bool`, optional
+            If true, return as soon as the data is copied into output
+            buffers and write the files in the background. The files
+            are only complete after a call to :meth:`flush` or
+            :meth:`read`, or when the script exits. At most two writes
+            are in flight at a time.
+        precision : :obj:`float`, optional
+            If given, positions and velocities are rounded to multiples
+            of ``precision`` and stored compressed, which typically
+            reduces their size by a factor of 4 or more. Positions are
+            folded into the box.
 
         Raises
         ------
@@ -74,9 +86,64 @@ class Mpiio(object):
                 "Need to supply output prefix via 'prefix' kwarg.")
         if not positions and not velocities and not types and not bonds:
             raise ValueError("No output fields chosen.")
+        if precision is None:
+            precision = 0.
+        elif precision <= 0.:
+            raise ValueError("precision has to be positive.")
 
         self._instance.call_method(
-            "write", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds)
+            "write", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds,
+            async_write=async_write, precision=precision)
+
+    def write_checkpoint(self, prefix=None):
+        """Write a checkpoint using MPI-IO.
+
+        Every process writes its particles, its part of a CPU LB fluid and
+        the state of its random number generator to common files starting
+        with prefix. The data is not collected on the head node. Suffixes
+        are:
+
+            - chead: Global information and the counters of the thermostats,
+            - cpart: Complete particle data, including bonds and exclusions,
+            - coff: Information about processes: 1 long long per process,
+            - clb: LB populations (if a CPU LB fluid is active).
+
+        Interactions, the thermostat parameters, the LB parameters and
+        other system properties are not stored, use
+        :mod:`espressomd.checkpointing` for these.
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames.
+        """
+        if prefix is None:
+            raise ValueError(
+                "Need to supply output prefix via 'prefix' kwarg.")
+
+        self._instance.call_method("write_checkpoint", prefix=prefix)
+
+    def read_checkpoint(self, prefix=None):
+        """Restore a checkpoint written by :meth:`write_checkpoint`.
+
+        All existing particles are replaced. A LB fluid with the same
+        grid has to be set up before, if the checkpoint contains one.
+
+        .. note::
+            The checkpoint must be read on the same number of processes and
+            with the same features that were used for writing it.
+        """
+        if prefix is None:
+            raise ValueError(
+                "Need to supply output prefix via 'prefix' kwarg.")
+
+        self._instance.call_method("read_checkpoint", prefix=prefix)
+
+    def flush(self):
+        """Wait until all files of asynchronous writes are written.
+
+        """
+        self._instance.call_method("flush")
 
     def read(self, prefix=None, positions=False, velocities=False,
              types=False, bonds=False):
@@ -100,3 +167,5 @@ class Mpiio(object):
             "read", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds)
 
 mpiio = Mpiio()
+# Complete asynchronous writes left in flight before MPI is finalized
+atexit.register(mpiio.flush)
@@ -0,0 +1,179 @@
+#
+# Copyright (C) 2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+from __future__ import print_function, absolute_import, division
+from libcpp.string cimport string
+from cpython.buffer cimport PyBUF_WRITABLE
+import numpy as np
+
+cdef extern from "utils/Span.hpp" namespace "Utils":
+    cppclass Span[T]:
+        T * data()
+        size_t size()
+
+cdef extern from "mpiio_reader.hpp" namespace "Reader":
+    cppclass MpiioFrame "Reader::MpiioFrame":
+        MpiioFrame(const string & prefix) except +
+        unsigned fields()
+        double precision()
+        int n_ranks()
+        int n_part()
+        Span[const int] ids()
+        Span[const double] positions()
+        Span[const double] velocities()
+        Span[const int] types()
+
+
+cdef class _MappedArray(object):
+
+    """Read-only buffer pointing into the files mapped by a :class:`Frame`,
+    which is kept alive as long as the buffer is referenced.
+
+    """
+
+    cdef Frame _owner
+    cdef const void * _data
+    cdef Py_ssize_t _shape[2]
+    cdef Py_ssize_t _strides[2]
+    cdef Py_ssize_t _itemsize
+    cdef int _ndim
+    cdef bytes _format
+
+    def __getbuffer__(self, Py_buffer * buffer, int flags):
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("MPI-IO frames are read-only.")
+        buffer.buf = <void * > self._data
+        buffer.obj = self
+        buffer.len = self._shape[0] * self._shape[1] * self._itemsize
+        buffer.readonly = 1
+        buffer.itemsize = self._itemsize
+        buffer.format = self._format
+        buffer.ndim = self._ndim
+        buffer.shape = self._shape
+        buffer.strides = self._strides
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer * buffer):
+        pass
+
+
+cdef _MappedArray _mapped_array(Frame owner, const void * data, size_t size,
+                                int width, Py_ssize_t itemsize, format):
+    cdef _MappedArray a = _MappedArray.__new__(_MappedArray)
+    a._owner = owner
+    a._data = data
+    a._shape[0] = size // width
+    a._shape[1] = width
+    a._strides[0] = width * itemsize
+    a._strides[1] = itemsize
+    a._itemsize = itemsize
+    a._ndim = 2 if width > 1 else 1
+    a._format = format
+    return a
+
+
+cdef class Frame(object):
+
+    """Read-only view of MPI-IO output written by
+    :meth:`espressomd.io.mpiio.Mpiio.write`.
+
+    The files are memory mapped and the particle data is returned as
+    read-only numpy arrays without copying, so large frames can be analyzed
+    without setting up a system. The arrays stay valid as long as they are
+    referenced. Frames do not use MPI and can be processed in parallel,
+    e.g. with :mod:`multiprocessing`.
+
+    Parameters
+    ----------
+    prefix : :obj:`str`
+        Common prefix of the files.
+
+    """
+
+    cdef MpiioFrame * _frame
+
+    def __cinit__(self, prefix):
+        self._frame = new MpiioFrame(prefix.encode())
+
+    def __dealloc__(self):
+        del self._frame
+
+    cdef _view(self, const void * data, size_t size, int width,
+               Py_ssize_t itemsize, format):
+        if size == 0:
+            return None
+        return np.asarray(_mapped_array(self, data, size, width, itemsize,
+                                        format))
+
+    property n_part:
+        """Number of particles."""
+
+        def __get__(self):
+            return self._frame.n_part()
+
+    property n_ranks:
+        """Number of MPI ranks that wrote the frame."""
+
+        def __get__(self):
+            return self._frame.n_ranks()
+
+    property precision:
+        """Quantization step of positions and velocities, 0 if exact."""
+
+        def __get__(self):
+            return self._frame.precision()
+
+    property ids:
+        """Particle ids, in the order of the other arrays."""
+
+        def __get__(self):
+            cdef Span[const int] s = self._frame.ids()
+            return self._view(s.data(), s.size(), 1, sizeof(int), b"i")
+
+    property positions:
+        """Folded positions, shape (n_part, 3), or None if not written."""
+
+        def __get__(self):
+            cdef Span[const double] s = self._frame.positions()
+            return self._view(s.data(), s.size(), 3, sizeof(double), b"d")
+
+    property velocities:
+        """Velocities, shape (n_part, 3), or None if not written."""
+
+        def __get__(self):
+            cdef Span[const double] s = self._frame.velocities()
+            return self._view(s.data(), s.size(), 3, sizeof(double), b"d")
+
+    property types:
+        """Particle types, or None if not written."""
+
+        def __get__(self):
+            cdef Span[const int] s = self._frame.types()
+            return self._view(s.data(), s.size(), 1, sizeof(int), b"i")
+
+
+def frames(prefixes):
+    """Iterate over the frames with the given prefixes.
+
+    Only one frame is mapped at a time unless the frames or their
+    arrays are kept.
+
+    """
+    for prefix in prefixes:
+        yield Frame(prefix)
@@ -59,13 +59,22 @@ else:
         write_ordered : :obj:`bool`, optional
                         If particle properties should be ordered according to
                         ids.
+        compression : :obj:`int`, optional
+                      Deflate level (1 to 9) of the particle datasets, 0
+                      (default) disables compression. Requires a parallel
+                      HDF5 library with support for filters in parallel
+                      writes (1.10.2 or later).
 
         """
 
-        def __init__(self, write_ordered=True, **kwargs):
+        def __init__(self, write_ordered=True, compression=0, **kwargs):
             self.valid_params = ['filename', "write_ordered"]
             if 'filename' not in kwargs:
                 raise ValueError("'filename' parameter missing.")
+            if not isinstance(compression, int) or \
+                    not 0 <= compression <= 9:
+                raise ValueError(
+                    "'compression' has to be an integer between 0 and 9.")
             self.what = {'write_pos': 1 << 0,
                          'write_vel': 1 << 1,
                          'write_force': 1 << 2,
@@ -91,7 +100,8 @@ else:
             self.h5md_instance.set_params(filename=kwargs['filename'],
                                           what=self.what_bin,
                                           scriptname=sys.argv[0],
-                                          write_ordered=write_ordered)
+                                          write_ordered=write_ordered,
+                                          compression=compression)
             self.h5md_instance.call_method("init_file")
 
         def get_params(self):
@@ -15,6 +15,7 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 from .script_interface import ScriptInterfaceHelper, script_interface_register
+import numpy as np
 
 
 class Shape(object):
@@ -277,3 +278,69 @@ class SimplePore(Shape, ScriptInterfaceHelper):
 
     """
     _so_name = "Shapes::SimplePore"
+
+
+@script_interface_register
+class SdfCache(Shape, ScriptInterfaceHelper):
+
+    """
+    Another shape, sampled once on a regular grid.
+
+    Inside of the sampled region the distance to the shape is
+    interpolated trilinearly from the grid, outside of it the shape is
+    evaluated directly. This makes shapes with an expensive distance
+    function, e.g. :class:`Stomatocyte` or :class:`SimplePore`, cheap
+    to use in constraints and LB boundaries. Changes to the sampled
+    shape after the construction are not picked up.
+
+    Parameters
+    ----------
+    shape : :class:`Shape`
+       The shape to sample.
+    origin : array_like :obj:`float`
+       Lower corner of the sampled region.
+    extent : array_like :obj:`float`
+       Size of the sampled region, usually the box length.
+    resolution : :obj:`float`
+       Largest allowed distance between the grid points.
+    tolerance : :obj:`float`, optional
+       If given, a ``ValueError`` is raised if :attr:`max_error`
+       is larger.
+
+    Attributes
+    ----------
+    max_error : :obj:`float`
+       Largest deviation of the interpolated from the exact distance,
+       estimated at the centers of the grid cells.
+
+    Every node stores the complete grid with 32 bytes per grid point,
+    at most :attr:`max_n_points` points are allowed.
+
+    """
+    _so_name = "Shapes::SdfCache"
+
+    # Same limit as Shapes::SdfCache::max_n_points in the core, checked
+    # here so that no node throws during the construction.
+    max_n_points = 2**24
+
+    def __init__(self, **kwargs):
+        tolerance = kwargs.pop("tolerance", None)
+        if "resolution" in kwargs and "extent" in kwargs:
+            resolution = kwargs["resolution"]
+            extent = np.asarray(kwargs["extent"], dtype=float)
+            if resolution <= 0:
+                raise ValueError("The resolution has to be positive.")
+            if np.any(extent <= 0):
+                raise ValueError("The extent has to be positive.")
+            n_points = np.maximum(2, np.ceil(extent / resolution) + 1)
+            if np.prod(n_points) > self.max_n_points:
+                raise ValueError(
+                    "The grid would have {:.0f} points, more than the {} "
+                    "allowed, use a coarser resolution or a smaller "
+                    "extent.".format(np.prod(n_points), self.max_n_points))
+        super(SdfCache, self).__init__(**kwargs)
+
+        if tolerance is not None and self.max_error > tolerance:
+            raise ValueError(
+                "The interpolation error {} exceeds the tolerance {}, "
+                "use a finer resolution.".format(self.max_error, tolerance))
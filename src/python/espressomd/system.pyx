@@ -52,7 +52,7 @@ if LB_BOUNDARIES or LB_BOUNDARIES_GPU:
 from .comfixed import ComFixed
 from globals cimport max_seen_particle
 from .globals import Globals
-from espressomd.utils import array_locked, is_valid_type
+from espressomd.utils import array_locked, is_valid_type, check_type_or_throw_except
 IF VIRTUAL_SITES:
     from espressomd.virtual_sites import ActiveVirtualSitesHandle, VirtualSitesOff
 
@@ -74,6 +74,9 @@ if VIRTUAL_SITES:
 if OIF_GLOBAL_FORCES:
     setable_properties.append("max_oif_objects")
 
+if BOND_CONSTRAINT:
+    setable_properties.append("rattle_iterations")
+
 cdef bool _system_created = False
 
 cdef class System(object):
@@ -393,6 +396,34 @@ cdef class System(object):
                 max_oif_objects = v
                 mpi_bcast_parameter(FIELD_MAX_OIF_OBJECTS)
 
+    IF BOND_CONSTRAINT:
+        property rattle_iterations:
+            """Number of RATTLE sweeps over the rigid bonds between particles
+            on different nodes. If 0, the sweeps are repeated until all
+            rigid bonds are within their tolerances, which needs a global
+            reduction per sweep. Rigid bonds between particles on the same
+            node are always solved to their tolerances. A fixed number of
+            sweeps does not guarantee that the bonds across nodes are within
+            their tolerances afterwards, and no error is reported if they
+            are not. At most ``SHAKE_MAX_ITERATIONS`` (1000 by default)
+            sweeps can be set.
+
+            type : :obj:`int`
+
+            """
+
+            def __get__(self):
+                return rattle_iterations
+
+            def __set__(self, v):
+                check_type_or_throw_except(
+                    v, 1, int, "rattle_iterations has to be an integer")
+                if v < 0 or v > SHAKE_MAX_ITERATIONS:
+                    raise ValueError(
+                        "rattle_iterations has to be in [0, {}]".format(
+                            SHAKE_MAX_ITERATIONS))
+                rattle_set_iterations(v)
+
     def change_volume_and_rescale_particles(self, d_new, dir="xyz"):
         """Change box size and rescale particle coordinates.
 
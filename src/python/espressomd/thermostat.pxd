@@ -45,3 +45,14 @@ cdef extern from "thermostat.hpp":
     cbool langevin_is_seed_required()
 
     stdint.uint64_t langevin_get_rng_state()
+
+    IF NPT:
+        void npt_iso_set_rng_state(stdint.uint64_t counter)
+        cbool npt_iso_is_seed_required()
+        stdint.uint64_t npt_iso_get_rng_state()
+
+IF DPD:
+    cdef extern from "dpd.hpp":
+        void dpd_set_rng_state(stdint.uint64_t counter)
+        cbool dpd_is_seed_required()
+        stdint.uint64_t dpd_get_rng_state()
@@ -104,10 +104,10 @@ cdef class Thermostat(object):
                     act_on_virtual=thmst["act_on_virtual"],
                     seed=thmst["rng_counter_fluid"])
             if thmst["type"] == "NPT_ISO":
-                self.set_npt(kT=thmst["kT"], p_diff=thmst[
-                             "p_diff"], piston=thmst["piston"])
+                self.set_npt(kT=thmst["kT"], gamma0=thmst["gamma0"],
+                             gammav=thmst["gammav"], seed=thmst["seed"])
             if thmst["type"] == "DPD":
-                self.set_dpd(kT=thmst["kT"])
+                self.set_dpd(kT=thmst["kT"], seed=thmst["seed"])
 
     def get_ts(self):
         return thermo_switch
@@ -155,8 +155,10 @@ cdef class Thermostat(object):
             npt_dict["type"] = "NPT_ISO"
             npt_dict["kT"] = temperature
             npt_dict.update(nptiso)
-            # thermo_dict["gamma0"] = nptiso_gamma0
-            # thermo_dict["gammav"] = nptiso_gammav
+            npt_dict["gamma0"] = nptiso_gamma0
+            npt_dict["gammav"] = nptiso_gammav
+            IF NPT:
+                npt_dict["seed"] = int(npt_iso_get_rng_state())
             # thermo_dict["p_ext"] = nptiso.p_ext
             # thermo_dict["p_inst"] = nptiso.p_inst
             # thermo_dict["p_inst_av"] = nptiso.p_inst_av
@@ -167,6 +169,8 @@ cdef class Thermostat(object):
             dpd_dict = {}
             dpd_dict["type"] = "DPD"
             dpd_dict["kT"] = temperature
+            IF DPD:
+                dpd_dict["seed"] = int(dpd_get_rng_state())
             thermo_list.append(dpd_dict)
         return thermo_list
 
@@ -283,11 +287,11 @@ cdef class Thermostat(object):
                         "diagonal elements of the gamma_rotation tensor must be positive numbers")
 
         #Seed is required if the rng is not initialized
-        if not seed and langevin_is_seed_required():
+        if seed is None and langevin_is_seed_required():
             raise ValueError(
                 "A seed has to be given as keyword argument on first activation of the thermostat")
 
-        if seed:
+        if seed is not None:
             utils.check_type_or_throw_except(
                 seed, 1, int, "seed must be a positive integer")
             langevin_set_rng_state(seed)
@@ -382,10 +386,10 @@ cdef class Thermostat(object):
                     "The LB thermostat requires a LB / LBGPU instance as a keyword arg.")
 
             if lb_lbfluid_get_kT() > 0.:
-                if not seed and lb_lbcoupling_is_seed_required():
+                if seed is None and lb_lbcoupling_is_seed_required():
                     raise ValueError(
                         "seed has to be given as keyword arg")
-                elif seed:
+                elif seed is not None:
                     lb_lbcoupling_set_rng_state(seed)
 
             global thermo_switch
@@ -400,7 +404,7 @@ cdef class Thermostat(object):
 
     IF NPT:
         @AssertThermostatType(THERMO_NPT_ISO)
-        def set_npt(self, kT=None, gamma0=None, gammav=None):
+        def set_npt(self, kT=None, gamma0=None, gammav=None, seed=None):
             """
             Sets the NPT thermostat with required parameters 'temperature', 'gamma0', 'gammav'.
 
@@ -413,6 +417,9 @@ cdef class Thermostat(object):
             gammav : :obj:`float`
                      Artificial friction coefficient for the volume
                      fluctuations. Mass of the artificial piston.
+            seed : :obj:`int`
+                 Initial counter value (or seed) of the philox RNG.
+                 Required on first activation of the NPT thermostat.
 
             """
 
@@ -421,6 +428,15 @@ cdef class Thermostat(object):
                     "kT, gamma0 and gammav have to be given as keyword args")
             if not isinstance(kT, float):
                 raise ValueError("temperature must be a positive number")
+
+            # Seed is required if the rng is not initialized
+            if seed is None and npt_iso_is_seed_required():
+                raise ValueError(
+                    "A seed has to be given as keyword argument on first activation of the thermostat")
+            if seed is not None:
+                utils.check_type_or_throw_except(
+                    seed, 1, int, "seed must be a positive integer")
+                npt_iso_set_rng_state(seed)
             global temperature
             temperature = float(kT)
             global thermo_switch
@@ -435,7 +451,7 @@ cdef class Thermostat(object):
             mpi_bcast_parameter(FIELD_NPTISO_GV)
 
     IF DPD:
-        def set_dpd(self, kT=None):
+        def set_dpd(self, kT=None, seed=None):
             """
             Sets the DPD thermostat with required parameters 'kT'.
             This also activates the DPD interactions.
@@ -444,6 +460,9 @@ cdef class Thermostat(object):
             ----------
             'kT' : float
                 Thermal energy of the heat bath, floating point number
+            'seed' : int
+                Initial counter value (or seed) of the philox RNG.
+                Required on first activation of the DPD thermostat.
 
             """
 
@@ -452,6 +471,15 @@ cdef class Thermostat(object):
                     "kT has to be given as keyword args")
             if not isinstance(kT, float):
                 raise ValueError("temperature must be a positive number")
+
+            # Seed is required if the rng is not initialized
+            if seed is None and dpd_is_seed_required():
+                raise ValueError(
+                    "A seed has to be given as keyword argument on first activation of the thermostat")
+            if seed is not None:
+                utils.check_type_or_throw_except(
+                    seed, 1, int, "seed must be a positive integer")
+                dpd_set_rng_state(seed)
             global temperature
             temperature = float(kT)
             global thermo_switch
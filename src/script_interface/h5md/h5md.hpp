@@ -38,7 +38,8 @@ public:
     add_parameters({{"filename", m_h5md->filename()},
                     {"scriptname", m_h5md->scriptname()},
                     {"what", m_h5md->what()},
-                    {"write_ordered", m_h5md->write_ordered()}});
+                    {"write_ordered", m_h5md->write_ordered()},
+                    {"compression", m_h5md->compression()}});
   };
 
   Variant call_method(const std::string &name,
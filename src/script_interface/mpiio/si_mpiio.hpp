@@ -39,8 +39,21 @@ public:
 
   Variant call_method(const std::string &name,
                       const VariantMap &parameters) override {
+    if (name == "flush") {
+      Mpiio::mpi_mpiio_common_flush();
+      return {};
+    }
 
     auto pref = get_value<std::string>(parameters.at("prefix"));
+    if (name == "write_checkpoint") {
+      Mpiio::mpi_mpiio_checkpoint_write(pref.c_str());
+      return {};
+    }
+    if (name == "read_checkpoint") {
+      Mpiio::mpi_mpiio_checkpoint_read(pref.c_str());
+      return {};
+    }
+
     auto pos = get_value<bool>(parameters.at("pos"));
     auto vel = get_value<bool>(parameters.at("vel"));
     auto typ = get_value<bool>(parameters.at("typ"));
@@ -52,7 +65,10 @@ public:
                  field_value(bond, Mpiio::MPIIO_OUT_BND);
 
     if (name == "write")
-      Mpiio::mpi_mpiio_common_write(pref.c_str(), v);
+      Mpiio::mpi_mpiio_common_write(
+          pref.c_str(), v,
+          get_value_or<bool>(parameters, "async_write", false),
+          get_value_or<double>(parameters, "precision", 0.));
     else if (name == "read")
       Mpiio::mpi_mpiio_common_read(pref.c_str(), v);
 
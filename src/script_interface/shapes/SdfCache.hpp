@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2019 The ESPResSo project
+
+  This file is part of ESPResSo.
+
+  ESPResSo is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCRIPT_INTERFACE_SHAPES_SDF_CACHE_HPP
+#define SCRIPT_INTERFACE_SHAPES_SDF_CACHE_HPP
+
+#include "Shape.hpp"
+#include "core/shapes/SdfCache.hpp"
+
+namespace ScriptInterface {
+namespace Shapes {
+
+class SdfCache : public Shape {
+public:
+  SdfCache() {
+    add_parameters(
+        {{"shape", AutoParameter::read_only,
+          [this]() { return (m_shape != nullptr) ? m_shape->id() : ObjectId(); }},
+         {"origin", AutoParameter::read_only,
+          [this]() { return m_sdf_cache->origin(); }},
+         {"extent", AutoParameter::read_only, [this]() { return m_extent; }},
+         {"resolution", AutoParameter::read_only,
+          [this]() { return m_resolution; }},
+         {"max_error", AutoParameter::read_only,
+          [this]() { return m_sdf_cache->max_error(); }}});
+  }
+
+  void construct(VariantMap const &params) override {
+    m_shape = get_value<std::shared_ptr<Shape>>(params, "shape");
+    m_extent = get_value<Utils::Vector3d>(params, "extent");
+    m_resolution = get_value<double>(params, "resolution");
+
+    m_sdf_cache = std::make_shared<::Shapes::SdfCache>(
+        m_shape->shape(), get_value<Utils::Vector3d>(params, "origin"),
+        m_extent, m_resolution);
+  }
+
+  std::shared_ptr<::Shapes::Shape> shape() const override {
+    return m_sdf_cache;
+  }
+
+private:
+  /* Keep a reference to the sampled shape */
+  std::shared_ptr<Shape> m_shape;
+  std::shared_ptr<::Shapes::SdfCache> m_sdf_cache;
+  Utils::Vector3d m_extent;
+  double m_resolution;
+};
+
+} /* namespace Shapes */
+} /* namespace ScriptInterface */
+
+#endif
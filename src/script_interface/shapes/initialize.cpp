@@ -24,6 +24,7 @@
 #include "NoWhere.hpp"
 #include "Rhomboid.hpp"
 #include "ScriptInterface.hpp"
+#include "SdfCache.hpp"
 #include "SimplePore.hpp"
 #include "Slitpore.hpp"
 #include "Sphere.hpp"
@@ -58,6 +59,8 @@ void initialize() {
       "Shapes::SimplePore");
   ScriptInterface::register_new<ScriptInterface::Shapes::Torus>(
       "Shapes::Torus");
+  ScriptInterface::register_new<ScriptInterface::Shapes::SdfCache>(
+      "Shapes::SdfCache");
 }
 } /* namespace Shapes */
 } /* namespace ScriptInterface */
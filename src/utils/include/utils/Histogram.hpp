@@ -84,6 +84,7 @@ public:
   std::array<T, Dims> get_bin_sizes() const;
   void update(Span<const T> data);
   void update(Span<const T> data, Span<const T> weights);
+  void merge(Span<const T> hist, Span<const size_t> tot_count);
   void normalize();
 
 private:
@@ -170,6 +171,23 @@ void Histogram<T, Dims>::update(Span<const T> data, Span<const T> weights) {
   }
 }
 
+/**
+ * \brief Add the content of another histogram with the same layout.
+ * \param hist  flat histogram data, as returned by get_histogram().
+ * \param tot_count  number of hits per bin entry, as returned by
+ *                   get_tot_count().
+ */
+template <typename T, size_t Dims>
+void Histogram<T, Dims>::merge(Span<const T> hist,
+                               Span<const size_t> tot_count) {
+  if (hist.size() != m_hist.size() or tot_count.size() != m_tot_count.size())
+    throw std::invalid_argument("Histogram layouts do not match!");
+  for (size_t ind = 0; ind < m_hist.size(); ++ind) {
+    m_hist[ind] += hist[ind];
+    m_tot_count[ind] += tot_count[ind];
+  }
+}
+
 /**
  * \brief Get the bin sizes.
  */
@@ -24,6 +24,7 @@
  */
 
 #include <cassert>
+#include <cstddef>
 #include <set>
 #include <unordered_map>
 
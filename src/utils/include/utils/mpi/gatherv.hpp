@@ -33,10 +33,9 @@ template <typename T>
 void gatherv_impl(const boost::mpi::communicator &comm, const T *in_values,
                   int in_size, T *out_values, const int *sizes,
                   const int *displs, int root, boost::mpl::true_) {
-  if (in_values == nullptr)
-    return;
-
-  MPI_Datatype type = boost::mpi::get_mpi_datatype<T>(*in_values);
+  /* The buffers may be empty on any node, so the type is not
+     derived from the values. */
+  MPI_Datatype type = boost::mpi::get_mpi_datatype<T>(T{});
 
   /* in-place ? */
   if ((in_values == out_values) && (comm.rank() == root)) {
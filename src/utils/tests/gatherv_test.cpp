@@ -78,6 +78,32 @@ BOOST_AUTO_TEST_CASE(mpi_type) {
   }
 }
 
+/*
+ * Check that the values of the other ranks are
+ * gathered if the root contributes none.
+ */
+BOOST_AUTO_TEST_CASE(empty_root) {
+  mpi::communicator world;
+  auto const rank = world.rank();
+  auto const size = world.size();
+  auto const root = 0;
+
+  if (rank == root) {
+    std::vector<int> in;
+    std::vector<int> out(size - 1, -1);
+    std::vector<int> sizes(size, 1);
+    sizes[root] = 0;
+
+    gatherv(world, in.data(), 0, out.data(), sizes.data(), root);
+
+    for (int i = 1; i < size; i++) {
+      BOOST_CHECK_EQUAL(i, out.at(i - 1));
+    }
+  } else {
+    Utils::Mpi::gatherv(world, &rank, 1, root);
+  }
+}
+
 /*
  * Check that implementation behaves
  * like MPI_Gatherv with an non-mpi datatype.
@@ -51,4 +51,12 @@ BOOST_AUTO_TEST_CASE(histogram) {
   BOOST_CHECK((hist.get_histogram())[1] == 11.0);
   BOOST_CHECK_THROW(hist.update(std::vector<double>{{1.0, 5.0, 3.0}}),
                     std::invalid_argument);
+  // Check that merging adds both the data and the hit counts.
+  auto other = Utils::Histogram<double, 2>(n_bins, n_dims_data, limits);
+  other.update(std::vector<double>{{limits[0].first, limits[1].first}});
+  hist.merge(other.get_histogram(), other.get_tot_count());
+  BOOST_CHECK((hist.get_histogram())[0] == 12.0);
+  BOOST_CHECK((hist.get_tot_count())[0] == 3);
+  BOOST_CHECK_THROW(hist.merge(std::vector<double>(1), std::vector<size_t>(1)),
+                    std::invalid_argument);
 }
@@ -114,6 +114,30 @@ class ClusterAnalysis(ut.TestCase):
         visited_sizes = sorted(visited_sizes)
         self.assertEqual(visited_sizes, [2, 4])
 
+    @ut.skipIf(not espressomd.has_features("LENNARD_JONES"),
+               "Features not available, skipping test!")
+    def test_analysis_for_all_pairs_in_cell_system(self):
+        # The interaction range covers the criterion, so the pairs are
+        # taken from the cell system
+        self.es.cell_system.skin = 0.1
+        self.es.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=0.1, cutoff=0.3, shift="auto")
+
+        for crit in (DistanceCriterion(cut_off=0.12),
+                     EnergyCriterion(cut_off=1E-8)):
+            self.cs.set_params(pair_criterion=crit)
+            self.cs.run_for_all_pairs()
+
+            clusters = sorted(self.cs.clusters[cid].particle_ids()
+                              for cid in self.cs.cluster_ids())
+            self.assertEqual(clusters, [[0, 1, 2, 3], [4, 5]])
+            for pids in clusters:
+                for pid in pids:
+                    self.assertEqual(self.cs.cid_for_particle(pid), pids[0])
+
+        self.es.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0.)
+
     def test_zz_single_cluster_analysis(self):
         self.es.part.clear()
         # Place particles on a line (crossing periodic boundaries)
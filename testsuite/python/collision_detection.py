@@ -108,6 +108,26 @@ class CollisionDetection(ut.TestCase):
         self.get_state_set_state_consistency()
         self.assertEqual(self.s.collision_detection.mode, "off")
 
+    def test_bind_centers_force(self):
+        # The bond acts in the step right after the collision
+        self.s.thermostat.turn_off()
+        self.s.part.clear()
+        self.s.part.add(pos=(0.2, 0.5, 0.5), id=0)
+        self.s.part.add(pos=(0.25, 0.5, 0.5), id=1)
+        self.s.collision_detection.set_params(
+            mode="bind_centers", distance=0.11, bond_centers=self.H)
+        self.s.integrator.run(1, recalc_forces=True)
+        self.assertTrue(self.s.part[0].bonds or self.s.part[1].bonds)
+
+        self.s.integrator.run(1)
+        d = self.s.part[1].pos - self.s.part[0].pos
+        r = np.linalg.norm(d)
+        f = -self.H.params['k'] * (r - self.H.params['r_0']) * d / r
+        np.testing.assert_allclose(self.s.part[1].f, f, rtol=1e-8)
+        np.testing.assert_allclose(self.s.part[0].f, -f, rtol=1e-8)
+        self.s.collision_detection.set_params(mode="off")
+        self.s.part.clear()
+
     def run_test_bind_at_point_of_collision_for_pos(self, *positions):
         positions = list(positions)
         shuffle(positions)
@@ -298,6 +318,10 @@ class CollisionDetection(ut.TestCase):
         # 2 virtual sites per bond?
         self.assertEqual(2 * len(bonds), len(virtual_sites))
 
+        # Particle count consistent with the created virtual sites?
+        self.assertEqual(len(self.s.part),
+                         len(virtual_sites) + len(non_virtual))
+
         # Find pairs of bonded virtual sites
         vs_pairs = []
         for p in virtual_sites:
@@ -17,6 +17,7 @@
 from __future__ import division, print_function
 
 import unittest as ut
+import itertools
 import numpy
 import math
 
@@ -897,6 +898,154 @@ class ShapeBasedConstraintTest(ut.TestCase):
         system.non_bonded_inter[0, 1].lennard_jones.set_params(
             epsilon=0.0, sigma=0.0, cutoff=0.0, shift=0)
 
+    def test_sdf_cache(self):
+        """Checks that a sampled torus agrees with the exact one and
+        can be used as a constraint."""
+        system = self.system
+        system.time_step = 0.01
+        system.cell_system.skin = 0.4
+
+        torus_shape = espressomd.shapes.Torus(
+            center=3 * [self.box_l / 2.0], normal=[0, 0, 1], direction=1,
+            radius=self.box_l / 4.0, tube_radius=self.box_l / 6.0)
+        cached_shape = espressomd.shapes.SdfCache(
+            shape=torus_shape, origin=[0, 0, 0], extent=3 * [self.box_l],
+            resolution=0.25)
+
+        # The distance of the torus has kinks on the symmetry axis and
+        # on the center circle of the tube, which dominate the error
+        self.assertLess(cached_shape.max_error, 0.1)
+        with self.assertRaises(ValueError):
+            espressomd.shapes.SdfCache(
+                shape=torus_shape, origin=[0, 0, 0],
+                extent=3 * [self.box_l], resolution=4., tolerance=0.1)
+
+        with self.assertRaises(ValueError):
+            espressomd.shapes.SdfCache(
+                shape=torus_shape, origin=[0, 0, 0],
+                extent=3 * [self.box_l], resolution=0.1)
+
+        numpy.random.seed(42)
+        n_near_surface = 0
+        for pos in numpy.random.random((200, 3)) * self.box_l:
+            dist, vec = torus_shape.call_method(
+                "calc_distance", position=pos.tolist())
+            cached_dist, cached_vec = cached_shape.call_method(
+                "calc_distance", position=pos.tolist())
+            self.assertAlmostEqual(
+                cached_dist, dist, delta=2 * cached_shape.max_error)
+            # Close to the surface the distance vector is smooth, it
+            # only jumps on the symmetry axis and the tube center.
+            if abs(dist) < 2.:
+                n_near_surface += 1
+                self.assertLess(
+                    numpy.linalg.norm(numpy.subtract(cached_vec, vec)),
+                    2 * cached_shape.max_error)
+        self.assertGreater(n_near_surface, 20)
+
+        part_offset = 1.2
+        system.part.add(id=0, pos=[self.box_l / 2.0, self.box_l / 2.0 +
+                                   part_offset, self.box_l / 2.0], type=0)
+        system.non_bonded_inter[0, 1].lennard_jones.set_params(
+            epsilon=1.0, sigma=1.0, cutoff=2.0, shift=0)
+        torus_constraint = espressomd.constraints.ShapeBasedConstraint(
+            shape=cached_shape, particle_type=1)
+        system.constraints.add(torus_constraint)
+        system.integrator.run(0)
+
+        self.assertAlmostEqual(
+            torus_constraint.min_dist(),
+            self.box_l / 4.0 - self.box_l / 6.0 - part_offset,
+            delta=2 * cached_shape.max_error)
+
+        # Reset
+        system.non_bonded_inter[0, 1].lennard_jones.set_params(
+            epsilon=0.0, sigma=0.0, cutoff=0.0, shift=0)
+
+    def test_cell_culling(self):
+        """Checks the forces of many small constraints, which are only
+        evaluated for the cells close to them."""
+        system = self.system
+        system.time_step = 0.01
+        system.cell_system.skin = 0.4
+        system.cell_system.set_domain_decomposition()
+
+        # abuse generic LJ to get an attraction of unit magnitude within
+        # the cutoff
+        cutoff = 1.5
+        system.non_bonded_inter[0, 1].generic_lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=cutoff, shift=0., offset=0.,
+            e1=-1, e2=0, b1=1., b2=0.)
+
+        numpy.random.seed(42)
+        radius = 1.
+        spheres = []
+        # the constraints act on the folded positions, keep the range of
+        # the spheres away from the box boundary also after the shift below
+        for center in 3. + numpy.random.random((20, 3)) * (self.box_l - 7.):
+            sphere = espressomd.shapes.Sphere(
+                center=center.tolist(), radius=radius, direction=1)
+            system.constraints.add(
+                shape=sphere, particle_type=1, penetrable=False)
+            spheres.append(sphere)
+
+        # particles on the surfaces and next to the spheres
+        positions = []
+        for sphere in spheres:
+            for _ in range(5):
+                direction = numpy.random.random(3) - 0.5
+                direction /= numpy.linalg.norm(direction)
+                dist = radius + 0.1 + 2. * numpy.random.random()
+                positions.append(numpy.array(sphere.center) + dist * direction)
+        positions = numpy.mod(positions, self.box_l)
+
+        def overlaps(pos):
+            return any(numpy.linalg.norm(pos - s.center) <= radius
+                       for s in spheres)
+
+        # the periodic images are out of range of all particles
+        images = self.box_l * numpy.array(
+            list(itertools.product([-1, 0, 1], repeat=3)))
+
+        def expected_force(pos):
+            force = numpy.zeros(3)
+            for sphere in spheres:
+                for image in images:
+                    vec = pos - (sphere.center + image)
+                    dist = numpy.linalg.norm(vec)
+                    if dist - radius < cutoff:
+                        force -= vec / dist
+            return force
+
+        def check_forces():
+            system.integrator.run(0)
+            for p in system.part:
+                numpy.testing.assert_allclose(
+                    numpy.copy(p.f), expected_force(numpy.copy(p.pos_folded)),
+                    atol=1e-10)
+
+        for pos in positions:
+            if not overlaps(pos):
+                system.part.add(pos=pos, type=0)
+        check_forces()
+
+        # the cell lists have to follow changes of the shapes ...
+        for sphere in spheres:
+            sphere.center = (numpy.array(sphere.center) + 0.8).tolist()
+        system.part.clear()
+        for pos in positions:
+            if not overlaps(pos):
+                system.part.add(pos=pos, type=0)
+        check_forces()
+
+        # ... and of the cell system
+        system.cell_system.skin = 0.8
+        check_forces()
+
+        system.non_bonded_inter[0, 1].generic_lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0., offset=0.,
+            e1=0, e2=0, b1=0., b2=0.)
+
 
 if __name__ == "__main__":
     ut.main()
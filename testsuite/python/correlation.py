@@ -64,5 +64,37 @@ class CorrelatorTest(ut.TestCase):
             self.assertAlmostEqual(corr[i, 3], 4 * t * t, places=3)
             self.assertAlmostEqual(corr[i, 4], 9 * t * t, places=3)
 
+    def test_products(self):
+        s = self.system
+        s.box_l = 10, 10, 10
+        s.cell_system.skin = 0.4
+        s.time_step = 0.01
+        s.thermostat.turn_off()
+        s.part.clear()
+        s.part.add(id=0, pos=(0, 0, 0), v=(1, 2, 3))
+
+        O = espressomd.observables.ParticleVelocities(ids=(0,))
+        C_tensor = espressomd.accumulators.Correlator(
+            obs1=O, tau_lin=10, tau_max=2.0, delta_N=1,
+            corr_operation="tensor_product", compress1="linear")
+        C_scalar = espressomd.accumulators.Correlator(
+            obs1=O, tau_lin=10, tau_max=2.0, delta_N=1,
+            corr_operation="scalar_product", compress1="linear")
+        s.auto_update_accumulators.add(C_tensor)
+        s.auto_update_accumulators.add(C_scalar)
+        s.integrator.run(1000)
+        s.auto_update_accumulators.remove(C_tensor)
+        s.auto_update_accumulators.remove(C_scalar)
+        C_tensor.finalize()
+        C_scalar.finalize()
+
+        v = np.array([1., 2., 3.])
+        corr = C_tensor.result()
+        self.assertEqual(corr.shape[1], 2 + 9)
+        self.assertTrue(np.all(corr[:, 1] > 0))
+        for i in range(corr.shape[0]):
+            np.testing.assert_allclose(corr[i, 2:], np.outer(v, v).flatten())
+        np.testing.assert_allclose(C_scalar.result()[:, 2], np.dot(v, v))
+
 if __name__ == "__main__":
     ut.main()
@@ -134,6 +134,19 @@ class CoulombCloudWall(ut.TestCase):
             self.S.integrator.run(0)
             self.compare("p3m", energy=True, prefactor=3)
 
+        def test_p3m_tabulated(self):
+            """
+            This checks P3M with the tabulated real space kernel.
+
+            """
+
+            self.S.actors.add(
+                espressomd.electrostatics.P3M(
+                    prefactor=3, r_cut=1.001, accuracy=1e-3,
+                                              mesh=64, cao=7, alpha=2.70746, tune=False, tabulate=True))
+            self.S.integrator.run(0)
+            self.compare("p3m", energy=True, prefactor=3)
+
     @ut.skipIf(not espressomd.gpu_available(), "no gpu")
     def test_p3m_gpu(self):
             if str(espressomd.cuda_init.CudaInitHandle().device_list[0]) == "Device 687f":
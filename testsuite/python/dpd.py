@@ -73,7 +73,7 @@ class DPDThermostat(ut.TestCase):
         s.part.add(pos=s.box_l * np.random.random((N, 3)))
         kT = 2.3
         gamma = 1.5
-        s.thermostat.set_dpd(kT=kT)
+        s.thermostat.set_dpd(kT=kT, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=0, gamma=gamma, r_cut=1.5,
             trans_weight_function=0, trans_gamma=gamma, trans_r_cut=1.5)
@@ -98,7 +98,7 @@ class DPDThermostat(ut.TestCase):
         s.part.add(pos=s.box_l * np.random.random((N // 2, 3)), type=N//2*[1])
         kT = 2.3
         gamma = 1.5
-        s.thermostat.set_dpd(kT=kT)
+        s.thermostat.set_dpd(kT=kT, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=0, gamma=gamma, r_cut=1.0,
             trans_weight_function=0, trans_gamma=gamma, trans_r_cut=1.0)
@@ -128,7 +128,7 @@ class DPDThermostat(ut.TestCase):
         s.part.add(pos=np.random.random((N, 3)))
         kT = 2.3
         gamma = 1.5
-        s.thermostat.set_dpd(kT=kT)
+        s.thermostat.set_dpd(kT=kT, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=0, gamma=gamma, r_cut=1.5,
             trans_weight_function=0, trans_gamma=gamma, trans_r_cut=1.5)
@@ -147,7 +147,7 @@ class DPDThermostat(ut.TestCase):
                 self.assertTrue(v[i] == float(i + 1))
 
         # Turn back on
-        s.thermostat.set_dpd(kT=kT)
+        s.thermostat.set_dpd(kT=kT, seed=42)
 
         # Reset velocities for faster convergence
         s.part[:].v = [0., 0., 0.]
@@ -170,7 +170,7 @@ class DPDThermostat(ut.TestCase):
         s = self.s
         kT = 0.
         gamma = 1.42
-        s.thermostat.set_dpd(kT=kT)
+        s.thermostat.set_dpd(kT=kT, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=0, gamma=gamma, r_cut=1.2,
             trans_weight_function=0, trans_gamma=gamma, trans_r_cut=1.4)
@@ -218,7 +218,7 @@ class DPDThermostat(ut.TestCase):
         s = self.s
         kT = 0.
         gamma = 1.42
-        s.thermostat.set_dpd(kT=kT)
+        s.thermostat.set_dpd(kT=kT, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=1, gamma=gamma, r_cut=1.2,
             trans_weight_function=1, trans_gamma=gamma, trans_r_cut=1.4)
@@ -313,7 +313,7 @@ class DPDThermostat(ut.TestCase):
             s.part.add(pos=pos, v=v)
 
         gamma = 1.0
-        s.thermostat.set_dpd(kT=0.0)
+        s.thermostat.set_dpd(kT=0.0, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=0, gamma=gamma, r_cut=r_cut,
             trans_weight_function=0, trans_gamma=gamma, trans_r_cut=r_cut)
@@ -339,7 +339,7 @@ class DPDThermostat(ut.TestCase):
         s.constraints.add(shape=espressomd.shapes.Wall(
             dist=0, normal=[1, 0, 0]), particle_type=0, particle_velocity=[1, 2, 3])
 
-        s.thermostat.set_dpd(kT=0.0)
+        s.thermostat.set_dpd(kT=0.0, seed=42)
         s.non_bonded_inter[0, 0].dpd.set_params(
             weight_function=0, gamma=1., r_cut=1.0,
             trans_weight_function=0, trans_gamma=1., trans_r_cut=1.0)
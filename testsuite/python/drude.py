@@ -155,7 +155,7 @@ class Drude(ut.TestCase):
         #Drude related Bonds
 
         thermalized_dist_bond = espressomd.interactions.ThermalizedBond(
-            temp_com=temperature_com, gamma_com=gamma_com, temp_distance=temperature_drude, gamma_distance=gamma_drude, r_cut=1.0)
+            temp_com=temperature_com, gamma_com=gamma_com, temp_distance=temperature_drude, gamma_distance=gamma_drude, r_cut=1.0, seed=123)
         harmonic_bond = espressomd.interactions.HarmonicBond(
             k=k_drude, r_0=0.0, r_cut=1.0)
         system.bonded_inter.add(thermalized_dist_bond)
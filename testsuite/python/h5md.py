@@ -29,6 +29,9 @@ import h5py  # h5py has to be imported *after* espressomd (MPI)
 from espressomd.interactions import Virtual
 
 npart = 26
+# the test runs with different numbers of ranks in parallel, each
+# configured copy of the script writes its own file
+filename = os.path.splitext(os.path.basename(__file__))[0] + ".h5"
 
 
 class CommonTests(ut.TestCase):
@@ -66,8 +69,8 @@ class CommonTests(ut.TestCase):
 
     @classmethod
     def setUpClass(cls):
-        if os.path.isfile('test.h5'):
-            os.remove('test.h5')
+        if os.path.isfile(filename):
+            os.remove(filename)
         cls.py_file = cls.py_pos = cls.py_vel = cls.py_f = cls.py_id = cls.py_img = None
 
     def test_metadata(self):
@@ -148,7 +151,7 @@ class H5mdTestOrdered(CommonTests):
         write_ordered = True
         from espressomd.io.writer import h5md  # pylint: disable=import-error
         h5 = h5md.H5md(
-            filename="test.h5",
+            filename=filename,
             write_pos=True,
             write_vel=True,
             write_force=True,
@@ -158,7 +161,7 @@ class H5mdTestOrdered(CommonTests):
         h5.write()
         h5.flush()
         h5.close()
-        cls.py_file = h5py.File("test.h5", 'r')
+        cls.py_file = h5py.File(filename, 'r')
         cls.py_pos = cls.py_file['particles/atoms/position/value'][0]
         cls.py_img = cls.py_file['particles/atoms/image/value'][0]
         cls.py_vel = cls.py_file['particles/atoms/velocity/value'][0]
@@ -168,7 +171,8 @@ class H5mdTestOrdered(CommonTests):
 
     @classmethod
     def tearDownClass(cls):
-        os.remove("test.h5")
+        cls.py_file.close()
+        os.remove(filename)
 
     def test_ids(self):
         """Test if ids have been written properly."""
@@ -190,7 +194,7 @@ class H5mdTestUnordered(CommonTests):
         write_ordered = False
         from espressomd.io.writer import h5md  # pylint: disable=import-error
         h5 = h5md.H5md(
-            filename="test.h5",
+            filename=filename,
             write_pos=True,
             write_vel=True,
             write_force=True,
@@ -200,7 +204,7 @@ class H5mdTestUnordered(CommonTests):
         h5.write()
         h5.flush()
         h5.close()
-        cls.py_file = h5py.File("test.h5", 'r')
+        cls.py_file = h5py.File(filename, 'r')
         cls.py_pos = cls.py_file['particles/atoms/position/value'][0]
         cls.py_img = cls.py_file['particles/atoms/image/value'][0]
         cls.py_vel = cls.py_file['particles/atoms/velocity/value'][0]
@@ -210,12 +214,66 @@ class H5mdTestUnordered(CommonTests):
 
     @classmethod
     def tearDownClass(cls):
-        os.remove("test.h5")
+        cls.py_file.close()
+        os.remove(filename)
+
+
+@ut.skipIf(not espressomd.has_features(['H5MD']),
+           "H5MD not compiled in, can not check functionality.")
+class H5mdTestCompressed(CommonTests):
+
+    """
+    Test the core implementation of writing compressed hdf5 files.
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        from espressomd.io.writer import h5md  # pylint: disable=import-error
+        h5 = h5md.H5md(
+            filename=filename,
+            write_pos=True,
+            write_vel=True,
+            write_force=True,
+            write_species=True,
+            write_mass=True,
+            write_ordered=True,
+            compression=4)
+        h5.write()
+        h5.flush()
+        h5.close()
+        cls.py_file = h5py.File(filename, 'r')
+        cls.py_pos = cls.py_file['particles/atoms/position/value'][0]
+        cls.py_img = cls.py_file['particles/atoms/image/value'][0]
+        cls.py_vel = cls.py_file['particles/atoms/velocity/value'][0]
+        cls.py_f = cls.py_file['particles/atoms/force/value'][0]
+        cls.py_id = cls.py_file['particles/atoms/id/value'][0]
+        cls.py_bonds = cls.py_file['connectivity/atoms']
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.py_file.close()
+        os.remove(filename)
+
+    def test_compression(self):
+        """Test if the particle datasets are deflated."""
+        for name in ('position', 'velocity', 'force', 'image'):
+            dataset = self.py_file['particles/atoms/{}/value'.format(name)]
+            self.assertEqual(dataset.compression, 'gzip')
+            self.assertEqual(dataset.compression_opts, 4)
+
+    def test_invalid_compression(self):
+        """Test that only deflate levels from 0 to 9 are accepted."""
+        from espressomd.io.writer import h5md  # pylint: disable=import-error
+        for compression in (-1, 10):
+            with self.assertRaises(ValueError):
+                h5md.H5md(filename="invalid_" + filename, write_pos=True,
+                          compression=compression)
 
 
 if __name__ == "__main__":
     suite = ut.TestSuite()
     suite.addTests(ut.TestLoader().loadTestsFromTestCase(H5mdTestUnordered))
     suite.addTests(ut.TestLoader().loadTestsFromTestCase(H5mdTestOrdered))
+    suite.addTests(ut.TestLoader().loadTestsFromTestCase(H5mdTestCompressed))
     result = ut.TextTestRunner(verbosity=4).run(suite)
     sys.exit(not result.wasSuccessful())
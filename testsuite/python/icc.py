@@ -22,13 +22,19 @@ import espressomd
 @ut.skipIf(not espressomd.has_features(["P3M", "EXTERNAL_FORCES"]),
            "Features not available, skipping test!")
 class test_icc(ut.TestCase):
+    system = espressomd.System(box_l=[1.0, 1.0, 1.0])
+    system.seed = system.cell_system.get_state()['n_nodes'] * [1234]
 
-    def runTest(self):
+    def tearDown(self):
+        for actor in reversed(list(self.system.actors.active_actors)):
+            self.system.actors.remove(actor)
+        self.system.part.clear()
+
+    def setup_and_run(self, **icc_params):
         from espressomd.electrostatics import P3M
         from espressomd.electrostatic_extensions import ICC
 
-        S = espressomd.System(box_l=[1.0, 1.0, 1.0])
-        S.seed = S.cell_system.get_state()['n_nodes'] * [1234]
+        S = self.system
         # Parameters
         box_l = 20.0
         nicc = 10
@@ -87,7 +93,8 @@ class test_icc(ut.TestCase):
             normals=iccNormals,
             areas=iccAreas,
             sigmas=iccSigmas,
-            epsilons=iccEpsilons)
+            epsilons=iccEpsilons,
+            **icc_params)
 
         S.actors.add(p3m)
         S.actors.add(icc)
@@ -105,6 +112,17 @@ class test_icc(ut.TestCase):
         # Result
         self.assertAlmostEqual(1, induced_dipole / testcharge_dipole, places=4)
 
+        return icc.last_iterations()
+
+    def test_relaxation(self):
+        self.setup_and_run()
+
+    def test_anderson(self):
+        n_plain = self.setup_and_run()
+        self.tearDown()
+        n_anderson = self.setup_and_run(anderson_depth=5)
+        self.assertLessEqual(n_anderson, n_plain)
+
 
 if __name__ == "__main__":
     print("Features: ", espressomd.features())
@@ -30,9 +30,13 @@ class Integrate(ut.TestCase):
     external forces and with time step changes on the way.
 
     """
+    system = espressomd.System(box_l=[10.0, 10.0, 10.0])
+
+    def tearDown(self):
+        self.system.part.clear()
 
     def test(self):
-        system = espressomd.System(box_l=[10.0, 10.0, 10.0])
+        system = self.system
         system.cell_system.skin = 0
 
         # Newton's 1st law with time step change on the way
@@ -71,6 +75,33 @@ class Integrate(ut.TestCase):
                     0.5 * ext_force / p.mass * (i * system.time_step)**2 + v * i * system.time_step), atol=1E-12)
                 system.integrator.run(1)
 
+    @ut.skipIf(not espressomd.has_features("EXTERNAL_FORCES"),
+               "Features not available, skipping test!")
+    def test_fixed_coordinates(self):
+        """Fixing and releasing coordinates switches between the generic
+        and the fast integration path."""
+        system = self.system
+        system.cell_system.skin = 0.4
+        system.time_step = 0.01
+        v = np.array((1., 2., 3.))
+        p = system.part.add(pos=(1, 1, 1), v=v)
+        system.part.add(pos=(5, 5, 5))
+
+        pos = np.copy(p.pos)
+        system.integrator.run(10)
+        np.testing.assert_allclose(np.copy(p.pos), pos + 0.1 * v, atol=1E-12)
+
+        p.fix = (1, 0, 0)
+        pos = np.copy(p.pos)
+        system.integrator.run(10)
+        np.testing.assert_allclose(
+            np.copy(p.pos), pos + 0.1 * v * (0, 1, 1), atol=1E-12)
+
+        p.fix = (0, 0, 0)
+        pos = np.copy(p.pos)
+        system.integrator.run(10)
+        np.testing.assert_allclose(np.copy(p.pos), pos + 0.1 * v, atol=1E-12)
+
 
 if __name__ == '__main__':
     ut.main()
@@ -0,0 +1,104 @@
+#
+# Copyright (C) 2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+from __future__ import print_function
+import espressomd
+import espressomd.electrostatics
+import numpy as np
+import unittest as ut
+
+
+@ut.skipIf(not espressomd.has_features(["P3M"]),
+           "Features not available, skipping test!")
+class IntegrateRespa(ut.TestCase):
+
+    """
+    Tests the multiple time stepping integrator, where the k-space part of
+    P3M is only evaluated every few time steps.
+
+    """
+
+    system = espressomd.System(box_l=[10.0, 10.0, 10.0])
+    system.time_step = 0.005
+    system.cell_system.skin = 0.4
+
+    n_part = 20
+    n_steps = 40
+
+    def setUp(self):
+        np.random.seed(42)
+        self.pos = np.random.random((self.n_part, 3)) * self.system.box_l
+        self.v = 0.1 * (np.random.random((self.n_part, 3)) - 0.5)
+        for i in range(self.n_part):
+            self.system.part.add(pos=self.pos[i], v=self.v[i],
+                                 q=1 if i % 2 else -1)
+
+        self.system.actors.add(espressomd.electrostatics.P3M(
+            prefactor=1., accuracy=1e-4, mesh=32, cao=6, r_cut=2.0))
+
+    def tearDown(self):
+        self.system.actors.clear()
+        self.system.part.clear()
+        self.system.integrator.set_vv()
+
+    def run_trajectory(self, respa_interval):
+        self.system.part[:].pos = self.pos
+        self.system.part[:].v = self.v
+        self.system.integrator.set_vv(respa_interval=respa_interval)
+        e0 = self.system.analysis.energy()["total"]
+        self.system.integrator.run(self.n_steps)
+        e1 = self.system.analysis.energy()["total"]
+        return np.copy(self.system.part[:].pos), e1 - e0
+
+    def test_respa(self):
+        pos_ref, drift_ref = self.run_trajectory(1)
+        pos, drift = self.run_trajectory(2)
+        # The outer step is small compared to the time scale of the k-space
+        # forces, so the trajectories stay close and the energy is conserved
+        np.testing.assert_allclose(pos, pos_ref, atol=1e-4)
+        self.assertLess(abs(drift), 1e-2)
+        # ... but they are not identical
+        self.assertGreater(np.max(np.abs(pos - pos_ref)), 1e-10)
+
+    def test_long_range_weights(self):
+        interval = 3
+        self.system.integrator.set_vv(respa_interval=interval)
+        # The forces after the first step are from an inner step
+        self.system.integrator.run(1)
+        f_inner = np.copy(self.system.part[:].f)
+        # A fresh force calculation is an outer step
+        self.system.integrator.run(0, recalc_forces=True)
+        f_outer = np.copy(self.system.part[:].f)
+        self.system.integrator.set_vv()
+        self.system.integrator.run(0, recalc_forces=True)
+        f_full = np.copy(self.system.part[:].f)
+
+        # The inner steps have no k-space forces, the outer steps have
+        # them multiplied by the interval
+        f_kspace = f_full - f_inner
+        self.assertGreater(np.max(np.abs(f_kspace)), 1e-3)
+        np.testing.assert_allclose(
+            f_outer - f_inner, interval * f_kspace, atol=1e-10)
+
+    def test_invalid_interval(self):
+        with self.assertRaises(ValueError):
+            self.system.integrator.set_vv(respa_interval=0)
+
+
+if __name__ == '__main__':
+    ut.main()
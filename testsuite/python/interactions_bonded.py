@@ -140,6 +140,50 @@ class InteractionsBondedTest(ut.TestCase):
                       k0=quartic_k0, k1=quartic_k1, r=quartic_r, r_cut=quartic_r_cut, scalar_r=r),
                       0.01, quartic_r_cut, True)
 
+    def test_topology_change(self):
+        """Changes the bonds between force calculations and checks that
+        the forces follow the current bond lists."""
+
+        hb = espressomd.interactions.HarmonicBond(k=2., r_0=0.)
+        fene = espressomd.interactions.FeneBond(k=3., d_r_max=4., r_0=0.)
+        self.system.bonded_inter.add(hb)
+        self.system.bonded_inter.add(fene)
+
+        dist = 1.5
+        self.system.part[1].pos = self.system.part[0].pos + self.axis * dist
+        self.system.part.add(id=2, pos=self.system.part[0].pos -
+                             self.axis * dist)
+
+        def check_forces(f_10, f_20):
+            self.system.integrator.run(recalc_forces=True, steps=0)
+            np.testing.assert_allclose(
+                np.copy(self.system.part[1].f), f_10 * self.axis, atol=1E-12)
+            np.testing.assert_allclose(
+                np.copy(self.system.part[2].f), -f_20 * self.axis, atol=1E-12)
+            np.testing.assert_allclose(
+                np.copy(self.system.part[0].f),
+                (f_20 - f_10) * self.axis, atol=1E-12)
+
+        f_hb = tests_common.harmonic_force(
+            scalar_r=dist, k=2., r_0=0., r_cut=0.)
+        f_fene = tests_common.fene_force(
+            scalar_r=dist, k=3., d_r_max=4., r_0=0.)
+
+        check_forces(0., 0.)
+        self.system.part[0].add_bond((hb, 1))
+        check_forces(f_hb, 0.)
+        self.system.part[2].add_bond((fene, 0))
+        check_forces(f_hb, f_fene)
+        self.system.part[0].add_bond((fene, 1))
+        check_forces(f_hb + f_fene, f_fene)
+        self.system.part[0].delete_bond((hb, 1))
+        check_forces(f_fene, f_fene)
+        self.system.part[1].pos = self.system.part[0].pos + self.axis * dist
+        check_forces(f_fene, f_fene)
+        self.system.part[2].delete_all_bonds()
+        self.system.part[0].delete_all_bonds()
+        check_forces(0., 0.)
+
     def run_test(
         self,
         bond_instance,
@@ -29,6 +29,8 @@ if espressomd.has_features("ELECTROSTATICS", "PARTIAL_PERIODIC"):
 class ElectrostaticInteractionsTests(ut.TestCase):
     # Handle to espresso system
     system = espressomd.System(box_l=[1.0, 1.0, 1.0])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.1
 
     def paramsMatch(self, inParams, outParams):
         """Check, if the parameters set and gotten back match.
@@ -55,6 +57,10 @@ class ElectrostaticInteractionsTests(ut.TestCase):
             self.system.part[0].q = 1
             self.system.part[1].q = -1
 
+    def tearDown(self):
+        self.system.part.clear()
+        self.system.actors.clear()
+
     def generateTestForElectrostaticInteraction(_interClass, _params):
         """Generates test cases for checking interaction parameters set and gotten back
         from Es actually match. Only keys which are present  in _params are checked
@@ -89,6 +95,29 @@ class ElectrostaticInteractionsTests(ut.TestCase):
                         maxPWerror=0.001,
                         far_switch_radius=3,
                         tune=False))
+        test_mmm1d_tabulated = generateTestForElectrostaticInteraction(
+            MMM1D, dict(prefactor=2.0,
+                        maxPWerror=0.001,
+                        far_switch_radius=3,
+                        tabulate=True,
+                        tune=False))
+
+    def test_tabulated_forces(self):
+        np.random.seed(42)
+        self.system.part.add(pos=np.random.random((20, 3)) * [4, 4, 10],
+                             q=np.repeat([1, -1], 10))
+
+        def forces(tabulate):
+            mmm1d = MMM1D(prefactor=1.0, maxPWerror=1e-6,
+                          far_switch_radius=3, tabulate=tabulate, tune=False)
+            self.system.actors.add(mmm1d)
+            self.system.integrator.run(0)
+            self.assertEqual(mmm1d.is_tabulated(), tabulate)
+            f = np.copy(self.system.part[:].f)
+            self.system.actors.remove(mmm1d)
+            return f
+
+        np.testing.assert_allclose(forces(True), forces(False), atol=1e-5)
 
 
 if __name__ == "__main__":
@@ -24,7 +24,8 @@ Testmodule for MPI-IO.
 from __future__ import print_function
 import espressomd
 import espressomd.io
-from espressomd.interactions import AngleHarmonic
+import espressomd.lb
+from espressomd.interactions import AngleHarmonic, ThermalizedBond
 import numpy
 import unittest as ut
 import random
@@ -40,10 +41,13 @@ nbonds = 100
 filename = "testdata.mpiio"
 exts = ["head", "pref", "id", "type", "pos", "vel", "boff", "bond"]
 filenames = [filename + "." + ext for ext in exts]
+quantized_filenames = [filename + "." + ext for ext in ["poff", "voff"]]
+checkpoint_filenames = [filename + "." + ext
+                        for ext in ["chead", "cpart", "coff", "clb"]]
 
 
 def clean_files():
-    for f in filenames:
+    for f in filenames + quantized_filenames + checkpoint_filenames:
         if os.path.isfile(f):
             os.remove(f)
 
@@ -101,6 +105,9 @@ class MPIIOTest(ut.TestCase):
                 self.s.part[p.id].add_bond(b)
     
     def tearDown(self):
+        self.s.part.clear()
+        self.s.actors.clear()
+        self.s.thermostat.turn_off()
         clean_files()
 
     def check_files_exist(self):
@@ -136,6 +143,165 @@ class MPIIOTest(ut.TestCase):
 
         self.check_sample_system()
 
+    def test_mpiio_async(self):
+        espressomd.io.mpiio.mpiio.write(
+            filename, types=True, positions=True, velocities=True, bonds=True,
+            async_write=True)
+        # The particle data has to be copied before write returns
+        for p in self.s.part:
+            p.pos = numpy.random.rand(3)
+        espressomd.io.mpiio.mpiio.flush()
+
+        self.check_files_exist()
+
+        self.s.part.clear()
+        espressomd.io.mpiio.mpiio.read(
+            filename, types=True, positions=True, velocities=True, bonds=True)
+
+        self.check_sample_system()
+
+    def test_mpiio_quantized(self):
+        precision = 1e-4
+        espressomd.io.mpiio.mpiio.write(
+            filename, types=True, positions=True, velocities=True, bonds=True,
+            precision=precision)
+
+        self.check_files_exist()
+        for fn in quantized_filenames:
+            self.assertTrue(os.path.isfile(fn))
+        self.assertLess(os.path.getsize(filename + ".pos"), 8 * 3 * npart / 2)
+
+        self.s.part.clear()
+        espressomd.io.mpiio.mpiio.read(
+            filename, types=True, positions=True, velocities=True, bonds=True)
+
+        for p, q in zip(self.s.part, self.test_particles):
+            self.assertEqual(p.id, q.id)
+            self.assertEqual(p.type, q.type)
+            numpy.testing.assert_allclose(
+                numpy.copy(p.pos), q.pos, rtol=0, atol=0.5 * precision)
+            numpy.testing.assert_allclose(
+                numpy.copy(p.v), q.v, rtol=0, atol=0.5 * precision)
+            self.assertEqual(len(p.bonds), len(q.bonds))
+
+    def test_mpiio_quantized_node_boundary(self):
+        # The position is rounded onto the boundary between the nodes
+        precision = 1e-4
+        pos = numpy.full(3, 0.5 - 0.25 * precision)
+        self.s.part[0].pos = pos
+        espressomd.io.mpiio.mpiio.write(
+            filename, positions=True, precision=precision)
+
+        self.s.part.clear()
+        espressomd.io.mpiio.mpiio.read(filename, positions=True)
+
+        self.assertEqual(len(self.s.part), npart)
+        numpy.testing.assert_allclose(
+            numpy.copy(self.s.part[0].pos), pos, rtol=0, atol=0.5 * precision)
+
+    def test_reader(self):
+        espressomd.io.mpiio.mpiio.write(
+            filename, types=True, positions=True, velocities=True)
+
+        frame = espressomd.io.reader.Frame(filename)
+        self.assertEqual(frame.n_part, npart)
+        self.assertEqual(frame.n_ranks, self.s.cell_system.get_state()["n_nodes"])
+        self.assertEqual(frame.precision, 0.)
+        order = numpy.argsort(frame.ids)
+        numpy.testing.assert_array_equal(frame.ids[order], range(npart))
+        for i, q in zip(order, self.test_particles):
+            self.assertEqual(frame.types[i], q.type)
+            numpy.testing.assert_array_equal(frame.positions[i], q.pos)
+            numpy.testing.assert_array_equal(frame.velocities[i], q.v)
+        self.assertFalse(frame.positions.flags.writeable)
+
+    def test_reader_quantized(self):
+        precision = 1e-4
+        espressomd.io.mpiio.mpiio.write(
+            filename, types=True, positions=True, velocities=True,
+            precision=precision)
+
+        frame = espressomd.io.reader.Frame(filename)
+        self.assertEqual(frame.n_part, npart)
+        self.assertEqual(frame.precision, precision)
+        order = numpy.argsort(frame.ids)
+        numpy.testing.assert_array_equal(frame.ids[order], range(npart))
+        for i, q in zip(order, self.test_particles):
+            self.assertEqual(frame.types[i], q.type)
+            numpy.testing.assert_allclose(
+                frame.positions[i], q.pos, rtol=0, atol=0.5 * precision)
+            numpy.testing.assert_allclose(
+                frame.velocities[i], q.v, rtol=0, atol=0.5 * precision)
+
+    def test_checkpoint(self):
+        espressomd.io.mpiio.mpiio.write_checkpoint(filename)
+
+        self.s.part.clear()
+        espressomd.io.mpiio.mpiio.read_checkpoint(filename)
+
+        self.assertEqual(len(self.s.part), npart)
+        self.check_sample_system()
+
+    def thermostat_counters(self):
+        """Returns the counters of the thermostats and thermalized bonds,
+        which are only reported for the active thermostat."""
+        counters = {}
+        for name, set_thermostat in [
+                ("LANGEVIN", lambda: self.s.thermostat.set_langevin(
+                    kT=1., gamma=1.)),
+                ("DPD", lambda: self.s.thermostat.set_dpd(kT=1.)),
+                ("NPT_ISO", lambda: self.s.thermostat.set_npt(
+                    kT=1., gamma0=1., gammav=1.))]:
+            set_thermostat()
+            counters[name] = self.s.thermostat.get_state()[0]["seed"]
+            self.s.thermostat.turn_off()
+        counters["BOND"] = self.s.bonded_inter.__getstate__()[nbonds]["seed"]
+        return counters
+
+    def set_thermostat_counters(self, seed):
+        self.s.thermostat.set_npt(kT=1., gamma0=1., gammav=1., seed=seed)
+        self.s.thermostat.turn_off()
+        self.s.thermostat.set_dpd(kT=1., seed=seed + 1)
+        self.s.thermostat.turn_off()
+        self.s.thermostat.set_langevin(kT=1., gamma=1., seed=seed + 2)
+        self.s.thermostat.turn_off()
+        self.s.bonded_inter[nbonds] = ThermalizedBond(
+            temp_com=0., gamma_com=0., temp_distance=0., gamma_distance=0.,
+            r_cut=0.2, seed=seed + 3)
+
+    @ut.skipIf(not espressomd.has_features(["LB", "DPD", "NPT"]),
+               "Features not available, skipping test!")
+    def test_checkpoint_state(self):
+        self.s.time_step = 0.01
+        self.s.cell_system.skin = 0.1
+        self.set_thermostat_counters(21)
+        lbf = espressomd.lb.LBFluid(
+            agrid=0.25, dens=1., visc=1., tau=0.01, kT=1., seed=11)
+        self.s.actors.add(lbf)
+        n = 4
+        for i, j, k in numpy.ndindex(n, n, n):
+            lbf[i, j, k].velocity = [0.01 * i, 0.02 * j, -0.01 * k]
+        populations = [numpy.copy(lbf[i, j, k].population)
+                       for i, j, k in numpy.ndindex(n, n, n)]
+        counters = self.thermostat_counters()
+        self.assertEqual(counters, {"NPT_ISO": 21, "DPD": 22,
+                                    "LANGEVIN": 23, "BOND": 24})
+        espressomd.io.mpiio.mpiio.write_checkpoint(filename)
+        self.assertTrue(os.path.isfile(filename + ".clb"))
+
+        self.s.part.clear()
+        self.set_thermostat_counters(31)
+        for i, j, k in numpy.ndindex(n, n, n):
+            lbf[i, j, k].velocity = [0., 0., 0.]
+        espressomd.io.mpiio.mpiio.read_checkpoint(filename)
+
+        self.assertEqual(len(self.s.part), npart)
+        self.check_sample_system()
+        self.assertEqual(self.thermostat_counters(), counters)
+        for (i, j, k), pop in zip(numpy.ndindex(n, n, n), populations):
+            numpy.testing.assert_array_equal(
+                numpy.copy(lbf[i, j, k].population), pop)
+
 
 if __name__ == '__main__':
     ut.main()
@@ -0,0 +1,66 @@
+#
+# Copyright (C) 2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+"""
+Checks the files of the asynchronous MPI-IO writes which
+mpiio_exit_write.py left in flight at exit.
+"""
+
+from __future__ import print_function
+import espressomd
+import espressomd.io.reader
+import numpy
+import os
+import unittest as ut
+
+npart = 1023
+prefixes = ["mpiio_exit_1.mpiio", "mpiio_exit_2.mpiio"]
+exts = ["head", "pref", "id", "type", "pos", "vel"]
+
+
+class MPIIOExitTest(ut.TestCase):
+
+    rng = numpy.random.RandomState(42)
+    pos = rng.random_sample((npart, 3))
+    vel = rng.random_sample((npart, 3))
+
+    @classmethod
+    def tearDownClass(cls):
+        for prefix in prefixes:
+            for ext in exts:
+                if os.path.isfile(prefix + "." + ext):
+                    os.remove(prefix + "." + ext)
+
+    def check_frame(self, prefix, pos, vel):
+        frame = espressomd.io.reader.Frame(prefix)
+        self.assertEqual(frame.n_part, npart)
+        order = numpy.argsort(frame.ids)
+        numpy.testing.assert_array_equal(frame.ids[order], range(npart))
+        numpy.testing.assert_array_equal(
+            frame.types[order], numpy.arange(npart) % 7)
+        numpy.testing.assert_array_equal(frame.positions[order], pos)
+        numpy.testing.assert_array_equal(frame.velocities[order], vel)
+
+    def test_frames(self):
+        self.check_frame(prefixes[0], self.pos, self.vel)
+        self.check_frame(prefixes[1], self.vel, self.pos)
+
+
+if __name__ == '__main__':
+    ut.main()
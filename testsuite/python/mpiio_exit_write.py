@@ -0,0 +1,58 @@
+#
+# Copyright (C) 2019 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+"""
+Starts two asynchronous MPI-IO writes and exits without calling
+flush(). The files are read back by mpiio_exit_read.py.
+"""
+
+from __future__ import print_function
+import espressomd
+import espressomd.io
+import numpy
+import os
+
+npart = 1023
+prefixes = ["mpiio_exit_1.mpiio", "mpiio_exit_2.mpiio"]
+exts = ["head", "pref", "id", "type", "pos", "vel"]
+
+# Prior runs might not have completed successfully
+for prefix in prefixes:
+    for ext in exts:
+        if os.path.isfile(prefix + "." + ext):
+            os.remove(prefix + "." + ext)
+
+rng = numpy.random.RandomState(42)
+pos = rng.random_sample((npart, 3))
+vel = rng.random_sample((npart, 3))
+
+s = espressomd.system.System(box_l=[1, 1, 1])
+for i in range(npart):
+    s.part.add(id=i, type=i % 7, pos=pos[i], v=vel[i])
+
+espressomd.io.mpiio.mpiio.write(
+    prefixes[0], types=True, positions=True, velocities=True,
+    async_write=True)
+# The second frame has the positions and velocities swapped
+for i in range(npart):
+    s.part[i].pos = vel[i]
+    s.part[i].v = pos[i]
+espressomd.io.mpiio.mpiio.write(
+    prefixes[1], types=True, positions=True, velocities=True,
+    async_write=True)
@@ -35,11 +35,19 @@ class NPTintegrator(ut.TestCase):
     p_ext = 2.0
 
     def setUp(self):
+        self.S.time_step = 0.01
+        self.S.cell_system.skin = 0.25
+
+    def tearDown(self):
+        self.S.part.clear()
+        self.S.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0., shift=0.)
+        self.S.thermostat.turn_off()
+        self.S.integrator.set_vv()
 
+    def setup_lj_system(self):
         box_l = 5.86326165
         self.S.box_l = [box_l] * 3
-        self.S.time_step = 0.01
-        self.S.cell_system.skin = 0.25
 
         data = np.genfromtxt(tests_common.abspath(
             "data/npt_lj_system.data"))
@@ -54,11 +62,12 @@ class NPTintegrator(ut.TestCase):
             epsilon=1, sigma=1,
             cutoff=1.12246, shift=0.25)
 
-        self.S.thermostat.set_npt(kT=1.0, gamma0=2, gammav=0.004)
+        self.S.thermostat.set_npt(kT=1.0, gamma0=2, gammav=0.004, seed=42)
         self.S.integrator.set_isotropic_npt(
             ext_pressure=self.p_ext, piston=0.0001)
 
     def test_npt(self):
+        self.setup_lj_system()
         self.S.integrator.run(800)
         avp = 0
         n = 40000
@@ -78,6 +87,39 @@ class NPTintegrator(ut.TestCase):
         self.assertAlmostEqual(2.0, avp, delta=0.02)
         self.assertAlmostEqual(0.2, compressibility, delta=0.02)
 
+    def test_ideal_gas_volume_fluctuations(self):
+        """The volume of an ideal gas of N particles in the NpT ensemble
+        has the relative variance 1/(N + 1). The piston is propagated in
+        two half steps per time step, if both half steps draw the same
+        noise the piston is too hot and the volume fluctuates too much."""
+        n_part = 50
+        kT = 1.0
+        p_ext = 1.0
+        self.S.box_l = 3 * [((n_part + 1) * kT / p_ext)**(1. / 3.)]
+        self.S.cell_system.skin = 0.0
+        self.S.part.add(
+            pos=np.random.random((n_part, 3)) * self.S.box_l,
+            v=np.random.normal(scale=np.sqrt(kT), size=(n_part, 3)))
+
+        self.S.thermostat.set_npt(kT=kT, gamma0=2, gammav=0.001, seed=42)
+        self.S.integrator.set_isotropic_npt(ext_pressure=p_ext, piston=1e-4)
+        self.S.integrator.run(2000)
+
+        # The volume decorrelates within about 20 time steps, so the
+        # samples are nearly independent.
+        n = 2000
+        Vs = np.zeros(n)
+        for t in range(n):
+            self.S.integrator.run(40)
+            Vs[t] = np.prod(self.S.box_l)
+
+        # The sample variance of n independent samples has the relative
+        # standard error sqrt(2 / n), accept four standard errors.
+        expected = 1. / (n_part + 1)
+        rel_var = np.var(Vs) / np.average(Vs)**2
+        self.assertAlmostEqual(
+            rel_var, expected, delta=4. * np.sqrt(2. / n) * expected)
+
 
 if __name__ == "__main__":
     ut.main()
@@ -154,6 +154,18 @@ class Observables(ut.TestCase):
         np.testing.assert_array_almost_equal(
             obs_data, part_data, err_msg="Data did not agree for observable 'DipoleMoment'", decimal=9)
 
+    def test_unknown_ids(self):
+        profile_params = dict(n_x_bins=2, n_y_bins=2, n_z_bins=2,
+                              min_x=0., min_y=0., min_z=0.,
+                              max_x=10., max_y=10., max_z=10.)
+        for ids in ([self.N_PART], [0, self.N_PART + 5, 1]):
+            for obs in (espressomd.observables.ParticlePositions(ids=ids),
+                        espressomd.observables.ComPosition(ids=ids),
+                        espressomd.observables.DensityProfile(
+                            ids=ids, **profile_params)):
+                with self.assertRaises(RuntimeError):
+                    obs.calculate()
+
 
 if __name__ == "__main__":
     ut.main()
@@ -115,5 +115,39 @@ class RdfTest(ut.TestCase):
 
         self.assertTrue(np.allclose(rdf[1], rdf_av[1]))
 
+    @ut.skipIf(not espressomd.has_features("LENNARD_JONES"),
+               "Features not available, skipping test!")
+    def test_cell_pairs(self):
+        s = self.s
+        s.time_step = 0.01
+        s.cell_system.skin = 0.4
+        s.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2.5, shift="auto")
+
+        pos = s.box_l * np.random.random((300, 3))
+        for i in range(len(pos)):
+            s.part.add(id=i, pos=pos[i], type=(i % 2))
+
+        r_bins = 20
+        r_min = 0.1
+        r_max = 2.0
+        r, rdf = s.analysis.rdf(rdf_type='rdf', type_list_a=[0],
+                                type_list_b=[1], r_min=r_min, r_max=r_max,
+                                r_bins=r_bins)
+
+        # Reference from all pairs
+        d = pos[0::2, np.newaxis, :] - pos[np.newaxis, 1::2, :]
+        d -= s.box_l * np.round(d / s.box_l)
+        dist = np.linalg.norm(d, axis=2).flatten()
+        hist, edges = np.histogram(dist, bins=r_bins, range=(r_min, r_max))
+        volumes = 4. / 3. * np.pi * (edges[1:]**3 - edges[:-1]**3)
+        n_pairs = 150. * 150.
+        ref = hist / volumes / n_pairs * np.prod(s.box_l)
+
+        np.testing.assert_allclose(rdf, ref, rtol=1e-8)
+
+        s.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=0., cutoff=0.)
+
 if __name__ == "__main__":
     ut.main()
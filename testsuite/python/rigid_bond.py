@@ -28,15 +28,17 @@ from espressomd.interactions import RigidBond
 @ut.skipIf(not espressomd.has_features("BOND_CONSTRAINT"),
            "Test requires BOND_CONSTRAINT feature")
 class RigidBondTest(ut.TestCase):
+    s = espressomd.System(box_l=[1.0, 1.0, 1.0])
 
-    def test(self):
+    def check_chain(self, rattle_iterations):
         target_acc = 1E-3
         tol = 1.2 * target_acc
-        s = espressomd.System(box_l=[1.0, 1.0, 1.0])
+        s = self.s
         s.seed = s.cell_system.get_state()['n_nodes'] * [1234]
         s.box_l = 10, 10, 10
         s.cell_system.skin = 0.4
         s.time_step = 0.01
+        s.rattle_iterations = rattle_iterations
         s.thermostat.set_langevin(kT=1, gamma=1, seed=42)
         r = RigidBond(r=1.2, ptol=1E-3, vtol=target_acc)
         s.bonded_inter.add(r)
@@ -54,6 +56,24 @@ class RigidBondTest(ut.TestCase):
             vel_proj = np.dot(s.part[i].v - s.part[i - 1].v, v_d) / d
             self.assertLess(vel_proj, tol)
 
+        s.part.clear()
+        s.thermostat.turn_off()
+        s.rattle_iterations = 0
+
+    def test(self):
+        self.check_chain(rattle_iterations=0)
+
+    def test_fixed_iterations(self):
+        """Bonds between particles on different nodes are corrected
+        with a fixed number of sweeps."""
+        self.check_chain(rattle_iterations=20)
+
+    def test_invalid_iterations(self):
+        with self.assertRaises(ValueError):
+            self.s.rattle_iterations = -1
+        with self.assertRaises(ValueError):
+            self.s.rattle_iterations = 1001
+
 
 if __name__ == "__main__":
     #print("Features: ", espressomd.features())
@@ -134,6 +134,29 @@ class Rotation(ut.TestCase):
 
         #
 
+    @ut.skipIf(not espressomd.has_features("EXTERNAL_FORCES", "ROTATIONAL_INERTIA"),
+               "Requires EXTERNAL_FORCES and ROTATIONAL_INERTIA")
+    def test_quaternion_normalization(self):
+        """Checks that set quaternions are normalized and that the
+        propagation keeps them normalized, also with the gyroscopic term."""
+        s = self.s
+        s.part.clear()
+        s.thermostat.turn_off()
+        p = s.part.add(pos=(0.5, 0.5, 0.5), quat=(2., 0., 0., 0.))
+        np.testing.assert_allclose(np.copy(p.quat), (1, 0, 0, 0))
+
+        p.quat = (1., 2., 3., 4.)
+        np.testing.assert_allclose(
+            np.copy(p.quat), np.array((1, 2, 3, 4)) / np.sqrt(30))
+
+        p.rotation = (1, 1, 1)
+        p.rinertia = (1, 2, 3)
+        p.omega_body = (1, 0.5, -2)
+        p.ext_torque = (0.3, -0.1, 0.2)
+        for _ in range(10):
+            s.integrator.run(100)
+            self.assertAlmostEqual(np.linalg.norm(p.quat), 1., delta=1E-12)
+
 
 if __name__ == "__main__":
     ut.main()
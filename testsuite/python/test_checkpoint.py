@@ -170,6 +170,12 @@ class CheckpointTest(ut.TestCase):
         reference = {'r_0': 0.0, 'k': 1.0}
         self.assertEqual(
             len(set(state.items()) & set(reference.items())), len(reference))
+        # the thermalized bond is restored without giving a seed again
+        state = system.bonded_inter[1].params
+        reference = {'temp_com': 0., 'gamma_com': 0., 'temp_distance': 0.2,
+                     'gamma_distance': 0.5, 'r_cut': 2.}
+        for key, val in reference.items():
+            self.assertAlmostEqual(state[key], val, delta=1E-10)
 
     @ut.skipIf(not espressomd.has_features(['VIRTUAL_SITES',
                                             'VIRTUAL_SITES_RELATIVE']),
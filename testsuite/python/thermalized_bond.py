@@ -78,7 +78,7 @@ the single component Maxwell distribution. Adapted from langevin_thermostat test
         t_com = 2.0
         g_com = 4.0
        
-        thermalized_dist_bond = espressomd.interactions.ThermalizedBond(temp_com = t_com, gamma_com = g_com, temp_distance = t_dist, gamma_distance = g_dist, r_cut = 2.0)
+        thermalized_dist_bond = espressomd.interactions.ThermalizedBond(temp_com = t_com, gamma_com = g_com, temp_distance = t_dist, gamma_distance = g_dist, r_cut = 2.0, seed = 55)
         self.system.bonded_inter.add(thermalized_dist_bond)
 
         for i in range(0, N, 2):
@@ -122,7 +122,7 @@ the single component Maxwell distribution. Adapted from langevin_thermostat test
         t_com = 0.0
         g_com = 0.0
        
-        thermalized_dist_bond = espressomd.interactions.ThermalizedBond(temp_com = t_com, gamma_com = g_com, temp_distance = t_dist, gamma_distance = g_dist, r_cut = 9)
+        thermalized_dist_bond = espressomd.interactions.ThermalizedBond(temp_com = t_com, gamma_com = g_com, temp_distance = t_dist, gamma_distance = g_dist, r_cut = 9, seed = 55)
         self.system.bonded_inter.add(thermalized_dist_bond)
 
         for i in range(0, N, 2):
@@ -314,6 +314,63 @@ class VirtualSites(ut.TestCase):
         system.cell_system.set_domain_decomposition(use_verlet_lists=False)
         self.run_test_lj()
 
+    def test_raspberries(self):
+        """Two bodies with many sites interact across the periodic
+        boundary. Checks that the forces and torques of all sites are
+        transferred to the central particles."""
+        system = self.system
+        system.virtual_sites = VirtualSitesRelative(have_velocity=True)
+        system.box_l = 10, 10, 10
+        system.part.clear()
+        system.time_step = 0.01
+        system.cell_system.skin = 0.3
+        system.min_global_cut = 1.1
+        system.thermostat.turn_off()
+
+        # sites on a sphere of radius 1 around the central particles
+        n_sites = 40
+        z = np.linspace(-1. + 1. / n_sites, 1. - 1. / n_sites, n_sites)
+        phi = np.pi * (3. - np.sqrt(5.)) * np.arange(n_sites)
+        sphere = np.transpose((np.sqrt(1. - z**2) * np.cos(phi),
+                               np.sqrt(1. - z**2) * np.sin(phi), z))
+
+        centers = []
+        for center_pos in (0.3, 5., 5.), (7.7, 5.2, 4.9):
+            center = system.part.add(
+                pos=center_pos, type=1, rotation=(1, 1, 1),
+                omega_lab=random.random(3))
+            centers.append(center)
+            for site_pos in sphere + center_pos:
+                site = system.part.add(pos=site_pos, type=0)
+                site.vs_auto_relate_to(center.id)
+
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0.1, sigma=0.5, cutoff=1., shift="auto")
+        system.integrator.run(0, recalc_forces=True)
+
+        for center in centers:
+            sites = [p for p in system.part if p.virtual and
+                     p.vs_relative[0] == center.id]
+            self.assertEqual(len(sites), n_sites)
+            for site in sites:
+                self.verify_vs(site)
+
+            f_sites = np.sum([np.copy(p.f) for p in sites], axis=0)
+            t_sites = np.sum([np.cross(system.distance_vec(center, p), p.f)
+                              for p in sites], axis=0)
+            np.testing.assert_allclose(np.copy(center.f), f_sites, atol=1E-8)
+            np.testing.assert_allclose(
+                np.copy(center.torque_lab), t_sites, atol=1E-8)
+
+        # the bodies only interact with each other
+        self.assertGreater(np.linalg.norm(centers[0].f), 0.)
+        np.testing.assert_allclose(
+            np.copy(centers[0].f), -np.copy(centers[1].f), atol=1E-8)
+
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0, sigma=0, cutoff=0, shift=0)
+        system.part.clear()
+
     @ut.skipIf(not espressomd.has_features("EXTERNAL_FORCES"), "skipped due to missing external forces.")
     def test_zz_stress_tensor(self):
         system = self.system